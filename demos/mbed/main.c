@@ -302,6 +302,15 @@ int main()
                     break; 
                 }
                 
+                // Messages from the device
+                case RADARIQ_CMD_MESSAGE:
+                {
+                    // Print queued messages through the log callback
+                    RadarIQ_flushMessages(myRadar);
+                    
+                    break;
+                }
+                
                 // Default case will handle when there is no valid packet recieved yet
                 // or if a valid packet is not handled as a case above
                 default:
@@ -0,0 +1,461 @@
+/**
+ * @example demos/reactor/main.c
+ * Scaling benchmark of the multi-sensor I/O reactor on a POSIX host.
+ * Simulates 1 to 64 sensors, each streaming 30 point-cloud frames per second over a socket pair and answering a
+ * frame rate request after every frame. Sensors with an index of 15 modulo 16 never answer, to exercise timeouts.
+ * One thread runs the reactor for all sensors and its CPU time is reported per frame.
+ *
+ * Build with: gcc -O2 -pthread -Isrc demos/reactor/main.c src/RadarIQ.c src/RadarIQReactor.c -o reactor-bench
+ * Usage: reactor-bench [seconds per run, default 2]
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//----------
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "RadarIQ.h"
+#include "RadarIQReactor.h"
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+//-------------------------------------------------------------------------------------------------
+// Definitions
+//-------------
+
+#define MAX_SENSORS             64u
+#define FRAME_RATE              30u       // Frames per second sent by each simulated sensor
+#define POINTS_PER_FRAME        60u       // Sent as subframes of 25, 25 and 10 points
+#define POINTS_PER_SUBFRAME     25u
+#define SILENT_SENSOR_MASK      15u       // Sensors with all these index bits set never answer commands
+#define COMMAND_TIMEOUT_MILLIS  100u
+#define PACKET_MAX_SIZE         600u
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------
+
+typedef struct
+{
+    uint8_t data[PACKET_MAX_SIZE];
+    uint16_t len;
+} Packet_t;
+
+typedef struct
+{
+    uint8_t numSensors;
+    int deviceFds[MAX_SENSORS];
+    volatile bool isRunning;
+    uint32_t framesDropped;              // Frames the simulated sensors could not write because a socket was full
+} Simulation_t;
+
+typedef struct
+{
+    RadarIQReactorHandle_t reactor;
+    uint32_t frames;
+    uint32_t points;
+    uint32_t responses;
+    uint32_t timeouts;
+    uint32_t closed;
+} Counters_t;
+
+//-------------------------------------------------------------------------------------------------
+// Objects
+//---------
+
+static Packet_t framePackets[3];
+static Packet_t responsePacket;
+
+//-------------------------------------------------------------------------------------------------
+// Function Prototypes
+//---------------------
+
+static void runBenchmark(const uint8_t numSensors, const uint32_t seconds);
+static void * simulateSensors(void * arg);
+static void handleEvent(void * const context, const uint8_t sensor, const RadarIQHandle_t radar,
+        const RadarIQReactorEvent_t event, const RadarIQCommand_t command);
+
+// Packet encoding of the simulated sensors
+static void buildPackets(void);
+static void encodePacket(Packet_t * const packet, const uint8_t * const payload, const uint16_t len);
+static void encodeByte(Packet_t * const packet, const uint8_t byte);
+static bool writePacket(const int fd, const Packet_t * const packet);
+static double getSeconds(const clockid_t clock);
+
+// Callbacks used by the RadarIQ objects, the reactor reads and writes the sockets instead
+static void callbackSendRadarData(uint8_t * const buffer, const uint16_t len);
+static RadarIQUartData_t callbackReadSerialData(void);
+static void callbackRadarLog(char * const buffer);
+static uint32_t callbackMillis(void);
+
+//-------------------------------------------------------------------------------------------------
+// Program Entry Point
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Runs the benchmark with a doubling number of sensors and prints a row of results for each
+ */
+int main(int argc, char ** argv)
+{
+    const uint32_t seconds = (1 < argc) ? (uint32_t)atoi(argv[1]) : 2u;
+
+    buildPackets();
+
+    printf("sensors  frames/s  points/s  responses  timeouts  dropped  cpu %%  cpu us/frame\n");
+
+    for (uint8_t numSensors = 1u; numSensors <= MAX_SENSORS; numSensors *= 2u)
+    {
+        runBenchmark(numSensors, (0u < seconds) ? seconds : 1u);
+    }
+
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Benchmark Functions
+//---------------------
+
+/**
+ * Runs the reactor for all sensors on this thread while another thread simulates the sensors
+ */
+static void runBenchmark(const uint8_t numSensors, const uint32_t seconds)
+{
+    RadarIQReactorConfig_t config = { numSensors, 10u };
+    Counters_t counters;
+    Simulation_t simulation;
+    RadarIQHandle_t radars[MAX_SENSORS];
+    int hostFds[MAX_SENSORS];
+
+    memset((void*)&counters, 0, sizeof(counters));
+    memset((void*)&simulation, 0, sizeof(simulation));
+
+    counters.reactor = RadarIQReactor_init(&config);
+    simulation.numSensors = numSensors;
+    simulation.isRunning = true;
+
+    for (uint8_t i = 0u; i < numSensors; i++)
+    {
+        int fds[2];
+        if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, fds))
+        {
+            perror("socketpair");
+            exit(1);
+        }
+        hostFds[i] = fds[0];
+        simulation.deviceFds[i] = fds[1];
+
+        radars[i] = RadarIQ_init(callbackSendRadarData, callbackReadSerialData, callbackRadarLog, callbackMillis);
+        (void)RadarIQReactor_addSensor(counters.reactor, radars[i], hostFds[i], handleEvent, (void*)&counters);
+    }
+
+    pthread_t thread;
+    if (0 != pthread_create(&thread, NULL, simulateSensors, (void*)&simulation))
+    {
+        perror("pthread_create");
+        exit(1);
+    }
+
+    const double wallStart = getSeconds(CLOCK_MONOTONIC);
+    const double cpuStart = getSeconds(CLOCK_THREAD_CPUTIME_ID);
+
+    while ((getSeconds(CLOCK_MONOTONIC) - wallStart) < (double)seconds)
+    {
+        if (0 > RadarIQReactor_run(counters.reactor, 100))
+        {
+            perror("poll");
+            exit(1);
+        }
+    }
+
+    const double cpu = getSeconds(CLOCK_THREAD_CPUTIME_ID) - cpuStart;
+    const double wall = getSeconds(CLOCK_MONOTONIC) - wallStart;
+
+    simulation.isRunning = false;
+    pthread_join(thread, NULL);
+
+    printf("%7u  %8.0f  %8.0f  %9u  %8u  %7u  %5.1f  %12.2f\n", (unsigned int)numSensors,
+            (double)counters.frames / wall, (double)counters.points / wall, (unsigned int)counters.responses,
+            (unsigned int)counters.timeouts, (unsigned int)simulation.framesDropped, 100.0 * cpu / wall,
+            (0u < counters.frames) ? (1e6 * cpu / (double)counters.frames) : 0.0);
+
+    RadarIQReactor_destroy(counters.reactor);
+
+    for (uint8_t i = 0u; i < numSensors; i++)
+    {
+        close(hostFds[i]);
+        close(simulation.deviceFds[i]);
+        RadarIQ_destroy(radars[i]);
+    }
+}
+
+/**
+ * Simulated sensors: writes a frame to every socket each frame period and answers the commands received
+ */
+static void * simulateSensors(void * arg)
+{
+    Simulation_t * const simulation = (Simulation_t *)arg;
+    const double period = 1.0 / (double)FRAME_RATE;
+    double nextFrame = getSeconds(CLOCK_MONOTONIC);
+    uint8_t buffer[256];
+
+    while (simulation->isRunning)
+    {
+        const double now = getSeconds(CLOCK_MONOTONIC);
+
+        if (now >= nextFrame)
+        {
+            for (uint8_t i = 0u; i < simulation->numSensors; i++)
+            {
+                if (!writePacket(simulation->deviceFds[i], &framePackets[0]))
+                {
+                    simulation->framesDropped++;
+                    continue;
+                }
+                (void)writePacket(simulation->deviceFds[i], &framePackets[1]);
+                (void)writePacket(simulation->deviceFds[i], &framePackets[2]);
+            }
+            nextFrame += period;
+        }
+
+        // Every command is answered with the same response, one per footer byte received
+        for (uint8_t i = 0u; i < simulation->numSensors; i++)
+        {
+            const ssize_t len = recv(simulation->deviceFds[i], buffer, sizeof(buffer), MSG_DONTWAIT);
+
+            for (ssize_t j = 0; j < len; j++)
+            {
+                if ((0xB1 == buffer[j]) && (SILENT_SENSOR_MASK != (i & SILENT_SENSOR_MASK)))
+                {
+                    (void)writePacket(simulation->deviceFds[i], &responsePacket);
+                }
+            }
+        }
+
+        struct timespec sleep = { 0, 500000 };
+        nanosleep(&sleep, NULL);
+    }
+
+    return NULL;
+}
+
+/**
+ * Reactor handler: counts the events and requests the frame rate after every frame
+ */
+static void handleEvent(void * const context, const uint8_t sensor, const RadarIQHandle_t radar,
+        const RadarIQReactorEvent_t event, const RadarIQCommand_t command)
+{
+    Counters_t * const counters = (Counters_t *)context;
+
+    switch (event)
+    {
+    case RADARIQ_REACTOR_EVENT_PACKET:
+    {
+        if (RADARIQ_CMD_PNT_CLOUD_FRAME == command)
+        {
+            const RadarIQDataPoint_t * points;
+            counters->frames++;
+            counters->points += RadarIQ_getPoints(radar, &points);
+
+            // Fails harmlessly while the previous request is awaiting its response
+            (void)RadarIQReactor_sendCommand(counters->reactor, sensor, RADARIQ_CMD_FRAME_RATE,
+                    RADARIQ_CMD_VAR_REQUEST, NULL, 0u, COMMAND_TIMEOUT_MILLIS);
+        }
+        break;
+    }
+    case RADARIQ_REACTOR_EVENT_RESPONSE:
+    {
+        counters->responses++;
+        break;
+    }
+    case RADARIQ_REACTOR_EVENT_TIMEOUT:
+    {
+        counters->timeouts++;
+        break;
+    }
+    default:
+    {
+        counters->closed++;
+        break;
+    }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// Packet Encoding Functions
+//---------------------------
+
+/**
+ * Encodes the frame subframes and the frame rate response sent by the simulated sensors
+ */
+static void buildPackets(void)
+{
+    uint8_t payload[4u + (POINTS_PER_SUBFRAME * 9u)];
+    uint16_t remaining = POINTS_PER_FRAME;
+
+    for (uint8_t subframe = 0u; subframe < 3u; subframe++)
+    {
+        const uint8_t count = (POINTS_PER_SUBFRAME < remaining) ? POINTS_PER_SUBFRAME : (uint8_t)remaining;
+        uint16_t len = 0u;
+
+        payload[len++] = RADARIQ_CMD_PNT_CLOUD_FRAME;
+        payload[len++] = RADARIQ_CMD_VAR_RESPONSE;
+        payload[len++] = subframe;        // Start, middle, end
+        payload[len++] = count;
+
+        for (uint8_t point = 0u; point < count; point++)
+        {
+            const int16_t values[3] = { (int16_t)(point * 40 - 500), (int16_t)(1000 + point * 20), 100 };
+            for (uint8_t axis = 0u; axis < 3u; axis++)
+            {
+                payload[len++] = (uint8_t)((uint16_t)values[axis] & 0xFFu);
+                payload[len++] = (uint8_t)((uint16_t)values[axis] >> 8u);
+            }
+            payload[len++] = 80u;         // Intensity
+            payload[len++] = 0x2Cu;       // Velocity 300 mm/s
+            payload[len++] = 0x01u;
+        }
+
+        encodePacket(&framePackets[subframe], payload, len);
+        remaining -= count;
+    }
+
+    const uint8_t response[3] = { RADARIQ_CMD_FRAME_RATE, RADARIQ_CMD_VAR_RESPONSE, FRAME_RATE };
+    encodePacket(&responsePacket, response, sizeof(response));
+}
+
+/**
+ * Encodes a packet the way the device does: header, escaped payload and CRC-16/CCITT, footer
+ */
+static void encodePacket(Packet_t * const packet, const uint8_t * const payload, const uint16_t len)
+{
+    uint16_t crc = 0xFFFFu;
+
+    for (uint16_t i = 0u; i < len; i++)
+    {
+        crc ^= (uint16_t)((uint16_t)payload[i] << 8u);
+        for (uint8_t bit = 0u; bit < 8u; bit++)
+        {
+            crc = (0u != (crc & 0x8000u)) ? (uint16_t)((crc << 1u) ^ 0x1021u) : (uint16_t)(crc << 1u);
+        }
+    }
+
+    packet->data[0] = 0xB0u;
+    packet->len = 1u;
+
+    for (uint16_t i = 0u; i < len; i++)
+    {
+        encodeByte(packet, payload[i]);
+    }
+    encodeByte(packet, (uint8_t)(crc >> 8u));
+    encodeByte(packet, (uint8_t)(crc & 0xFFu));
+
+    packet->data[packet->len] = 0xB1u;
+    packet->len++;
+}
+
+/**
+ * Appends a byte to a packet, escaping control bytes
+ */
+static void encodeByte(Packet_t * const packet, const uint8_t byte)
+{
+    if ((0xB0u <= byte) && (0xB2u >= byte))
+    {
+        packet->data[packet->len++] = 0xB2u;
+        packet->data[packet->len++] = byte ^ 0x04u;
+    }
+    else
+    {
+        packet->data[packet->len++] = byte;
+    }
+}
+
+/**
+ * Writes a packet to a socket without blocking unless it was partly written
+ *
+ * @return False if the socket was full and nothing was written
+ */
+static bool writePacket(const int fd, const Packet_t * const packet)
+{
+    uint16_t sent = 0u;
+
+    while (sent < packet->len)
+    {
+        const ssize_t written = send(fd, &packet->data[sent], packet->len - sent, MSG_DONTWAIT);
+
+        if (0 < written)
+        {
+            sent += (uint16_t)written;
+        }
+        else if ((0u == sent) || ((EAGAIN != errno) && (EWOULDBLOCK != errno)))
+        {
+            return (0u != sent);
+        }
+        else
+        {
+            struct pollfd pollFd = { fd, POLLOUT, 0 };
+            (void)poll(&pollFd, 1u, 10);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Reads a clock in seconds
+ */
+static double getSeconds(const clockid_t clock)
+{
+    struct timespec now;
+    clock_gettime(clock, &now);
+
+    return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Radar Callback Functions
+//--------------------------
+
+/**
+ * Unused, the reactor sends each sensor's commands to its socket
+ */
+static void callbackSendRadarData(uint8_t * const buffer, const uint16_t len)
+{
+    (void)buffer;
+    (void)len;
+}
+
+/**
+ * Unused, the reactor reads each sensor's socket and feeds the bytes to its RadarIQ object
+ */
+static RadarIQUartData_t callbackReadSerialData(void)
+{
+    RadarIQUartData_t ret = { 0u, false };
+
+    return ret;
+}
+
+/**
+ * This callback prints debug log messages created from the RadarIQ objects
+ */
+static void callbackRadarLog(char * const buffer)
+{
+    printf("* Log: %s\n", buffer);
+}
+
+/**
+ * This callback function lets the RadarIQ objects read the current uptime in milliseconds
+ */
+static uint32_t callbackMillis(void)
+{
+    return (uint32_t)(getSeconds(CLOCK_MONOTONIC) * 1000.0);
+}
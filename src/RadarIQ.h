@@ -34,12 +34,20 @@ extern "C" {
 /* UART buffer sizes */
 #define RADARIQ_TX_BUFFER_SIZE             32u       ///< Tx buffer size in bytes
 #define RADARIQ_RX_BUFFER_SIZE             256u      ///< Rx buffer size in bytes
+#define RADARIQ_MAX_COMMAND_PAYLOAD        10u       ///< Maximum parameter bytes of a command, fits the Tx buffer fully escaped
+#define RADARIQ_SETTING_MAX_FIELDS         2u        ///< Most fields in one device setting
 
 /* Data storage sizes */
 #define RADARIQ_MAX_POINTCLOUD             64u       ///< Maximum number of point-cloud points to store in one frame
 #define RADARIQ_MAX_OBJECTS                16u       ///< Maximum number of detected objects to store in one frame
 #define RADARIQ_VERSION_NAME_LEN           20u       ///< Maximum length of string for firmware version names
 
+/* Host frame storage */
+#ifndef RADARIQ_HOST_STORAGE_ENABLE
+#define RADARIQ_HOST_STORAGE_ENABLE        0         ///< Grows point-cloud storage on the heap instead of truncating at RADARIQ_MAX_POINTCLOUD if set to 1
+#endif
+#define RADARIQ_HOST_MAX_POINTCLOUD        8192u     ///< Maximum number of point-cloud points stored in one frame with host storage
+
 /* Limits */
 #define RADARIQ_MAX_MESSAGE_STRING         200u      ///< Maximum string length of the message in message packets
 #define RADARIQ_MIN_FRAME_RATE             1u        ///< Minimum capture frame rate in frames/second
@@ -48,12 +56,52 @@ extern "C" {
 #define RADARIQ_MAX_DIST_FILT              10000u    ///< Maximum bound length of distance in millimeters
 #define RADARIQ_MIN_ANGLE_FILT             -55       ///< Minimum bound angle of angle filter in degrees
 #define RADARIQ_MAX_ANGLE_FILT             55        ///< Maximum bound angle of angle filter in degrees
+#define RADARIQ_MAX_AZIMUTH_FILT           90        ///< Magnitude bound of the host point filter sector angles in degrees
 #define RADARIQ_MAX_SENSITIVITY            9u        ///< Maximum sensitivity level in point-cloud mode
 #define RADARIQ_MAX_OBJ_SIZE               4u        ///< Maximum target object size in object-tracking mode
 
 /* Debug */
 #define RADARIQ_DEBUG_ENABLE               0         ///< Enables any debug messages printed from RadarIQ.c if set to 1  
 
+/* Instrumentation */
+#ifndef RADARIQ_LATENCY_HISTOGRAM_ENABLE
+#define RADARIQ_LATENCY_HISTOGRAM_ENABLE   0         ///< Enables per-command round-trip latency histograms (~7.5kB) if set to 1
+#endif
+#define RADARIQ_LATENCY_SUB_BUCKET_BITS    2u        ///< Latency histogram sub-buckets per power of 2, as a power of 2
+#define RADARIQ_LATENCY_MAX_BITS           20u       ///< Latencies of 2^20 microseconds or more are counted in the last bucket
+#define RADARIQ_LATENCY_BUCKETS            (((RADARIQ_LATENCY_MAX_BITS - RADARIQ_LATENCY_SUB_BUCKET_BITS) + 1u) \
+                                                << RADARIQ_LATENCY_SUB_BUCKET_BITS)   ///< Number of latency histogram buckets
+#define RADARIQ_LATENCY_COMMANDS           0x18u     ///< Number of request/response command IDs with a latency histogram
+
+/* Tracing */
+#ifndef RADARIQ_TRACE_ENABLE
+#define RADARIQ_TRACE_ENABLE               0         ///< Records packet pipeline trace events into a per-handle ring if set to 1
+#endif
+#ifndef RADARIQ_TRACE_BYTES_ENABLE
+#define RADARIQ_TRACE_BYTES_ENABLE         0         ///< Also records an event for every byte received if set to 1, fills the ring within a packet
+#endif
+#ifndef RADARIQ_TRACE_BUFFER_SIZE
+#define RADARIQ_TRACE_BUFFER_SIZE          512u      ///< Number of trace events held before the oldest is overwritten, a power of 2 up to 32768
+#endif
+
+/* Latest-value mailboxes */
+#ifndef RADARIQ_FRAME_MAILBOX_ENABLE
+#define RADARIQ_FRAME_MAILBOX_ENABLE       0         ///< Keeps a copy of the latest frame that any thread can read if set to 1
+#endif
+
+/* Raw data streaming */
+#ifndef RADARIQ_RAW_DATA_ENABLE
+#define RADARIQ_RAW_DATA_ENABLE            0         ///< Streams raw data packets to a chunk callback instead of the Rx buffer if set to 1
+#endif
+#define RADARIQ_RAW_CHUNK_SIZE             4096u     ///< Raw data bytes reassembled before each chunk callback
+#define RADARIQ_RAW_MAX_PACKET             1048576u  ///< Raw data packets longer than this in decoded bytes are abandoned as having lost their footer
+
+/* Device messages */
+#define RADARIQ_MSG_QUEUE_SIZE             4u        ///< Number of device messages queued before new ones are dropped, a power of 2
+#define RADARIQ_MSG_RATE_SLOTS             8u        ///< Number of rate limiters, message codes share the limiter at code % slots
+#define RADARIQ_MSG_RATE_BURST             2u        ///< Number of messages of one code accepted back-to-back
+#define RADARIQ_MSG_RATE_INTERVAL          250u      ///< Milliseconds for a rate-limited code to earn back one message
+
 /**
  * Assertion macro - redefine if necessary or remove at your own risk
  */
@@ -173,7 +221,7 @@ typedef struct
  */
 typedef struct
 {
-    bool isFrameComplete;            ///< Indicates whether a frame is complete or has points truncated to fit max storage    
+    bool isFrameComplete;            ///< Indicates whether a frame ended with every subframe and point received and stored
     uint16_t numPoints;              ///< Indicates number of points in the frame
     RadarIQDataPoint_t points[RADARIQ_MAX_POINTCLOUD];    ///< Array to store the points data
 } RadarIQDataPointCloud_t;
@@ -200,7 +248,7 @@ typedef struct
  */
 typedef struct
 {
-    bool isFrameComplete;            ///< Indicates whether a frame is complete or has objects truncated to fit max storage    
+    bool isFrameComplete;            ///< Indicates whether a frame ended with every subframe and object received and stored
     uint8_t numObjects;              ///< Indicates number of detected objects in the frame
     RadarIQDataObject_t objects[RADARIQ_MAX_OBJECTS];    ///< Array to store the detected objects data
 } RadarIQDataObjectTracking_t;
@@ -231,9 +279,12 @@ typedef enum
     RADARIQ_MSG_CODE_INVALID_VALUE      = 101,  ///< Invalid parameter in UART command sent to the device
 } RadarIQMsgCode_t;
 
+/**
+ * Message sent from the device, queued until read with RadarIQ_popMessage()
+ */
 typedef struct
 {
-    RadarIQMsgType_t type;
+    RadarIQMsgType_t type;                      ///< Type of message
     uint8_t code;                               ///< Warning/error code or 0 for general debug messages     
     char message[RADARIQ_MAX_MESSAGE_STRING];   ///< Accesses the string from message packets
 } RadarIQMsg_t;
@@ -248,6 +299,41 @@ typedef union
 
 } RadarIQData_t;
 
+/**
+ * Completeness of a point-cloud or object-tracking frame assembled from subframes
+ */
+typedef struct
+{
+    uint16_t received;              ///< Number of points or objects stored
+    uint16_t expected;              ///< Number of points or objects announced by the subframes that arrived
+    uint16_t dropped;               ///< Number of points or objects that arrived but could not be stored
+    uint16_t filtered;              ///< Number of points discarded by the host point filter
+    uint8_t numSubframes;           ///< Number of subframes that arrived
+    bool isStartMissed;             ///< The frame's start subframe was lost, earlier points are missing
+    bool isComplete;                ///< Every subframe arrived and every point or object was stored
+} RadarIQFrameInfo_t;
+
+/**
+ * Frame assembly counters since initialization
+ */
+typedef struct
+{
+    uint32_t complete;              ///< Number of frames delivered complete
+    uint32_t partial;               ///< Number of frames delivered with a lost start subframe or dropped points
+    uint32_t abandoned;             ///< Number of frames discarded because a new frame started before their end subframe
+} RadarIQFrameCounters_t;
+
+/**
+ * A completed frame with its assembly information
+ */
+typedef struct
+{
+    RadarIQData_t data;              ///< The frame, pointCloud or objectTracking depending on type
+    RadarIQFrameInfo_t info;         ///< Subframe completeness of the frame
+    RadarIQCommand_t type;           ///< RADARIQ_CMD_PNT_CLOUD_FRAME or RADARIQ_CMD_OBJ_TRACKING_FRAME
+    uint32_t sequence;               ///< Number of frames completed before this one
+} RadarIQFrame_t;
+
 /**
  * Radar chip temperature measurements sent from RadarIQ device
  */
@@ -343,6 +429,144 @@ typedef struct
     bool isReadable;         ///< Indicates whether data is available for reading from UART
 } RadarIQUartData_t;
 
+/**
+ * UART transport counters
+ */
+typedef struct
+{
+    uint32_t bytesIn;               ///< Number of bytes received from the device, including framing and escapes
+    uint32_t bytesOut;              ///< Number of bytes sent to the device, including framing and escapes
+    uint32_t escapeBytesIn;         ///< Number of escape bytes received
+    uint32_t escapeBytesOut;        ///< Number of escape bytes sent
+    uint32_t packetsIn;             ///< Number of complete packets received which passed the CRC check
+    uint32_t packetsOut;            ///< Number of packets sent
+    uint32_t crcErrors;             ///< Number of received packets which failed decoding or the CRC check
+    uint32_t unknownPackets;        ///< Number of received packets with an unknown command
+    uint32_t malformedPackets;      ///< Number of received packets with the wrong variant or length for their command
+    uint32_t timeouts;              ///< Number of commands which timed out waiting for a response
+} RadarIQTransportCounters_t;
+
+/**
+ * Round-trip latency histogram of one command
+ * Buckets are log-linear: ::RADARIQ_LATENCY_SUB_BUCKET_BITS linear sub-buckets for each power of 2 microseconds
+ */
+typedef struct
+{
+    uint32_t count;                             ///< Number of responses received
+    uint32_t timeouts;                          ///< Number of requests which timed out
+    uint32_t minMicros;                         ///< Shortest round-trip time in microseconds
+    uint32_t maxMicros;                         ///< Longest round-trip time in microseconds
+    uint64_t sumMicros;                         ///< Sum of all round-trip times in microseconds
+    uint32_t buckets[RADARIQ_LATENCY_BUCKETS];  ///< Number of responses in each latency bucket
+} RadarIQLatencyHistogram_t;
+
+/**
+ * UART transport statistics
+ */
+typedef struct
+{
+    RadarIQTransportCounters_t counters;                            ///< Byte and packet counters
+#if RADARIQ_LATENCY_HISTOGRAM_ENABLE == 1
+    RadarIQLatencyHistogram_t latency[RADARIQ_LATENCY_COMMANDS];    ///< Round-trip latency, indexed by RadarIQCommand_t
+#endif
+} RadarIQTransportStats_t;
+
+/**
+ * A piece of a raw data packet's payload, passed to the raw data callback
+ */
+typedef struct
+{
+    const uint8_t * data;            ///< Payload bytes, only valid during the callback
+    uint16_t len;                    ///< Number of payload bytes, may be 0 in the last chunk
+    uint32_t offset;                 ///< Position of the first byte in the packet's payload
+    uint32_t sequence;               ///< Number of raw data packets started before this one since the statistics were reset
+    bool isLast;                     ///< The packet has ended, no more chunks of it follow
+    bool isValid;                    ///< The last chunk of a packet whose CRC matched, false if the CRC failed or the packet was abandoned
+} RadarIQRawChunk_t;
+
+/**
+ * Raw data streaming statistics
+ * Throughput in bytes/second is bytes * 1000000 / (lastMicros - firstMicros)
+ */
+typedef struct
+{
+    uint32_t started;                ///< Number of raw data packets started
+    uint32_t packets;                ///< Number of raw data packets received with a matching CRC
+    uint32_t crcErrors;              ///< Number of raw data packets which failed the CRC check
+    uint32_t abandoned;              ///< Number of raw data packets cut short by a header or ::RADARIQ_RAW_MAX_PACKET
+    uint32_t chunks;                 ///< Number of chunks passed to the callback
+    uint64_t bytes;                  ///< Number of payload bytes passed to the callback
+    uint32_t firstMicros;            ///< Time the first raw data packet started
+    uint32_t lastMicros;             ///< Time the most recent raw data packet ended
+} RadarIQRawDataStats_t;
+
+/**
+ * Packet pipeline trace points
+ */
+typedef enum
+{
+    RADARIQ_TRACE_BYTE_RECEIVED = 0,        ///< A byte was read from the UART, argument is the byte, only with RADARIQ_TRACE_BYTES_ENABLE
+    RADARIQ_TRACE_HEADER = 1,               ///< A packet header was found
+    RADARIQ_TRACE_FOOTER = 2,               ///< A packet footer was found, argument is the encoded packet length
+    RADARIQ_TRACE_DECODE_DONE = 3,          ///< A packet was unescaped, argument is the decoded packet length
+    RADARIQ_TRACE_CRC_DONE = 4,             ///< A packet's CRC was checked, argument is 1 if it matched
+    RADARIQ_TRACE_PARSE_DONE = 5,           ///< A packet was parsed, argument is the packet command
+    RADARIQ_TRACE_COMMAND_SENT = 6,         ///< A packet was sent, argument is the packet command
+    RADARIQ_TRACE_RESPONSE_MATCHED = 7      ///< A response matched the last command sent, argument is the packet command
+} RadarIQTraceEvent_t;
+
+/**
+ * Trace event recorded at a trace point
+ */
+typedef struct
+{
+    uint32_t timeMicros;            ///< Time of the event from the microsecond callback, or the millisecond callback x 1000
+    uint8_t event;                  ///< The trace point, a RadarIQTraceEvent_t
+    uint16_t arg;                   ///< Argument of the trace point
+} RadarIQTraceRecord_t;
+
+/**
+ * Sensor mounting pose (extrinsic calibration) mapping sensor-frame coordinates into a world frame
+ */
+typedef struct
+{
+    float rotation[3][3];           ///< Rotation matrix from the sensor frame to the world frame
+    float translation[3];           ///< Position of the sensor in the world frame in millimeters
+} RadarIQPose_t;
+
+/**
+ * Host point filter predicates, combined in RadarIQPointFilter_t::predicates
+ */
+typedef enum
+{
+    RADARIQ_POINT_FILTER_BOX = 0x01,            ///< Keep points inside the axis-aligned box
+    RADARIQ_POINT_FILTER_SECTOR = 0x02,         ///< Keep points inside the range and azimuth sector
+    RADARIQ_POINT_FILTER_VELOCITY = 0x04,       ///< Keep points whose speed is inside the velocity band
+    RADARIQ_POINT_FILTER_INTENSITY = 0x08       ///< Keep points at or above the intensity floor
+} RadarIQPointFilterPredicate_t;
+
+/**
+ * Host point filter applied while point-cloud packets are parsed. A point is kept if it passes every enabled predicate.
+ * Bounds are inclusive.
+ */
+typedef struct
+{
+    uint8_t predicates;             ///< Bitwise OR of the RadarIQPointFilterPredicate_t to apply, 0 keeps every point
+    int16_t minX;                   ///< Box minimum x-coordinate in millimeters
+    int16_t maxX;                   ///< Box maximum x-coordinate in millimeters
+    int16_t minY;                   ///< Box minimum y-coordinate in millimeters
+    int16_t maxY;                   ///< Box maximum y-coordinate in millimeters
+    int16_t minZ;                   ///< Box minimum z-coordinate in millimeters
+    int16_t maxZ;                   ///< Box maximum z-coordinate in millimeters
+    uint16_t minRange;              ///< Sector minimum distance from the sensor in millimeters
+    uint16_t maxRange;              ///< Sector maximum distance from the sensor in millimeters
+    int8_t minAzimuth;              ///< Sector minimum angle from the y-axis towards the x-axis in degrees
+    int8_t maxAzimuth;              ///< Sector maximum angle from the y-axis towards the x-axis in degrees
+    uint16_t minSpeed;              ///< Velocity band minimum magnitude in millimeters/second
+    uint16_t maxSpeed;              ///< Velocity band maximum magnitude in millimeters/second
+    uint8_t minIntensity;           ///< Intensity floor
+} RadarIQPointFilter_t;
+
 //===============================================================================================//
 // OBJECTS
 //===============================================================================================//
@@ -359,20 +583,70 @@ RadarIQHandle_t RadarIQ_init(void(*sendSerialDataCallback)(uint8_t * const, cons
         RadarIQUartData_t(*readSerialDataCallback)(void),
         void(*logCallback)(char * const),
         uint32_t(*millisCallback)(void));
+void RadarIQ_destroy(const RadarIQHandle_t obj);
 
 /* UART read function */
 RadarIQCommand_t RadarIQ_readSerial(const RadarIQHandle_t obj);
 
+/* Event-driven I/O */
+RadarIQCommand_t RadarIQ_processByte(const RadarIQHandle_t obj, const uint8_t data);
+void RadarIQ_setSendCallback(const RadarIQHandle_t obj,
+        void(*sendCallback)(void * const, uint8_t * const, const uint16_t), void * const context);
+RadarIQReturnVal_t RadarIQ_sendCommand(const RadarIQHandle_t obj, const RadarIQCommand_t command,
+        const RadarIQCommandVariant_t variant, const uint8_t * const payload, const uint8_t len);
+void RadarIQ_expireCommand(const RadarIQHandle_t obj);
+
 /* Debug & info */
 uint32_t RadarIQ_getMemoryUsage(void);
 uint16_t RadarIQ_getDataBuffer(const RadarIQHandle_t obj, uint8_t* dest);
 
+/* Device messages */
+bool RadarIQ_popMessage(const RadarIQHandle_t obj, RadarIQMsg_t * const dest);
+uint16_t RadarIQ_formatMessage(const RadarIQMsg_t * const msg, char * const dest, const uint16_t maxLen);
+uint8_t RadarIQ_flushMessages(const RadarIQHandle_t obj);
+void RadarIQ_getMessageCounts(const RadarIQHandle_t obj, uint32_t * const dropped, uint32_t * const rateLimited);
+
+/* Instrumentation */
+void RadarIQ_setMicrosCallback(const RadarIQHandle_t obj, uint32_t(*microsCallback)(void));
+uint32_t RadarIQ_getMillis(const RadarIQHandle_t obj);
+void RadarIQ_getTransportStats(const RadarIQHandle_t obj, RadarIQTransportStats_t * const dest);
+void RadarIQ_resetTransportStats(const RadarIQHandle_t obj);
+uint32_t RadarIQ_getLatencyPercentile(const RadarIQLatencyHistogram_t * const histogram, const uint8_t percentile);
+uint16_t RadarIQ_getTraceEvents(const RadarIQHandle_t obj, RadarIQTraceRecord_t * const dest, const uint16_t maxEvents);
+
+/* Raw data streaming */
+void RadarIQ_setRawDataCallback(const RadarIQHandle_t obj,
+        void(*rawDataCallback)(void * const, const RadarIQRawChunk_t * const), void * const context);
+void RadarIQ_getRawDataStats(const RadarIQHandle_t obj, RadarIQRawDataStats_t * const dest);
+void RadarIQ_resetRawDataStats(const RadarIQHandle_t obj);
+
 /* Data & stats getters */
 void RadarIQ_getData(const RadarIQHandle_t obj, RadarIQData_t * dest);
+void RadarIQ_getFrameInfo(const RadarIQHandle_t obj, RadarIQFrameInfo_t * const dest);
+uint16_t RadarIQ_getPoints(const RadarIQHandle_t obj, const RadarIQDataPoint_t ** const points);
+void RadarIQ_setFrameBuffer(const RadarIQHandle_t obj, RadarIQData_t * const buffer);
+void RadarIQ_getFrameCounters(const RadarIQHandle_t obj, RadarIQFrameCounters_t * const dest);
 void RadarIQ_getProcessingStats(const RadarIQHandle_t obj, RadarIQProcessingStats_t * const dest);
+void RadarIQ_getProcessingSample(const RadarIQHandle_t obj, RadarIQProcessingStats_t * const processing,
+        RadarIQChipTemperatures_t * const temperatures);
 void RadarIQ_getPointCloudStats(const RadarIQHandle_t obj, RadarIQPointcloudStats_t * const dest);
 void RadarIQ_getChipTemperatures(const RadarIQHandle_t obj, RadarIQChipTemperatures_t * const dest);
 bool RadarIQ_isPowerGood(const RadarIQHandle_t obj);
+bool RadarIQ_getLatestFrame(const RadarIQHandle_t obj, RadarIQFrame_t * const dest);
+
+/* Extrinsic calibration */
+void RadarIQ_setPose(const RadarIQHandle_t obj, const RadarIQPose_t * const pose);
+void RadarIQ_getPose(const RadarIQHandle_t obj, RadarIQPose_t * const dest);
+
+/* Host point filter */
+RadarIQReturnVal_t RadarIQ_setPointFilter(const RadarIQHandle_t obj, const RadarIQPointFilter_t * const filter);
+void RadarIQ_getPointFilter(const RadarIQHandle_t obj, RadarIQPointFilter_t * const dest);
+
+/* Device settings */
+RadarIQReturnVal_t RadarIQ_encodeSetting(const RadarIQCommand_t command, int32_t * const values,
+        uint8_t * const payload, uint8_t * const len);
+RadarIQReturnVal_t RadarIQ_decodeSetting(const RadarIQCommand_t command, const uint8_t * const packet,
+        const uint16_t len, int32_t * const values);
 
 /* UART commands */
 void RadarIQ_start(const RadarIQHandle_t obj, const uint8_t numFrames);
@@ -0,0 +1,841 @@
+/**
+ * @file
+ * RadarIQ SDK - C++20 coroutine interface.
+ * Lets coroutines await frames, processing statistics and command responses from a RadarIQ handle, e.g.
+ * `co_await sensor.setFrameRate(20u)` or `co_await sensor.nextFrame()`. The awaiters are resumed by the existing
+ * packet parser as bytes are fed in, through an executor supplied by the application. No threads are created and
+ * awaiting does not allocate: each awaiter lives in the awaiting coroutine's frame and is linked into the sensor's
+ * wait lists intrusively.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+#ifndef SRC_RADARIQ_HPP_
+#define SRC_RADARIQ_HPP_
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "RadarIQ.h"
+
+namespace radariq
+{
+
+//===============================================================================================//
+// DEFINITIONS
+//===============================================================================================//
+
+constexpr uint32_t DEFAULT_COMMAND_TIMEOUT_MILLIS = 1000u;    ///< Time to wait for a command's response
+constexpr uint32_t SCENE_CALIBRATE_TIMEOUT_MILLIS = 20000u;   ///< Time to wait for scene calibration to finish
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * A suspended coroutine waiting to be resumed, linked intrusively into an executor's queue
+ */
+struct Resumable
+{
+    std::coroutine_handle<> handle {};      ///< The coroutine to resume
+    Resumable * next = nullptr;             ///< Next entry in the queue it is posted to
+};
+
+/**
+ * Result of an awaited command
+ */
+template <typename T>
+struct Result
+{
+    RadarIQReturnVal_t status = RADARIQ_RETURN_VAL_ERR;    ///< ::RADARIQ_RETURN_VAL_OK if a valid response arrived
+    T value {};                                            ///< The value read from the response
+
+    explicit operator bool() const noexcept { return (RADARIQ_RETURN_VAL_OK == status); }
+};
+
+/**
+ * A min/max pair of a range setting, e.g. the distance filter
+ */
+template <typename T>
+struct Range
+{
+    T min {};            ///< Lower limit
+    T max {};            ///< Upper limit
+};
+
+/**
+ * Firmware and hardware versions of the device
+ */
+struct Versions
+{
+    RadarIQVersion_t firmware {};        ///< Firmware version
+    RadarIQVersion_t hardware {};        ///< Hardware version
+};
+
+/**
+ * A completed frame, copied from the handle when its last sub-frame was parsed
+ */
+struct Frame
+{
+    RadarIQCommand_t type = RADARIQ_CMD_NONE;    ///< ::RADARIQ_CMD_PNT_CLOUD_FRAME or ::RADARIQ_CMD_OBJ_TRACKING_FRAME
+    RadarIQFrameInfo_t info {};                  ///< Subframe completeness and point counts of the frame
+    RadarIQData_t data {};                       ///< The frame's points or objects
+};
+
+/**
+ * Processing statistics and chip temperatures from one ::RADARIQ_CMD_PROC_STATS packet
+ */
+struct Stats
+{
+    RadarIQProcessingStats_t processing {};      ///< Processing statistics
+    RadarIQChipTemperatures_t temperatures {};   ///< Chip temperatures
+};
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+/**
+ * Decides where and when awaiting coroutines are resumed. Implementations must not allocate or block.
+ */
+class Executor
+{
+public:
+    virtual ~Executor() = default;
+
+    /**
+     * Schedules a suspended coroutine to be resumed. The entry stays valid until its handle is resumed.
+     *
+     * @param entry The coroutine to resume
+     */
+    virtual void post(Resumable & entry) noexcept = 0;
+};
+
+/**
+ * Resumes coroutines immediately, from inside Sensor::feed() or Sensor::tick()
+ */
+class InlineExecutor final : public Executor
+{
+public:
+    void post(Resumable & entry) noexcept override
+    {
+        entry.handle.resume();
+    }
+};
+
+/**
+ * Queues coroutines in order until run() is called, e.g. from the application's main loop
+ */
+class QueueExecutor final : public Executor
+{
+public:
+    void post(Resumable & entry) noexcept override
+    {
+        entry.next = nullptr;
+        if (nullptr == tail_)
+        {
+            head_ = &entry;
+        }
+        else
+        {
+            tail_->next = &entry;
+        }
+        tail_ = &entry;
+    }
+
+    /**
+     * Resumes queued coroutines, including any posted while running, until the queue is empty.
+     *
+     * @return Number of coroutines resumed
+     */
+    uint32_t run() noexcept
+    {
+        uint32_t count = 0u;
+
+        while (nullptr != head_)
+        {
+            Resumable * const entry = head_;
+            head_ = entry->next;
+            if (nullptr == head_)
+            {
+                tail_ = nullptr;
+            }
+
+            // The entry belongs to the coroutine's frame, take its handle before resuming
+            const std::coroutine_handle<> handle = entry->handle;
+            handle.resume();
+            count++;
+        }
+
+        return count;
+    }
+
+    bool isEmpty() const noexcept { return (nullptr == head_); }
+
+private:
+    Resumable * head_ = nullptr;
+    Resumable * tail_ = nullptr;
+};
+
+class Sensor;
+
+/**
+ * Awaits the next completed frame
+ */
+class FrameAwaiter : private Resumable
+{
+public:
+    explicit FrameAwaiter(Sensor & sensor) noexcept : sensor_(sensor) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) noexcept;
+    const Frame & await_resume() const noexcept { return frame_; }
+
+private:
+    friend class Sensor;
+
+    Sensor & sensor_;
+    FrameAwaiter * nextWaiter_ = nullptr;
+    Frame frame_;
+};
+
+/**
+ * Awaits the next processing statistics packet
+ */
+class StatsAwaiter : private Resumable
+{
+public:
+    explicit StatsAwaiter(Sensor & sensor) noexcept : sensor_(sensor) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) noexcept;
+    const Stats & await_resume() const noexcept { return stats_; }
+
+private:
+    friend class Sensor;
+
+    Sensor & sensor_;
+    StatsAwaiter * nextWaiter_ = nullptr;
+    Stats stats_;
+};
+
+/**
+ * Command state shared by all awaited commands, queued intrusively on the sensor and sent one at a time
+ */
+class CommandBase : protected Resumable
+{
+protected:
+    CommandBase(Sensor & sensor, const RadarIQCommand_t command, const RadarIQCommandVariant_t variant,
+            const uint32_t timeoutMillis) noexcept
+        : sensor_(sensor), command_(command), variant_(variant), timeoutMillis_(timeoutMillis) {}
+
+    /**
+     * Reads the response into the result.
+     *
+     * @param data The decoded packet, starting with the command byte
+     * @param len Length of the packet in bytes
+     *
+     * @return True if the response was valid
+     */
+    virtual bool parse(const uint8_t * const data, const uint16_t len) noexcept = 0;
+
+    void suspend(std::coroutine_handle<> handle) noexcept;
+
+    friend class Sensor;
+
+    Sensor & sensor_;
+    RadarIQCommand_t command_;
+    RadarIQCommandVariant_t variant_;
+    uint8_t payload_[RADARIQ_MAX_COMMAND_PAYLOAD] {};
+    uint8_t len_ = 0u;
+    uint32_t timeoutMillis_;
+    uint32_t deadlineMillis_ = 0u;
+    RadarIQReturnVal_t status_ = RADARIQ_RETURN_VAL_ERR;
+    RadarIQReturnVal_t warning_ = RADARIQ_RETURN_VAL_OK;
+    bool isRejected_ = false;
+    bool expectsResponse_ = true;
+    CommandBase * nextCommand_ = nullptr;
+};
+
+/**
+ * Awaits the response to a command, reading it with a parse function
+ */
+template <typename T>
+class CommandAwaiter final : public CommandBase
+{
+public:
+    using Parse = bool(*)(const uint8_t * data, uint16_t len, T & value);
+
+    CommandAwaiter(Sensor & sensor, const RadarIQCommand_t command, const RadarIQCommandVariant_t variant,
+            const Parse parseFn, const uint32_t timeoutMillis) noexcept
+        : CommandBase(sensor, command, variant, timeoutMillis), parseFn_(parseFn) {}
+
+    /**
+     * Sets the command's parameters, at most ::RADARIQ_MAX_COMMAND_PAYLOAD bytes.
+     */
+    CommandAwaiter & payload(const uint8_t * const data, const uint8_t len) noexcept
+    {
+        len_ = (RADARIQ_MAX_COMMAND_PAYLOAD < len) ? RADARIQ_MAX_COMMAND_PAYLOAD : len;
+        memcpy(payload_, data, len_);
+        return *this;
+    }
+
+    /**
+     * Applies the result of validating the parameters, e.g. from RadarIQ_encodeSetting().
+     * ::RADARIQ_RETURN_VAL_WARNING is reported on success, ::RADARIQ_RETURN_VAL_ERR fails the command without sending it.
+     */
+    CommandAwaiter & validate(const RadarIQReturnVal_t status) noexcept
+    {
+        if (RADARIQ_RETURN_VAL_ERR == status)
+        {
+            isRejected_ = true;
+        }
+        else
+        {
+            warning_ = status;
+        }
+        return *this;
+    }
+
+    /**
+     * Completes the command once it is sent, for commands the device does not respond to.
+     */
+    CommandAwaiter & noResponse() noexcept
+    {
+        expectsResponse_ = false;
+        return *this;
+    }
+
+    bool await_ready() const noexcept { return isRejected_; }
+    void await_suspend(std::coroutine_handle<> handle) noexcept { suspend(handle); }
+
+    Result<T> await_resume() const noexcept
+    {
+        Result<T> result;
+        result.status = status_;
+        result.value = value_;
+        return result;
+    }
+
+private:
+    bool parse(const uint8_t * const data, const uint16_t len) noexcept override
+    {
+        return (nullptr == parseFn_) || parseFn_(data, len, value_);
+    }
+
+    Parse parseFn_;
+    T value_ {};
+};
+
+/**
+ * Empty result of commands that only return a status
+ */
+struct None {};
+
+/**
+ * Drives awaiters from one RadarIQ handle. Bytes received from the device are passed to feed(), and tick() is
+ * called periodically with the current time so that command timeouts expire. All calls must come from one thread.
+ */
+class Sensor
+{
+public:
+    /**
+     * @param radar The RadarIQ object handle returned from RadarIQ_init(), its send callback transmits commands
+     * @param executor Resumes awaiting coroutines, must outlive the sensor
+     */
+    Sensor(const RadarIQHandle_t radar, Executor & executor) noexcept : radar_(radar), executor_(executor) {}
+
+    Sensor(const Sensor &) = delete;
+    Sensor & operator=(const Sensor &) = delete;
+
+    RadarIQHandle_t handle() const noexcept { return radar_; }
+
+    /**
+     * Parses received bytes, resuming awaiters as their packets complete.
+     *
+     * @param data Bytes read from the device
+     * @param len Number of bytes
+     */
+    void feed(const uint8_t * const data, const size_t len) noexcept
+    {
+        for (size_t i = 0u; i < len; i++)
+        {
+            const RadarIQCommand_t command = RadarIQ_processByte(radar_, data[i]);
+
+            if ((RADARIQ_CMD_NONE != command) && (RADARIQ_CMD_ERROR != command))
+            {
+                onPacket(command);
+            }
+        }
+    }
+
+    /**
+     * Resumes awaiters of a packet parsed outside feed(), e.g. by RadarIQ_readSerial().
+     *
+     * @param command The command returned by the parser
+     */
+    void onPacket(const RadarIQCommand_t command) noexcept
+    {
+        if ((nullptr != active_) && (command == active_->command_))
+        {
+            CommandBase * const done = active_;
+            const uint16_t len = RadarIQ_getDataBuffer(radar_, response_);
+
+            if (done->parse(response_, len))
+            {
+                done->status_ = done->warning_;
+            }
+            else
+            {
+                done->status_ = RADARIQ_RETURN_VAL_ERR;
+            }
+
+            finishCommand(*done);
+        }
+        else if ((RADARIQ_CMD_PNT_CLOUD_FRAME == command) || (RADARIQ_CMD_OBJ_TRACKING_FRAME == command))
+        {
+            // Detach the list first so waiters that re-await from an inline executor wait for the next frame
+            FrameAwaiter * waiter = frameWaiters_;
+            frameWaiters_ = nullptr;
+
+            while (nullptr != waiter)
+            {
+                FrameAwaiter * const next = waiter->nextWaiter_;
+                waiter->frame_.type = command;
+                RadarIQ_getFrameInfo(radar_, &waiter->frame_.info);
+                RadarIQ_getData(radar_, &waiter->frame_.data);
+                executor_.post(*waiter);
+                waiter = next;
+            }
+        }
+        else if (RADARIQ_CMD_PROC_STATS == command)
+        {
+            StatsAwaiter * waiter = statsWaiters_;
+            statsWaiters_ = nullptr;
+
+            while (nullptr != waiter)
+            {
+                StatsAwaiter * const next = waiter->nextWaiter_;
+                RadarIQ_getProcessingSample(radar_, &waiter->stats_.processing, &waiter->stats_.temperatures);
+                executor_.post(*waiter);
+                waiter = next;
+            }
+        }
+    }
+
+    /**
+     * Advances the command timeout clock, failing the awaited command if its response is overdue.
+     *
+     * @param nowMillis Current time in milliseconds from the handle's millis callback, see RadarIQ_getMillis()
+     */
+    void tick(const uint32_t nowMillis) noexcept
+    {
+        if ((nullptr != active_) && ((int32_t)(nowMillis - active_->deadlineMillis_) >= 0))
+        {
+            CommandBase * const done = active_;
+
+            RadarIQ_expireCommand(radar_);
+            done->status_ = RADARIQ_RETURN_VAL_ERR;
+            finishCommand(*done);
+        }
+    }
+
+    /* Streams */
+    FrameAwaiter nextFrame() noexcept { return FrameAwaiter(*this); }
+    StatsAwaiter stats() noexcept { return StatsAwaiter(*this); }
+
+    /* Capture */
+    CommandAwaiter<None> start(const uint8_t numFrames = 0u) noexcept
+    {
+        CommandAwaiter<None> awaiter(*this, RADARIQ_CMD_CAPTURE_START, RADARIQ_CMD_VAR_REQUEST, nullptr, 0u);
+        awaiter.payload(&numFrames, 1u).noResponse();
+        return awaiter;
+    }
+
+    CommandAwaiter<None> stop() noexcept
+    {
+        CommandAwaiter<None> awaiter(*this, RADARIQ_CMD_CAPTURE_STOP, RADARIQ_CMD_VAR_REQUEST, nullptr, 0u);
+        awaiter.noResponse();
+        return awaiter;
+    }
+
+    /* Device */
+    CommandAwaiter<None> reset(const RadarIQResetCode_t code,
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        const uint8_t param = (uint8_t)code;
+        const bool isValid = (RADARIQ_RESET_REBOOT == code) || (RADARIQ_RESET_FACTORY_SETTINGS == code);
+
+        CommandAwaiter<None> awaiter(*this, RADARIQ_CMD_RESET, RADARIQ_CMD_VAR_SET, nullptr, timeoutMillis);
+        awaiter.payload(&param, 1u).validate(isValid ? RADARIQ_RETURN_VAL_OK : RADARIQ_RETURN_VAL_ERR);
+        return awaiter;
+    }
+
+    CommandAwaiter<None> save(const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        return CommandAwaiter<None>(*this, RADARIQ_CMD_SAVE, RADARIQ_CMD_VAR_REQUEST, nullptr, timeoutMillis);
+    }
+
+    CommandAwaiter<Versions> getVersion(const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        return CommandAwaiter<Versions>(*this, RADARIQ_CMD_VERSION, RADARIQ_CMD_VAR_REQUEST,
+                &Sensor::parseVersions, timeoutMillis);
+    }
+
+    CommandAwaiter<RadarIQVersionIWR_t> getRadarVersion(const RadarIQCaptureMode_t mode,
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        const uint8_t param = (uint8_t)mode;
+        const bool isValid = (RADARIQ_MODE_POINT_CLOUD <= mode) && (RADARIQ_MODE_OBJECT_TRACKING >= mode);
+
+        CommandAwaiter<RadarIQVersionIWR_t> awaiter(*this, RADARIQ_CMD_IWR_VERSION, RADARIQ_CMD_VAR_REQUEST,
+                &Sensor::parseRadarVersion, timeoutMillis);
+        awaiter.payload(&param, 1u).validate(isValid ? RADARIQ_RETURN_VAL_OK : RADARIQ_RETURN_VAL_ERR);
+        return awaiter;
+    }
+
+    CommandAwaiter<RadarIQSerialNo_t> getSerialNumber(
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        return CommandAwaiter<RadarIQSerialNo_t>(*this, RADARIQ_CMD_SERIAL, RADARIQ_CMD_VAR_REQUEST,
+                &Sensor::parseSerialNumber, timeoutMillis);
+    }
+
+    // The device reports progress messages before its response, which can take several seconds
+    CommandAwaiter<None> sceneCalibrate(const uint32_t timeoutMillis = SCENE_CALIBRATE_TIMEOUT_MILLIS) noexcept
+    {
+        return CommandAwaiter<None>(*this, RADARIQ_CMD_SCENE_CALIB, RADARIQ_CMD_VAR_SET, nullptr, timeoutMillis);
+    }
+
+    /* Settings, validated and encoded by RadarIQ_settingTable as the blocking get/set functions are */
+    using DistanceFilter = Range<uint16_t>;    ///< Distance filter in millimeters
+    using AngleFilter = Range<int8_t>;         ///< Angle filter in degrees
+    using HeightFilter = Range<int16_t>;       ///< Height filter in millimeters
+
+    CommandAwaiter<uint8_t> getFrameRate(const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        return getSetting<RADARIQ_CMD_FRAME_RATE, uint8_t>(timeoutMillis);
+    }
+
+    CommandAwaiter<None> setFrameRate(const uint8_t rate,
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        int32_t values[1] = { rate };
+        return setSetting(RADARIQ_CMD_FRAME_RATE, values, timeoutMillis);
+    }
+
+    CommandAwaiter<RadarIQCaptureMode_t> getMode(
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        return getSetting<RADARIQ_CMD_MODE, RadarIQCaptureMode_t>(timeoutMillis);
+    }
+
+    CommandAwaiter<None> setMode(const RadarIQCaptureMode_t mode,
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        int32_t values[1] = { (int32_t)mode };
+        return setSetting(RADARIQ_CMD_MODE, values, timeoutMillis);
+    }
+
+    CommandAwaiter<DistanceFilter> getDistanceFilter(
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        return getSetting<RADARIQ_CMD_DIST_FILT, DistanceFilter>(timeoutMillis);
+    }
+
+    CommandAwaiter<None> setDistanceFilter(const uint16_t min, const uint16_t max,
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        int32_t values[2] = { min, max };
+        return setSetting(RADARIQ_CMD_DIST_FILT, values, timeoutMillis);
+    }
+
+    CommandAwaiter<AngleFilter> getAngleFilter(const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        return getSetting<RADARIQ_CMD_ANGLE_FILT, AngleFilter>(timeoutMillis);
+    }
+
+    CommandAwaiter<None> setAngleFilter(const int8_t min, const int8_t max,
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        int32_t values[2] = { min, max };
+        return setSetting(RADARIQ_CMD_ANGLE_FILT, values, timeoutMillis);
+    }
+
+    CommandAwaiter<RadarIQMovingFilterMode_t> getMovingFilter(
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        return getSetting<RADARIQ_CMD_MOVING_FILT, RadarIQMovingFilterMode_t>(timeoutMillis);
+    }
+
+    CommandAwaiter<None> setMovingFilter(const RadarIQMovingFilterMode_t filter,
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        int32_t values[1] = { (int32_t)filter };
+        return setSetting(RADARIQ_CMD_MOVING_FILT, values, timeoutMillis);
+    }
+
+    CommandAwaiter<RadarIQPointDensity_t> getPointDensity(
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        return getSetting<RADARIQ_CMD_PNT_DENSITY, RadarIQPointDensity_t>(timeoutMillis);
+    }
+
+    CommandAwaiter<None> setPointDensity(const RadarIQPointDensity_t density,
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        int32_t values[1] = { (int32_t)density };
+        return setSetting(RADARIQ_CMD_PNT_DENSITY, values, timeoutMillis);
+    }
+
+    CommandAwaiter<uint8_t> getSensitivity(const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        return getSetting<RADARIQ_CMD_SENSITIVITY, uint8_t>(timeoutMillis);
+    }
+
+    CommandAwaiter<None> setSensitivity(const uint8_t sensitivity,
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        int32_t values[1] = { sensitivity };
+        return setSetting(RADARIQ_CMD_SENSITIVITY, values, timeoutMillis);
+    }
+
+    CommandAwaiter<HeightFilter> getHeightFilter(
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        return getSetting<RADARIQ_CMD_HEIGHT_FILT, HeightFilter>(timeoutMillis);
+    }
+
+    CommandAwaiter<None> setHeightFilter(const int16_t min, const int16_t max,
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        int32_t values[2] = { min, max };
+        return setSetting(RADARIQ_CMD_HEIGHT_FILT, values, timeoutMillis);
+    }
+
+    CommandAwaiter<uint8_t> getObjectSize(const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        return getSetting<RADARIQ_CMD_OBJECT_SIZE, uint8_t>(timeoutMillis);
+    }
+
+    CommandAwaiter<None> setObjectSize(const uint8_t size,
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        int32_t values[1] = { size };
+        return setSetting(RADARIQ_CMD_OBJECT_SIZE, values, timeoutMillis);
+    }
+
+    CommandAwaiter<uint8_t> getAutoStart(const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        return getSetting<RADARIQ_CMD_AUTO_START, uint8_t>(timeoutMillis);
+    }
+
+    CommandAwaiter<None> setAutoStart(const uint8_t autoStart,
+            const uint32_t timeoutMillis = DEFAULT_COMMAND_TIMEOUT_MILLIS) noexcept
+    {
+        int32_t values[1] = { autoStart };
+        return setSetting(RADARIQ_CMD_AUTO_START, values, timeoutMillis);
+    }
+
+private:
+    friend class FrameAwaiter;
+    friend class StatsAwaiter;
+    friend class CommandBase;
+
+    template <RadarIQCommand_t C, typename T>
+    CommandAwaiter<T> getSetting(const uint32_t timeoutMillis) noexcept
+    {
+        return CommandAwaiter<T>(*this, C, RADARIQ_CMD_VAR_REQUEST, &Sensor::parseSetting<C, T>, timeoutMillis);
+    }
+
+    CommandAwaiter<None> setSetting(const RadarIQCommand_t command, int32_t * const values,
+            const uint32_t timeoutMillis) noexcept
+    {
+        uint8_t params[RADARIQ_MAX_COMMAND_PAYLOAD];
+        uint8_t len;
+        const RadarIQReturnVal_t status = RadarIQ_encodeSetting(command, values, params, &len);
+
+        CommandAwaiter<None> awaiter(*this, command, RADARIQ_CMD_VAR_SET, nullptr, timeoutMillis);
+        awaiter.payload(params, len).validate(status);
+        return awaiter;
+    }
+
+    template <RadarIQCommand_t C, typename T>
+    static bool parseSetting(const uint8_t * data, uint16_t len, T & value) noexcept
+    {
+        int32_t values[RADARIQ_SETTING_MAX_FIELDS];
+
+        if (RADARIQ_RETURN_VAL_OK != RadarIQ_decodeSetting(C, data, len, values))
+        {
+            return false;
+        }
+        setFields(values, value);
+        return true;
+    }
+
+    template <typename T>
+    static void setFields(const int32_t * const values, T & value) noexcept
+    {
+        value = (T)values[0];
+    }
+
+    template <typename T>
+    static void setFields(const int32_t * const values, Range<T> & value) noexcept
+    {
+        value.min = (T)values[0];
+        value.max = (T)values[1];
+    }
+
+    static bool parseVersions(const uint8_t * data, uint16_t len, Versions & value) noexcept
+    {
+        if (10u > len)
+        {
+            return false;
+        }
+        value.firmware = { data[2], data[3], pack16(&data[4]) };
+        value.hardware = { data[6], data[7], pack16(&data[8]) };
+        return true;
+    }
+
+    static bool parseRadarVersion(const uint8_t * data, uint16_t len, RadarIQVersionIWR_t & value) noexcept
+    {
+        if ((RADARIQ_VERSION_NAME_LEN + 7u) > len)
+        {
+            return false;
+        }
+        memcpy(value.name, &data[3], RADARIQ_VERSION_NAME_LEN);
+        value.major = data[RADARIQ_VERSION_NAME_LEN + 3u];
+        value.minor = data[RADARIQ_VERSION_NAME_LEN + 4u];
+        value.build = pack16(&data[RADARIQ_VERSION_NAME_LEN + 5u]);
+        return true;
+    }
+
+    static bool parseSerialNumber(const uint8_t * data, uint16_t len, RadarIQSerialNo_t & value) noexcept
+    {
+        if (10u > len)
+        {
+            return false;
+        }
+        value.a = pack16(&data[2]) | ((uint32_t)pack16(&data[4]) << 16u);
+        value.b = pack16(&data[6]) | ((uint32_t)pack16(&data[8]) << 16u);
+        return true;
+    }
+
+    static uint16_t pack16(const uint8_t * const data) noexcept
+    {
+        return (uint16_t)(data[0] | ((uint16_t)data[1] << 8u));
+    }
+
+    void addFrameWaiter(FrameAwaiter & waiter) noexcept
+    {
+        waiter.nextWaiter_ = frameWaiters_;
+        frameWaiters_ = &waiter;
+    }
+
+    void addStatsWaiter(StatsAwaiter & waiter) noexcept
+    {
+        waiter.nextWaiter_ = statsWaiters_;
+        statsWaiters_ = &waiter;
+    }
+
+    void queueCommand(CommandBase & command) noexcept
+    {
+        command.nextCommand_ = nullptr;
+        if (nullptr == commandTail_)
+        {
+            commandHead_ = &command;
+        }
+        else
+        {
+            commandTail_->nextCommand_ = &command;
+        }
+        commandTail_ = &command;
+
+        if (nullptr == active_)
+        {
+            sendNext();
+        }
+    }
+
+    void sendNext() noexcept
+    {
+        while ((nullptr == active_) && (nullptr != commandHead_))
+        {
+            CommandBase * const command = commandHead_;
+            commandHead_ = command->nextCommand_;
+            if (nullptr == commandHead_)
+            {
+                commandTail_ = nullptr;
+            }
+
+            if (RADARIQ_RETURN_VAL_OK != RadarIQ_sendCommand(radar_, command->command_, command->variant_,
+                    command->payload_, command->len_))
+            {
+                command->status_ = RADARIQ_RETURN_VAL_ERR;
+                executor_.post(*command);
+            }
+            else if (!command->expectsResponse_)
+            {
+                command->status_ = command->warning_;
+                executor_.post(*command);
+            }
+            else
+            {
+                command->deadlineMillis_ = RadarIQ_getMillis(radar_) + command->timeoutMillis_;
+                active_ = command;
+            }
+        }
+    }
+
+    void finishCommand(CommandBase & command) noexcept
+    {
+        // Send the next command before resuming so an inline executor's new commands queue behind it
+        active_ = nullptr;
+        sendNext();
+        executor_.post(command);
+    }
+
+    RadarIQHandle_t radar_;
+    Executor & executor_;
+    FrameAwaiter * frameWaiters_ = nullptr;
+    StatsAwaiter * statsWaiters_ = nullptr;
+    CommandBase * commandHead_ = nullptr;
+    CommandBase * commandTail_ = nullptr;
+    CommandBase * active_ = nullptr;
+    uint8_t response_[RADARIQ_RX_BUFFER_SIZE] {};
+};
+
+//===============================================================================================//
+// FUNCTIONS
+//===============================================================================================//
+
+inline void FrameAwaiter::await_suspend(std::coroutine_handle<> handle) noexcept
+{
+    this->handle = handle;
+    sensor_.addFrameWaiter(*this);
+}
+
+inline void StatsAwaiter::await_suspend(std::coroutine_handle<> handle) noexcept
+{
+    this->handle = handle;
+    sensor_.addStatsWaiter(*this);
+}
+
+inline void CommandBase::suspend(std::coroutine_handle<> handle) noexcept
+{
+    this->handle = handle;
+    sensor_.queueCommand(*this);
+}
+
+} // namespace radariq
+
+#endif /* SRC_RADARIQ_HPP_ */
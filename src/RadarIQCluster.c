@@ -0,0 +1,611 @@
+/**
+ * @file
+ * RadarIQ SDK - Point-cloud clustering.
+ * Grid-accelerated DBSCAN-style clustering of point-cloud frames with optional velocity dimension
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQCluster.h"
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Running totals used to build a cluster descriptor
+ */
+typedef struct
+{
+    int32_t sumX;                    ///< Sum of point x-coordinates
+    int32_t sumY;                    ///< Sum of point y-coordinates
+    int32_t sumZ;                    ///< Sum of point z-coordinates
+    int32_t sumVelocity;             ///< Sum of point velocities
+    int16_t minX;                    ///< Minimum point x-coordinate
+    int16_t maxX;                    ///< Maximum point x-coordinate
+    int16_t minY;                    ///< Minimum point y-coordinate
+    int16_t maxY;                    ///< Maximum point y-coordinate
+    int16_t minZ;                    ///< Minimum point z-coordinate
+    int16_t maxZ;                    ///< Maximum point z-coordinate
+    uint16_t count;                  ///< Number of points accumulated
+} RadarIQClusterAccum_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+/**
+ * The RadarIQ clusterer object definition
+ * All arrays are carved from a single allocation made in RadarIQClusterer_init()
+ */
+struct RadarIQClusterer_t
+{
+    RadarIQClusterConfig_t config;
+    int64_t epsilonSquared;
+    uint16_t bucketMask;
+
+    uint16_t * bucketHead;           ///< First point in each grid hash bucket
+    uint16_t * next;                 ///< Next point in the same grid hash bucket
+    int16_t * cellX;                 ///< Grid cell x-index of each point
+    int16_t * cellY;                 ///< Grid cell y-index of each point
+    int16_t * cellZ;                 ///< Grid cell z-index of each point
+    int32_t * scaledVelocity;        ///< Velocity of each point scaled into millimeters
+    uint16_t * labels;               ///< Cluster index of each point or ::RADARIQ_CLUSTER_NOISE
+    uint16_t * queue;                ///< Expansion queue
+
+    RadarIQClusterAccum_t * accum;
+    RadarIQCluster_t * previous;     ///< Clusters found in the previous frame
+    uint16_t numPrevious;
+    uint16_t nextId;
+};
+
+//===============================================================================================//
+// CONSTANTS
+//===============================================================================================//
+
+#define RADARIQ_CLUSTER_UNVISITED      0xFFFEu   ///< Internal label for points not yet visited
+#define RADARIQ_CLUSTER_NEIGHBOURS     27u       ///< Number of grid cells searched around a point
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTION PROTOTYPES
+//===============================================================================================//
+
+static uint16_t RadarIQClusterer_getNumBuckets(const uint16_t maxPoints);
+static int16_t RadarIQClusterer_getCell(const int16_t coord, const uint16_t epsilon);
+static uint16_t RadarIQClusterer_hashCell(const int16_t cx, const int16_t cy, const int16_t cz, const uint16_t mask);
+static uint8_t RadarIQClusterer_getBuckets(const RadarIQClustererHandle_t obj, const int16_t cx, const int16_t cy,
+        const int16_t cz, uint16_t * const buckets);
+static bool RadarIQClusterer_isNeighbour(const RadarIQClustererHandle_t obj, const RadarIQDataPoint_t * const points,
+        const uint16_t a, const uint16_t b);
+static bool RadarIQClusterer_isCore(const RadarIQClustererHandle_t obj, const RadarIQDataPoint_t * const points,
+        const uint16_t idx);
+static void RadarIQClusterer_assign(const RadarIQClustererHandle_t obj, const RadarIQDataPoint_t * const points,
+        const uint16_t idx, const uint16_t cluster);
+static void RadarIQClusterer_expand(const RadarIQClustererHandle_t obj, const RadarIQDataPoint_t * const points,
+        const uint16_t seed, const uint16_t cluster);
+static uint16_t RadarIQClusterer_findSeed(const RadarIQClustererHandle_t obj, const RadarIQDataPoint_t * const points,
+        const RadarIQCluster_t * const previous);
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Allocates and initializes a clusterer instance using heap allocation.
+ * All working memory is allocated here so that RadarIQClusterer_process() never allocates.
+ *
+ * @param config Pointer to the clustering configuration
+ *
+ * @return A handle for an instance of the RadarIQClusterer_t object
+ */
+RadarIQClustererHandle_t RadarIQClusterer_init(const RadarIQClusterConfig_t * const config)
+{
+    RADARIQ_ASSERT(NULL != config);
+    RADARIQ_ASSERT(0u < config->maxPoints);
+    RADARIQ_ASSERT(RADARIQ_CLUSTER_UNVISITED > config->maxPoints);
+    RADARIQ_ASSERT(0u < config->maxClusters);
+    RADARIQ_ASSERT(RADARIQ_CLUSTER_UNVISITED > config->maxClusters);
+    RADARIQ_ASSERT(0u < config->epsilon);
+    RADARIQ_ASSERT(0u < config->minPoints);
+
+    RadarIQClustererHandle_t handle = malloc(RadarIQClusterer_getMemoryUsage(config));
+    RADARIQ_ASSERT(NULL != handle);
+    memset((void*)handle, 0, sizeof(RadarIQClusterer_t));
+
+    const uint16_t numBuckets = RadarIQClusterer_getNumBuckets(config->maxPoints);
+    const uint16_t maxPoints = config->maxPoints;
+    const uint16_t maxClusters = config->maxClusters;
+
+    handle->config = *config;
+    handle->epsilonSquared = (int64_t)config->epsilon * (int64_t)config->epsilon;
+    handle->bucketMask = (uint16_t)(numBuckets - 1u);
+
+    // Carve the working arrays from the end of the object, largest alignment first
+    uint8_t * mem = (uint8_t*)(handle + 1);
+    handle->accum = (RadarIQClusterAccum_t*)mem;
+    mem += sizeof(RadarIQClusterAccum_t) * maxClusters;
+    handle->scaledVelocity = (int32_t*)mem;
+    mem += sizeof(int32_t) * maxPoints;
+    handle->previous = (RadarIQCluster_t*)mem;
+    mem += sizeof(RadarIQCluster_t) * maxClusters;
+    handle->bucketHead = (uint16_t*)mem;
+    mem += sizeof(uint16_t) * numBuckets;
+    handle->next = (uint16_t*)mem;
+    mem += sizeof(uint16_t) * maxPoints;
+    handle->labels = (uint16_t*)mem;
+    mem += sizeof(uint16_t) * maxPoints;
+    handle->queue = (uint16_t*)mem;
+    mem += sizeof(uint16_t) * maxPoints;
+    handle->cellX = (int16_t*)mem;
+    mem += sizeof(int16_t) * maxPoints;
+    handle->cellY = (int16_t*)mem;
+    mem += sizeof(int16_t) * maxPoints;
+    handle->cellZ = (int16_t*)mem;
+
+    return handle;
+}
+
+/**
+ * Frees a clusterer instance created by RadarIQClusterer_init().
+ *
+ * @param obj The clusterer handle returned from RadarIQClusterer_init()
+ */
+void RadarIQClusterer_destroy(const RadarIQClustererHandle_t obj)
+{
+    free(obj);
+}
+
+/**
+ * Forgets the clusters of the previous frame so the next frame is solved from scratch with new cluster IDs.
+ *
+ * @param obj The clusterer handle returned from RadarIQClusterer_init()
+ */
+void RadarIQClusterer_reset(const RadarIQClustererHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    obj->numPrevious = 0u;
+}
+
+/**
+ * Clusters the points of one point-cloud frame.
+ * Points closer than the configured epsilon (in position, plus scaled velocity if enabled) are neighbours.
+ * Clusters found in the previous frame are used to seed the search first so that persisting clusters keep their ID.
+ * Points beyond the configured maximum are ignored.
+ *
+ * @param obj The clusterer handle returned from RadarIQClusterer_init()
+ * @param points Pointer to the frame points, e.g. RadarIQDataPointCloud_t::points
+ * @param numPoints The number of points in the frame
+ * @param clusters Pointer to an array of at least RadarIQClusterConfig_t::maxClusters descriptors to write into
+ *
+ * @return The number of clusters written
+ */
+uint16_t RadarIQClusterer_process(const RadarIQClustererHandle_t obj, const RadarIQDataPoint_t * const points,
+        const uint16_t numPoints, RadarIQCluster_t * const clusters)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT((NULL != points) || (0u == numPoints));
+    RADARIQ_ASSERT(NULL != clusters);
+
+    const uint16_t count = (numPoints > obj->config.maxPoints) ? obj->config.maxPoints : numPoints;
+    uint16_t numClusters = 0u;
+
+    // Bin points into the grid hash buckets
+    memset((void*)obj->bucketHead, 0xFF, sizeof(uint16_t) * ((uint32_t)obj->bucketMask + 1u));
+
+    for (uint16_t idx = 0u; idx < count; idx++)
+    {
+        obj->cellX[idx] = RadarIQClusterer_getCell(points[idx].x, obj->config.epsilon);
+        obj->cellY[idx] = RadarIQClusterer_getCell(points[idx].y, obj->config.epsilon);
+        obj->cellZ[idx] = RadarIQClusterer_getCell(points[idx].z, obj->config.epsilon);
+        obj->scaledVelocity[idx] = ((int32_t)points[idx].velocity * (int32_t)obj->config.velocityWeight) / 256;
+        obj->labels[idx] = RADARIQ_CLUSTER_UNVISITED;
+
+        const uint16_t bucket = RadarIQClusterer_hashCell(obj->cellX[idx], obj->cellY[idx], obj->cellZ[idx],
+                obj->bucketMask);
+        obj->next[idx] = obj->bucketHead[bucket];
+        obj->bucketHead[bucket] = idx;
+    }
+
+    // Seed from the clusters of the previous frame
+    for (uint16_t prev = 0u; (prev < obj->numPrevious) && (numClusters < obj->config.maxClusters); prev++)
+    {
+        const uint16_t seed = RadarIQClusterer_findSeed(obj, points, &obj->previous[prev]);
+
+        if ((RADARIQ_CLUSTER_UNVISITED != seed) && RadarIQClusterer_isCore(obj, points, seed))
+        {
+            clusters[numClusters].id = obj->previous[prev].id;
+            RadarIQClusterer_expand(obj, points, seed, numClusters);
+            numClusters++;
+        }
+    }
+
+    // Search the remaining points for new clusters
+    for (uint16_t idx = 0u; idx < count; idx++)
+    {
+        if (RADARIQ_CLUSTER_UNVISITED != obj->labels[idx])
+        {
+            continue;
+        }
+
+        if ((numClusters < obj->config.maxClusters) && RadarIQClusterer_isCore(obj, points, idx))
+        {
+            clusters[numClusters].id = obj->nextId;
+            obj->nextId++;
+            RadarIQClusterer_expand(obj, points, idx, numClusters);
+            numClusters++;
+        }
+        else
+        {
+            obj->labels[idx] = RADARIQ_CLUSTER_NOISE;
+        }
+    }
+
+    // Build the cluster descriptors
+    for (uint16_t cluster = 0u; cluster < numClusters; cluster++)
+    {
+        const RadarIQClusterAccum_t * const accum = &obj->accum[cluster];
+        const int32_t n = (int32_t)accum->count;
+
+        clusters[cluster].numPoints = accum->count;
+        clusters[cluster].x = (int16_t)(accum->sumX / n);
+        clusters[cluster].y = (int16_t)(accum->sumY / n);
+        clusters[cluster].z = (int16_t)(accum->sumZ / n);
+        clusters[cluster].xExtent = (uint16_t)((int32_t)accum->maxX - (int32_t)accum->minX);
+        clusters[cluster].yExtent = (uint16_t)((int32_t)accum->maxY - (int32_t)accum->minY);
+        clusters[cluster].zExtent = (uint16_t)((int32_t)accum->maxZ - (int32_t)accum->minZ);
+        clusters[cluster].velocity = (int16_t)(accum->sumVelocity / n);
+    }
+
+    memcpy((void*)obj->previous, (void*)clusters, sizeof(RadarIQCluster_t) * numClusters);
+    obj->numPrevious = numClusters;
+
+    return numClusters;
+}
+
+/**
+ * Gets the per-point labels of the most recently processed frame.
+ * Each label is an index into the clusters array written by RadarIQClusterer_process(), or ::RADARIQ_CLUSTER_NOISE.
+ *
+ * @param obj The clusterer handle returned from RadarIQClusterer_init()
+ *
+ * @return Pointer to the label array, valid until the next call to RadarIQClusterer_process()
+ */
+const uint16_t * RadarIQClusterer_getLabels(const RadarIQClustererHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    return obj->labels;
+}
+
+/**
+ * Gets the total memory size requirements for one clusterer instance in bytes.
+ *
+ * @param config Pointer to the clustering configuration
+ *
+ * @return The size of a single clusterer instance including its working arrays in bytes
+ */
+uint32_t RadarIQClusterer_getMemoryUsage(const RadarIQClusterConfig_t * const config)
+{
+    RADARIQ_ASSERT(NULL != config);
+
+    const uint32_t maxPoints = config->maxPoints;
+    const uint32_t maxClusters = config->maxClusters;
+
+    return (uint32_t)(sizeof(RadarIQClusterer_t)
+            + ((sizeof(RadarIQClusterAccum_t) + sizeof(RadarIQCluster_t)) * maxClusters)
+            + (sizeof(uint16_t) * RadarIQClusterer_getNumBuckets(config->maxPoints))
+            + ((sizeof(int32_t) + (3u * sizeof(uint16_t)) + (3u * sizeof(int16_t))) * maxPoints));
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Gets the number of grid hash buckets for a point capacity, the smallest power of 2 at least twice the capacity.
+ *
+ * @param maxPoints The maximum number of points per frame
+ *
+ * @return The number of hash buckets
+ */
+static uint16_t RadarIQClusterer_getNumBuckets(const uint16_t maxPoints)
+{
+    uint32_t numBuckets = 16u;
+
+    while ((numBuckets < (2u * (uint32_t)maxPoints)) && (numBuckets < 0x8000u))
+    {
+        numBuckets <<= 1u;
+    }
+
+    return (uint16_t)numBuckets;
+}
+
+/**
+ * Gets the grid cell index of a coordinate, rounding towards negative infinity.
+ *
+ * @param coord The coordinate in millimeters
+ * @param epsilon The grid cell size in millimeters
+ *
+ * @return The grid cell index
+ */
+static int16_t RadarIQClusterer_getCell(const int16_t coord, const uint16_t epsilon)
+{
+    const int32_t size = (int32_t)epsilon;
+    const int32_t value = (int32_t)coord;
+
+    return (int16_t)((value >= 0) ? (value / size) : (((value + 1) / size) - 1));
+}
+
+/**
+ * Hashes a grid cell into a bucket index.
+ *
+ * @param cx The grid cell x-index
+ * @param cy The grid cell y-index
+ * @param cz The grid cell z-index
+ * @param mask The bucket index mask
+ *
+ * @return The bucket index
+ */
+static uint16_t RadarIQClusterer_hashCell(const int16_t cx, const int16_t cy, const int16_t cz, const uint16_t mask)
+{
+    const uint32_t hash = ((uint32_t)(int32_t)cx * 73856093u) ^ ((uint32_t)(int32_t)cy * 19349663u) ^
+            ((uint32_t)(int32_t)cz * 83492791u);
+
+    return (uint16_t)((hash ^ (hash >> 16u)) & mask);
+}
+
+/**
+ * Gets the distinct hash buckets covering the grid cells around a cell.
+ *
+ * @param obj The clusterer handle returned from RadarIQClusterer_init()
+ * @param cx The grid cell x-index
+ * @param cy The grid cell y-index
+ * @param cz The grid cell z-index
+ * @param buckets Pointer to an array of ::RADARIQ_CLUSTER_NEIGHBOURS entries to store the bucket indices into
+ *
+ * @return The number of distinct buckets
+ */
+static uint8_t RadarIQClusterer_getBuckets(const RadarIQClustererHandle_t obj, const int16_t cx, const int16_t cy,
+        const int16_t cz, uint16_t * const buckets)
+{
+    uint8_t numBuckets = 0u;
+
+    for (int16_t dx = -1; dx <= 1; dx++)
+    {
+        for (int16_t dy = -1; dy <= 1; dy++)
+        {
+            for (int16_t dz = -1; dz <= 1; dz++)
+            {
+                const uint16_t bucket = RadarIQClusterer_hashCell((int16_t)(cx + dx), (int16_t)(cy + dy),
+                        (int16_t)(cz + dz), obj->bucketMask);
+
+                // Skip buckets already listed so that no point is visited twice
+                bool isDuplicate = false;
+                for (uint8_t idx = 0u; idx < numBuckets; idx++)
+                {
+                    if (buckets[idx] == bucket)
+                    {
+                        isDuplicate = true;
+                        break;
+                    }
+                }
+
+                if (!isDuplicate)
+                {
+                    buckets[numBuckets] = bucket;
+                    numBuckets++;
+                }
+            }
+        }
+    }
+
+    return numBuckets;
+}
+
+/**
+ * Checks whether two points are within epsilon of each other.
+ *
+ * @param obj The clusterer handle returned from RadarIQClusterer_init()
+ * @param points Pointer to the frame points
+ * @param a Index of the first point
+ * @param b Index of the second point
+ *
+ * @return True if the points are neighbours
+ */
+static bool RadarIQClusterer_isNeighbour(const RadarIQClustererHandle_t obj, const RadarIQDataPoint_t * const points,
+        const uint16_t a, const uint16_t b)
+{
+    const int64_t dx = (int64_t)points[a].x - (int64_t)points[b].x;
+    const int64_t dy = (int64_t)points[a].y - (int64_t)points[b].y;
+    const int64_t dz = (int64_t)points[a].z - (int64_t)points[b].z;
+    const int64_t dv = (int64_t)obj->scaledVelocity[a] - (int64_t)obj->scaledVelocity[b];
+
+    return (((dx * dx) + (dy * dy) + (dz * dz) + (dv * dv)) <= obj->epsilonSquared);
+}
+
+/**
+ * Checks whether a point has at least the configured minimum number of neighbours.
+ *
+ * @param obj The clusterer handle returned from RadarIQClusterer_init()
+ * @param points Pointer to the frame points
+ * @param idx Index of the point
+ *
+ * @return True if the point is a core point
+ */
+static bool RadarIQClusterer_isCore(const RadarIQClustererHandle_t obj, const RadarIQDataPoint_t * const points,
+        const uint16_t idx)
+{
+    uint16_t buckets[RADARIQ_CLUSTER_NEIGHBOURS];
+    const uint8_t numBuckets = RadarIQClusterer_getBuckets(obj, obj->cellX[idx], obj->cellY[idx], obj->cellZ[idx],
+            buckets);
+    uint16_t numNeighbours = 0u;
+
+    for (uint8_t bucket = 0u; bucket < numBuckets; bucket++)
+    {
+        for (uint16_t other = obj->bucketHead[buckets[bucket]]; 0xFFFFu != other; other = obj->next[other])
+        {
+            if (RadarIQClusterer_isNeighbour(obj, points, idx, other))
+            {
+                numNeighbours++;
+                if (numNeighbours >= obj->config.minPoints)
+                {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Labels a point as belonging to a cluster and adds it to the cluster totals.
+ *
+ * @param obj The clusterer handle returned from RadarIQClusterer_init()
+ * @param points Pointer to the frame points
+ * @param idx Index of the point
+ * @param cluster Index of the cluster
+ */
+static void RadarIQClusterer_assign(const RadarIQClustererHandle_t obj, const RadarIQDataPoint_t * const points,
+        const uint16_t idx, const uint16_t cluster)
+{
+    RadarIQClusterAccum_t * const accum = &obj->accum[cluster];
+    const RadarIQDataPoint_t * const point = &points[idx];
+
+    obj->labels[idx] = cluster;
+
+    if (0u == accum->count)
+    {
+        accum->minX = point->x;
+        accum->maxX = point->x;
+        accum->minY = point->y;
+        accum->maxY = point->y;
+        accum->minZ = point->z;
+        accum->maxZ = point->z;
+    }
+
+    accum->sumX += point->x;
+    accum->sumY += point->y;
+    accum->sumZ += point->z;
+    accum->sumVelocity += point->velocity;
+    accum->minX = (point->x < accum->minX) ? point->x : accum->minX;
+    accum->maxX = (point->x > accum->maxX) ? point->x : accum->maxX;
+    accum->minY = (point->y < accum->minY) ? point->y : accum->minY;
+    accum->maxY = (point->y > accum->maxY) ? point->y : accum->maxY;
+    accum->minZ = (point->z < accum->minZ) ? point->z : accum->minZ;
+    accum->maxZ = (point->z > accum->maxZ) ? point->z : accum->maxZ;
+    accum->count++;
+}
+
+/**
+ * Grows a cluster outwards from a core point using a breadth-first search.
+ *
+ * @param obj The clusterer handle returned from RadarIQClusterer_init()
+ * @param points Pointer to the frame points
+ * @param seed Index of the core point to grow from
+ * @param cluster Index of the cluster
+ */
+static void RadarIQClusterer_expand(const RadarIQClustererHandle_t obj, const RadarIQDataPoint_t * const points,
+        const uint16_t seed, const uint16_t cluster)
+{
+    uint16_t buckets[RADARIQ_CLUSTER_NEIGHBOURS];
+    uint16_t head = 0u;
+    uint16_t tail = 0u;
+
+    memset((void*)&obj->accum[cluster], 0, sizeof(RadarIQClusterAccum_t));
+
+    RadarIQClusterer_assign(obj, points, seed, cluster);
+    obj->queue[tail] = seed;
+    tail++;
+
+    while (head < tail)
+    {
+        const uint16_t idx = obj->queue[head];
+        head++;
+
+        // Only core points extend the cluster, the seed has already been checked
+        if ((idx != seed) && !RadarIQClusterer_isCore(obj, points, idx))
+        {
+            continue;
+        }
+
+        const uint8_t numBuckets = RadarIQClusterer_getBuckets(obj, obj->cellX[idx], obj->cellY[idx],
+                obj->cellZ[idx], buckets);
+
+        for (uint8_t bucket = 0u; bucket < numBuckets; bucket++)
+        {
+            for (uint16_t other = obj->bucketHead[buckets[bucket]]; 0xFFFFu != other; other = obj->next[other])
+            {
+                const uint16_t label = obj->labels[other];
+
+                if (((RADARIQ_CLUSTER_UNVISITED != label) && (RADARIQ_CLUSTER_NOISE != label)) ||
+                        !RadarIQClusterer_isNeighbour(obj, points, idx, other))
+                {
+                    continue;
+                }
+
+                RadarIQClusterer_assign(obj, points, other, cluster);
+
+                // Noise points were already found not to be core so become border points only
+                if (RADARIQ_CLUSTER_UNVISITED == label)
+                {
+                    obj->queue[tail] = other;
+                    tail++;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Finds the unvisited point nearest to the centroid of a previous cluster.
+ *
+ * @param obj The clusterer handle returned from RadarIQClusterer_init()
+ * @param points Pointer to the frame points
+ * @param previous Pointer to the cluster from the previous frame
+ *
+ * @return Index of the nearest point within epsilon, or RADARIQ_CLUSTER_UNVISITED if none was found
+ */
+static uint16_t RadarIQClusterer_findSeed(const RadarIQClustererHandle_t obj, const RadarIQDataPoint_t * const points,
+        const RadarIQCluster_t * const previous)
+{
+    uint16_t buckets[RADARIQ_CLUSTER_NEIGHBOURS];
+    const uint8_t numBuckets = RadarIQClusterer_getBuckets(obj,
+            RadarIQClusterer_getCell(previous->x, obj->config.epsilon),
+            RadarIQClusterer_getCell(previous->y, obj->config.epsilon),
+            RadarIQClusterer_getCell(previous->z, obj->config.epsilon), buckets);
+    uint16_t seed = RADARIQ_CLUSTER_UNVISITED;
+    int64_t seedDistance = obj->epsilonSquared;
+
+    for (uint8_t bucket = 0u; bucket < numBuckets; bucket++)
+    {
+        for (uint16_t idx = obj->bucketHead[buckets[bucket]]; 0xFFFFu != idx; idx = obj->next[idx])
+        {
+            if (RADARIQ_CLUSTER_UNVISITED != obj->labels[idx])
+            {
+                continue;
+            }
+
+            const int64_t dx = (int64_t)points[idx].x - (int64_t)previous->x;
+            const int64_t dy = (int64_t)points[idx].y - (int64_t)previous->y;
+            const int64_t dz = (int64_t)points[idx].z - (int64_t)previous->z;
+            const int64_t distance = (dx * dx) + (dy * dy) + (dz * dz);
+
+            if (distance <= seedDistance)
+            {
+                seedDistance = distance;
+                seed = idx;
+            }
+        }
+    }
+
+    return seed;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file
+ * RadarIQ SDK - Point-cloud clustering.
+ * Grid-accelerated DBSCAN-style clustering of point-cloud frames with optional velocity dimension
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+#ifndef SRC_RADARIQCLUSTER_H_
+#define SRC_RADARIQCLUSTER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQ.h"
+
+//===============================================================================================//
+// DEFINITIONS
+//===============================================================================================//
+
+#define RADARIQ_CLUSTER_NOISE              0xFFFFu   ///< Point label used for points not belonging to any cluster
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Clustering configuration
+ */
+typedef struct
+{
+    uint16_t maxPoints;              ///< Maximum number of points accepted per frame, sets the memory footprint
+    uint16_t maxClusters;            ///< Maximum number of clusters reported per frame
+    uint16_t epsilon;                ///< Neighbourhood radius in millimeters
+    uint16_t minPoints;              ///< Minimum number of neighbours (including the point itself) for a core point
+    uint16_t velocityWeight;         ///< Millimeters of distance per millimeter/second of velocity difference in Q8, 0 to ignore velocity
+} RadarIQClusterConfig_t;
+
+/**
+ * Cluster descriptor
+ */
+typedef struct
+{
+    uint16_t id;                     ///< Cluster ID, carried over from the previous frame where the cluster persists
+    uint16_t numPoints;              ///< Number of points in the cluster
+    int16_t x;                       ///< Centroid x-coordinate in millimeters
+    int16_t y;                       ///< Centroid y-coordinate in millimeters
+    int16_t z;                       ///< Centroid z-coordinate in millimeters
+    uint16_t xExtent;                ///< Bounding box size along x in millimeters
+    uint16_t yExtent;                ///< Bounding box size along y in millimeters
+    uint16_t zExtent;                ///< Bounding box size along z in millimeters
+    int16_t velocity;                ///< Mean velocity of the cluster points in millimeters/second
+} RadarIQCluster_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+typedef struct RadarIQClusterer_t RadarIQClusterer_t;
+typedef RadarIQClusterer_t* RadarIQClustererHandle_t;
+
+//===============================================================================================//
+// FUNCTIONS
+//===============================================================================================//
+
+RadarIQClustererHandle_t RadarIQClusterer_init(const RadarIQClusterConfig_t * const config);
+void RadarIQClusterer_destroy(const RadarIQClustererHandle_t obj);
+void RadarIQClusterer_reset(const RadarIQClustererHandle_t obj);
+uint16_t RadarIQClusterer_process(const RadarIQClustererHandle_t obj, const RadarIQDataPoint_t * const points,
+        const uint16_t numPoints, RadarIQCluster_t * const clusters);
+const uint16_t * RadarIQClusterer_getLabels(const RadarIQClustererHandle_t obj);
+uint32_t RadarIQClusterer_getMemoryUsage(const RadarIQClusterConfig_t * const config);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_RADARIQCLUSTER_H_ */
@@ -0,0 +1,440 @@
+/**
+ * @file
+ * RadarIQ SDK - Adaptive frame rate and sensitivity controller.
+ * Each processing statistics report is judged against the most recent point-cloud statistics. Overload lowers the
+ * frame rate multiplicatively or the sensitivity by one level, quiet periods raise them by one step at a time.
+ * A step up that is undone soon after doubles the wait before the next one, so settings don't oscillate.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQController.h"
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+/**
+ * The RadarIQ controller object definition
+ */
+struct RadarIQController_t
+{
+    RadarIQControllerConfig_t config;
+    uint8_t frameRate;               ///< Frame rate decided
+    uint8_t sensitivity;             ///< Sensitivity decided
+    bool isFrameRatePending;         ///< The decided frame rate has not been acknowledged by the device
+    bool isSensitivityPending;       ///< The decided sensitivity has not been acknowledged by the device
+    bool isTruncated;                ///< Truncation reported since the last processing statistics
+    uint16_t maxPoints;              ///< Most points transmitted since the last processing statistics
+    uint8_t overloaded;              ///< Consecutive overloaded reports
+    uint16_t quiet;                  ///< Consecutive quiet reports
+    uint8_t settle;                  ///< Reports left to ignore
+    uint8_t backoff;                 ///< Number of times the recovery wait has doubled
+    uint16_t sinceStepUp;            ///< Reports since the last step up, saturating
+};
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTION PROTOTYPES
+//===============================================================================================//
+
+static uint8_t RadarIQController_getOverload(const RadarIQControllerHandle_t obj,
+        const RadarIQProcessingStats_t * const stats);
+static bool RadarIQController_isQuiet(const RadarIQControllerHandle_t obj, const RadarIQProcessingStats_t * const stats);
+static bool RadarIQController_stepDown(const RadarIQControllerHandle_t obj, const uint8_t reasons);
+static bool RadarIQController_stepUp(const RadarIQControllerHandle_t obj);
+static void RadarIQController_emit(const RadarIQControllerHandle_t obj, const RadarIQControllerEvent_t event,
+        const uint8_t reasons);
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Allocates and initializes a controller instance using heap allocation.
+ *
+ * @param config Pointer to the controller configuration
+ *
+ * @return A handle for an instance of the RadarIQController_t object
+ */
+RadarIQControllerHandle_t RadarIQController_init(const RadarIQControllerConfig_t * const config)
+{
+    RADARIQ_ASSERT(NULL != config);
+    RADARIQ_ASSERT(RADARIQ_MIN_FRAME_RATE <= config->minFrameRate);
+    RADARIQ_ASSERT(config->minFrameRate <= config->maxFrameRate);
+    RADARIQ_ASSERT(RADARIQ_MAX_FRAME_RATE >= config->maxFrameRate);
+    RADARIQ_ASSERT(config->minSensitivity <= config->maxSensitivity);
+    RADARIQ_ASSERT(RADARIQ_MAX_SENSITIVITY >= config->maxSensitivity);
+    RADARIQ_ASSERT(100u > config->headroomPercent);
+    RADARIQ_ASSERT(0u < config->decreaseAfter);
+    RADARIQ_ASSERT(0u < config->increaseAfter);
+
+    RadarIQControllerHandle_t handle = malloc(sizeof(RadarIQController_t));
+    RADARIQ_ASSERT(NULL != handle);
+    memset((void*)handle, 0, sizeof(RadarIQController_t));
+
+    handle->config = *config;
+
+    // Settings outside the limits are brought inside them on the first apply
+    handle->frameRate = config->frameRate;
+    if (config->minFrameRate > handle->frameRate)
+    {
+        handle->frameRate = config->minFrameRate;
+    }
+    if (config->maxFrameRate < handle->frameRate)
+    {
+        handle->frameRate = config->maxFrameRate;
+    }
+    handle->isFrameRatePending = (handle->frameRate != config->frameRate);
+
+    handle->sensitivity = config->sensitivity;
+    if (config->minSensitivity > handle->sensitivity)
+    {
+        handle->sensitivity = config->minSensitivity;
+    }
+    if (config->maxSensitivity < handle->sensitivity)
+    {
+        handle->sensitivity = config->maxSensitivity;
+    }
+    handle->isSensitivityPending = (handle->sensitivity != config->sensitivity);
+
+    handle->sinceStepUp = UINT16_MAX;
+
+    return handle;
+}
+
+/**
+ * Frees a controller instance created by RadarIQController_init().
+ *
+ * @param obj The controller handle returned from RadarIQController_init()
+ */
+void RadarIQController_destroy(const RadarIQControllerHandle_t obj)
+{
+    free(obj);
+}
+
+/**
+ * Feeds the controller the packet just parsed by the radar. Point-cloud statistics are accumulated, each
+ * processing statistics report is judged and may change the settings.
+ *
+ * @param obj The controller handle returned from RadarIQController_init()
+ * @param radar The RadarIQ object handle that parsed the packet
+ * @param command The command returned by RadarIQ_readSerial() or RadarIQ_processByte()
+ *
+ * @return True if the settings changed and RadarIQController_apply() should be called
+ */
+bool RadarIQController_process(const RadarIQControllerHandle_t obj, const RadarIQHandle_t radar,
+        const RadarIQCommand_t command)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != radar);
+
+    if (RADARIQ_CMD_POINTCLOUD_STATS == command)
+    {
+        RadarIQPointcloudStats_t pointcloud;
+        RadarIQ_getPointCloudStats(radar, &pointcloud);
+
+        obj->isTruncated = obj->isTruncated || pointcloud.inputPointsTruncated || pointcloud.outputPointsTruncated;
+        if (pointcloud.numPointsTransmitted > obj->maxPoints)
+        {
+            obj->maxPoints = (UINT16_MAX < pointcloud.numPointsTransmitted) ? UINT16_MAX :
+                    (uint16_t)pointcloud.numPointsTransmitted;
+        }
+
+        return false;
+    }
+
+    if (RADARIQ_CMD_PROC_STATS != command)
+    {
+        return false;
+    }
+
+    RadarIQProcessingStats_t processing;
+    RadarIQ_getProcessingStats(radar, &processing);
+
+    const uint8_t reasons = RadarIQController_getOverload(obj, &processing);
+    const bool isQuiet = (0u == reasons) && RadarIQController_isQuiet(obj, &processing);
+    bool isChanged = false;
+
+    obj->isTruncated = false;
+    obj->maxPoints = 0u;
+    if (UINT16_MAX > obj->sinceStepUp)
+    {
+        obj->sinceStepUp++;
+    }
+
+    if (0u < obj->settle)
+    {
+        obj->settle--;
+        return false;
+    }
+
+    if (0u != reasons)
+    {
+        obj->quiet = 0u;
+        obj->overloaded++;
+
+        if (obj->overloaded >= obj->config.decreaseAfter)
+        {
+            obj->overloaded = 0u;
+
+            // A step up undone before it proved itself makes the next one wait longer
+            if ((obj->sinceStepUp <= obj->config.increaseAfter) && (RADARIQ_CONTROLLER_MAX_BACKOFF > obj->backoff))
+            {
+                obj->backoff++;
+            }
+            obj->sinceStepUp = UINT16_MAX;
+
+            isChanged = RadarIQController_stepDown(obj, reasons);
+        }
+    }
+    else if (isQuiet)
+    {
+        obj->overloaded = 0u;
+        obj->quiet++;
+
+        if ((obj->sinceStepUp > obj->config.increaseAfter) && (UINT16_MAX != obj->sinceStepUp))
+        {
+            // The last step up held, forget earlier oscillation
+            obj->backoff = 0u;
+        }
+
+        if (obj->quiet >= ((uint16_t)obj->config.increaseAfter << obj->backoff))
+        {
+            obj->quiet = 0u;
+            isChanged = RadarIQController_stepUp(obj);
+        }
+    }
+    else
+    {
+        // Between the limits and the headroom, hold
+        obj->overloaded = 0u;
+        obj->quiet = 0u;
+    }
+
+    if (isChanged)
+    {
+        obj->settle = obj->config.settleReports;
+    }
+
+    return isChanged;
+}
+
+/**
+ * Sends settings the device has not yet acknowledged with RadarIQ_setFrameRate() and RadarIQ_setSensitivity().
+ * Blocks until each response arrives, so must be called from the thread that reads the serial port.
+ * Applications driving the device asynchronously can instead send the settings from the event handler.
+ *
+ * @param obj The controller handle returned from RadarIQController_init()
+ * @param radar The RadarIQ object handle to send the settings to
+ *
+ * @return RADARIQ_RETURN_VAL_ERR if a setting was not acknowledged, otherwise RADARIQ_RETURN_VAL_OK
+ */
+RadarIQReturnVal_t RadarIQController_apply(const RadarIQControllerHandle_t obj, const RadarIQHandle_t radar)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != radar);
+
+    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
+
+    if (obj->isFrameRatePending)
+    {
+        if (RADARIQ_RETURN_VAL_ERR == RadarIQ_setFrameRate(radar, obj->frameRate))
+        {
+            RadarIQController_emit(obj, RADARIQ_CONTROLLER_EVENT_APPLY_FAILED, 0u);
+            ret = RADARIQ_RETURN_VAL_ERR;
+        }
+        else
+        {
+            obj->isFrameRatePending = false;
+        }
+    }
+
+    if (obj->isSensitivityPending)
+    {
+        if (RADARIQ_RETURN_VAL_ERR == RadarIQ_setSensitivity(radar, obj->sensitivity))
+        {
+            RadarIQController_emit(obj, RADARIQ_CONTROLLER_EVENT_APPLY_FAILED, 0u);
+            ret = RADARIQ_RETURN_VAL_ERR;
+        }
+        else
+        {
+            obj->isSensitivityPending = false;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * Gets the settings the controller has decided on.
+ *
+ * @param obj The controller handle returned from RadarIQController_init()
+ * @param frameRate Pointer to write the frame rate to
+ * @param sensitivity Pointer to write the sensitivity to
+ */
+void RadarIQController_getSettings(const RadarIQControllerHandle_t obj, uint8_t * const frameRate,
+        uint8_t * const sensitivity)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != frameRate);
+    RADARIQ_ASSERT(NULL != sensitivity);
+
+    *frameRate = obj->frameRate;
+    *sensitivity = obj->sensitivity;
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Works out whether the device is overloaded.
+ *
+ * @param obj The controller handle returned from RadarIQController_init()
+ * @param stats The processing statistics report
+ *
+ * @return The RADARIQ_CONTROLLER_REASON_ bits of each limit exceeded, 0 if none
+ */
+static uint8_t RadarIQController_getOverload(const RadarIQControllerHandle_t obj,
+        const RadarIQProcessingStats_t * const stats)
+{
+    uint8_t reasons = 0u;
+
+    if (obj->isTruncated)
+    {
+        reasons |= RADARIQ_CONTROLLER_REASON_TRUNCATED;
+    }
+    if ((0u < obj->config.pointCap) && (obj->maxPoints >= obj->config.pointCap))
+    {
+        reasons |= RADARIQ_CONTROLLER_REASON_POINTS;
+    }
+    if (stats->activeFrameCPULoad > obj->config.maxCpuLoad)
+    {
+        reasons |= RADARIQ_CONTROLLER_REASON_CPU_LOAD;
+    }
+    if (stats->interFrameProcMargin < obj->config.minProcMarginMicros)
+    {
+        reasons |= RADARIQ_CONTROLLER_REASON_PROC_MARGIN;
+    }
+
+    return reasons;
+}
+
+/**
+ * Works out whether every statistic is far enough inside its limit to allow a step up.
+ *
+ * @param obj The controller handle returned from RadarIQController_init()
+ * @param stats The processing statistics report
+ *
+ * @return True if the points, CPU load and margin all have the configured headroom
+ */
+static bool RadarIQController_isQuiet(const RadarIQControllerHandle_t obj, const RadarIQProcessingStats_t * const stats)
+{
+    const uint32_t headroom = obj->config.headroomPercent;
+    const uint32_t pointLimit = ((uint32_t)obj->config.pointCap * (100u - headroom)) / 100u;
+    const uint32_t cpuLimit = (obj->config.maxCpuLoad > headroom) ? (obj->config.maxCpuLoad - headroom) : 0u;
+    const uint32_t marginFloor = (uint32_t)(((uint64_t)obj->config.minProcMarginMicros * (100u + headroom)) / 100u);
+
+    return ((0u == obj->config.pointCap) || (obj->maxPoints <= pointLimit)) &&
+           (stats->activeFrameCPULoad <= cpuLimit) &&
+           (stats->interFrameProcMargin >= marginFloor);
+}
+
+/**
+ * Lowers one setting to relieve an overload. Too many points are relieved by the sensitivity, processing
+ * time by the frame rate, and either falls back to the other setting once its own is at the minimum.
+ *
+ * @param obj The controller handle returned from RadarIQController_init()
+ * @param reasons The RADARIQ_CONTROLLER_REASON_ bits of the overload
+ *
+ * @return True if a setting changed
+ */
+static bool RadarIQController_stepDown(const RadarIQControllerHandle_t obj, const uint8_t reasons)
+{
+    const bool isPoints = (0u != (reasons & (RADARIQ_CONTROLLER_REASON_TRUNCATED | RADARIQ_CONTROLLER_REASON_POINTS)));
+    const bool canLowerSensitivity = (obj->sensitivity > obj->config.minSensitivity);
+    const bool canLowerFrameRate = (obj->frameRate > obj->config.minFrameRate);
+
+    if (canLowerSensitivity && (isPoints || !canLowerFrameRate))
+    {
+        obj->sensitivity--;
+        obj->isSensitivityPending = true;
+        RadarIQController_emit(obj, RADARIQ_CONTROLLER_EVENT_SENSITIVITY_DOWN, reasons);
+        return true;
+    }
+
+    if (canLowerFrameRate)
+    {
+        // Multiplicative decrease, recovery is one frame/second at a time
+        uint8_t step = obj->frameRate / 4u;
+        if (0u == step)
+        {
+            step = 1u;
+        }
+
+        obj->frameRate = ((obj->frameRate - obj->config.minFrameRate) > step) ? (uint8_t)(obj->frameRate - step) :
+                obj->config.minFrameRate;
+        obj->isFrameRatePending = true;
+        RadarIQController_emit(obj, RADARIQ_CONTROLLER_EVENT_FRAME_RATE_DOWN, reasons);
+        return true;
+    }
+
+    RadarIQController_emit(obj, RADARIQ_CONTROLLER_EVENT_AT_LIMIT, reasons);
+
+    return false;
+}
+
+/**
+ * Raises one setting towards its maximum, the frame rate first.
+ *
+ * @param obj The controller handle returned from RadarIQController_init()
+ *
+ * @return True if a setting changed
+ */
+static bool RadarIQController_stepUp(const RadarIQControllerHandle_t obj)
+{
+    if (obj->frameRate < obj->config.maxFrameRate)
+    {
+        obj->frameRate++;
+        obj->isFrameRatePending = true;
+        RadarIQController_emit(obj, RADARIQ_CONTROLLER_EVENT_FRAME_RATE_UP, RADARIQ_CONTROLLER_REASON_RECOVERED);
+    }
+    else if (obj->sensitivity < obj->config.maxSensitivity)
+    {
+        obj->sensitivity++;
+        obj->isSensitivityPending = true;
+        RadarIQController_emit(obj, RADARIQ_CONTROLLER_EVENT_SENSITIVITY_UP, RADARIQ_CONTROLLER_REASON_RECOVERED);
+    }
+    else
+    {
+        return false;
+    }
+
+    obj->sinceStepUp = 0u;
+
+    return true;
+}
+
+/**
+ * Passes a decision to the event handler.
+ *
+ * @param obj The controller handle returned from RadarIQController_init()
+ * @param event The decision
+ * @param reasons The RADARIQ_CONTROLLER_REASON_ bits behind it
+ */
+static void RadarIQController_emit(const RadarIQControllerHandle_t obj, const RadarIQControllerEvent_t event,
+        const uint8_t reasons)
+{
+    if (NULL != obj->config.handler)
+    {
+        const RadarIQControllerDecision_t decision = { event, reasons, obj->frameRate, obj->sensitivity };
+        obj->config.handler(obj->config.context, &decision);
+    }
+}
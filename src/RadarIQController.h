@@ -0,0 +1,121 @@
+/**
+ * @file
+ * RadarIQ SDK - Adaptive frame rate and sensitivity controller.
+ * Watches the device's point-cloud and processing statistics and steps the frame rate and sensitivity down when
+ * frames are truncated or the device runs out of processing time, and back up once the scene has been quiet for
+ * a while. Changes stay within user limits and are reported as events.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+#ifndef SRC_RADARIQCONTROLLER_H_
+#define SRC_RADARIQCONTROLLER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQ.h"
+
+//===============================================================================================//
+// DEFINITIONS
+//===============================================================================================//
+
+/* Reasons for a decision, combined in RadarIQControllerDecision_t::reasons */
+#define RADARIQ_CONTROLLER_REASON_TRUNCATED    0x01u     ///< The device truncated the points it aggregated or transmitted
+#define RADARIQ_CONTROLLER_REASON_POINTS       0x02u     ///< Frames were at the point cap
+#define RADARIQ_CONTROLLER_REASON_CPU_LOAD     0x04u     ///< Active frame CPU load was over budget
+#define RADARIQ_CONTROLLER_REASON_PROC_MARGIN  0x08u     ///< Inter-frame processing margin was below its floor
+#define RADARIQ_CONTROLLER_REASON_RECOVERED    0x10u     ///< Every statistic has been within its headroom for long enough
+
+#define RADARIQ_CONTROLLER_MAX_BACKOFF     4u        ///< Most times the recovery wait doubles after a step up is undone
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Controller events
+ */
+typedef enum
+{
+    RADARIQ_CONTROLLER_EVENT_FRAME_RATE_DOWN = 0,       ///< The frame rate was lowered
+    RADARIQ_CONTROLLER_EVENT_FRAME_RATE_UP = 1,         ///< The frame rate was raised towards its maximum
+    RADARIQ_CONTROLLER_EVENT_SENSITIVITY_DOWN = 2,      ///< The sensitivity was lowered
+    RADARIQ_CONTROLLER_EVENT_SENSITIVITY_UP = 3,        ///< The sensitivity was raised towards its maximum
+    RADARIQ_CONTROLLER_EVENT_AT_LIMIT = 4,              ///< The device is overloaded but both settings are at their minimums
+    RADARIQ_CONTROLLER_EVENT_APPLY_FAILED = 5           ///< The device did not acknowledge a setting, it is retried on the next apply
+} RadarIQControllerEvent_t;
+
+/**
+ * A decision and the settings after it
+ */
+typedef struct
+{
+    RadarIQControllerEvent_t event;  ///< What was decided
+    uint8_t reasons;                 ///< RADARIQ_CONTROLLER_REASON_ bits behind the decision
+    uint8_t frameRate;               ///< Frame rate after the decision in frames/second
+    uint8_t sensitivity;             ///< Sensitivity after the decision
+} RadarIQControllerDecision_t;
+
+/**
+ * Event handler, called from RadarIQController_process() and RadarIQController_apply()
+ *
+ * @param context The context pointer from the controller configuration
+ * @param decision The decision
+ */
+typedef void(*RadarIQControllerHandler_t)(void * const context, const RadarIQControllerDecision_t * const decision);
+
+/**
+ * Controller configuration
+ */
+typedef struct
+{
+    uint8_t minFrameRate;            ///< Lowest frame rate the controller may set
+    uint8_t maxFrameRate;            ///< Highest frame rate the controller may set, also the rate it recovers to
+    uint8_t minSensitivity;          ///< Lowest sensitivity the controller may set
+    uint8_t maxSensitivity;          ///< Highest sensitivity the controller may set, also the level it recovers to
+    uint8_t frameRate;               ///< Frame rate the device is currently set to
+    uint8_t sensitivity;             ///< Sensitivity the device is currently set to
+    uint16_t pointCap;               ///< Points per frame the device can transmit, e.g. its configured point density limit
+    uint8_t maxCpuLoad;              ///< Active frame CPU load budget in percent
+    uint32_t minProcMarginMicros;    ///< Smallest acceptable inter-frame processing margin in microseconds
+    uint8_t headroomPercent;         ///< Distance below the limits, in percent, statistics must keep before stepping back up
+    uint8_t decreaseAfter;           ///< Consecutive overloaded reports before stepping down
+    uint8_t increaseAfter;           ///< Consecutive quiet reports before stepping up
+    uint8_t settleReports;           ///< Reports ignored after a change while the device settles
+    RadarIQControllerHandler_t handler;             ///< Event handler, or NULL
+    void * context;                  ///< Pointer passed to the event handler
+} RadarIQControllerConfig_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+typedef struct RadarIQController_t RadarIQController_t;
+typedef RadarIQController_t* RadarIQControllerHandle_t;
+
+//===============================================================================================//
+// FUNCTIONS
+//===============================================================================================//
+
+RadarIQControllerHandle_t RadarIQController_init(const RadarIQControllerConfig_t * const config);
+void RadarIQController_destroy(const RadarIQControllerHandle_t obj);
+bool RadarIQController_process(const RadarIQControllerHandle_t obj, const RadarIQHandle_t radar,
+        const RadarIQCommand_t command);
+RadarIQReturnVal_t RadarIQController_apply(const RadarIQControllerHandle_t obj, const RadarIQHandle_t radar);
+void RadarIQController_getSettings(const RadarIQControllerHandle_t obj, uint8_t * const frameRate,
+        uint8_t * const sensitivity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_RADARIQCONTROLLER_H_ */
@@ -0,0 +1,763 @@
+/**
+ * @file
+ * RadarIQ SDK - Local metrics exporter.
+ * Serves per-sensor metrics as Prometheus text or a compact binary snapshot over a Unix domain socket.
+ * Requires a POSIX host with C11 atomics and pthreads.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "RadarIQExporter.h"
+#include <stdatomic.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+
+//===============================================================================================//
+// CONSTANTS
+//===============================================================================================//
+
+#define RADARIQ_EXPORTER_CACHE_LINE        64u       ///< Sensor counters are aligned to a cache line so sensors don't false-share
+#define RADARIQ_EXPORTER_POLL_MILLIS       200       ///< Longest time the server thread takes to notice a stop request
+#define RADARIQ_EXPORTER_TEXT_SENSOR_SIZE  2048u     ///< Upper bound of the Prometheus text of one sensor in bytes
+#define RADARIQ_EXPORTER_TEXT_HEADER_SIZE  2048u     ///< Upper bound of the Prometheus HELP and TYPE lines in bytes
+#define RADARIQ_EXPORTER_FRAME_EMA_SHIFT   3u        ///< Frame interval moving average weights each new interval by 1/8
+
+/**
+ * Label values of the exported chip temperatures, in RadarIQChipTemperatures_t order
+ */
+static const char * const RadarIQExporter_temperatureNames[RADARIQ_EXPORTER_NUM_TEMPERATURES] =
+{
+    "sensor0", "sensor1", "power_management", "rx0", "rx1", "rx2", "rx3", "tx0", "tx1", "tx2"
+};
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Lock-free counters of one sensor.
+ * Only the sensor's ingest thread writes the counters, so increments are a relaxed load and store rather than
+ * a locked read-modify-write. The server thread only ever reads them.
+ */
+typedef struct
+{
+    _Alignas(RADARIQ_EXPORTER_CACHE_LINE) atomic_uint_least64_t frames;
+    atomic_uint_least64_t packets;
+    atomic_uint_least64_t packetErrors;
+    atomic_uint_least64_t unknownPackets;
+    atomic_uint_least64_t truncatedFrames;
+    atomic_uint_least64_t parseCount;
+    atomic_uint_least64_t parseSumMicros;
+    atomic_uint_least32_t parseMaxMicros;
+    atomic_uint_least32_t frameIntervalMicros;      ///< Moving average of the time between frames
+    atomic_int_least32_t activeFrameCPULoad;
+    atomic_int_least32_t interFrameCPULoad;
+    atomic_int_least32_t temperatures[RADARIQ_EXPORTER_NUM_TEMPERATURES];
+    uint32_t lastFrameMicros;        ///< Ingest thread only
+    bool isFrameSeen;                ///< Ingest thread only
+    char name[RADARIQ_EXPORTER_NAME_LEN];
+} RadarIQExporterSensor_t;
+
+/**
+ * Plain copy of one sensor's counters taken for a snapshot
+ */
+typedef struct
+{
+    uint64_t frames;
+    uint64_t packets;
+    uint64_t packetErrors;
+    uint64_t unknownPackets;
+    uint64_t truncatedFrames;
+    uint64_t parseCount;
+    uint64_t parseSumMicros;
+    uint32_t parseMaxMicros;
+    uint32_t frameRate;              ///< Millihertz
+    int32_t activeFrameCPULoad;
+    int32_t interFrameCPULoad;
+    int16_t temperatures[RADARIQ_EXPORTER_NUM_TEMPERATURES];
+} RadarIQExporterValues_t;
+
+/**
+ * Bounded output buffer for building a snapshot
+ */
+typedef struct
+{
+    uint8_t * data;
+    uint32_t len;
+    uint32_t maxLen;
+    bool isOverflowed;
+} RadarIQExporterBuffer_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+/**
+ * The RadarIQ exporter object definition
+ */
+struct RadarIQExporter_t
+{
+    RadarIQExporterConfig_t config;
+    RadarIQExporterSensor_t * sensors;
+    uint8_t * buffer;                ///< Snapshot buffer used by the server thread
+    uint32_t bufferSize;
+    int listenFd;
+    pthread_t thread;
+    atomic_bool isRunning;
+};
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTION PROTOTYPES
+//===============================================================================================//
+
+static void * RadarIQExporter_serve(void * arg);
+static void RadarIQExporter_add(atomic_uint_least64_t * const counter, const uint64_t value);
+static void RadarIQExporter_readValues(const RadarIQExporterSensor_t * const sensor, RadarIQExporterValues_t * const dest);
+static void RadarIQExporter_writeText(const RadarIQExporterHandle_t obj, const RadarIQExporterValues_t * const values,
+        RadarIQExporterBuffer_t * const buffer);
+static void RadarIQExporter_writeBinary(const RadarIQExporterHandle_t obj, const RadarIQExporterValues_t * const values,
+        RadarIQExporterBuffer_t * const buffer);
+static void RadarIQExporter_printf(RadarIQExporterBuffer_t * const buffer, const char * const format, ...);
+static void RadarIQExporter_putBytes(RadarIQExporterBuffer_t * const buffer, const void * const data, const uint32_t len);
+static void RadarIQExporter_putLE(RadarIQExporterBuffer_t * const buffer, const uint64_t value, const uint8_t len);
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Allocates and initializes an exporter instance using heap allocation. Sensors are named "sensor<index>".
+ * The server is not started until RadarIQExporter_start() is called.
+ *
+ * @param config Pointer to the exporter configuration
+ *
+ * @return A handle for an instance of the RadarIQExporter_t object
+ */
+RadarIQExporterHandle_t RadarIQExporter_init(const RadarIQExporterConfig_t * const config)
+{
+    RADARIQ_ASSERT(NULL != config);
+    RADARIQ_ASSERT(NULL != config->socketPath);
+    RADARIQ_ASSERT(0u < config->maxSensors);
+
+    RadarIQExporterHandle_t handle = malloc(sizeof(RadarIQExporter_t));
+    RADARIQ_ASSERT(NULL != handle);
+    memset((void*)handle, 0, sizeof(RadarIQExporter_t));
+
+    handle->config = *config;
+    handle->listenFd = -1;
+    atomic_init(&handle->isRunning, false);
+
+    const size_t sensorsSize = sizeof(RadarIQExporterSensor_t) * config->maxSensors;
+    handle->sensors = aligned_alloc(RADARIQ_EXPORTER_CACHE_LINE, sensorsSize);
+    RADARIQ_ASSERT(NULL != handle->sensors);
+    memset((void*)handle->sensors, 0, sensorsSize);
+
+    for (uint8_t sensor = 0u; sensor < config->maxSensors; sensor++)
+    {
+        snprintf(handle->sensors[sensor].name, RADARIQ_EXPORTER_NAME_LEN, "sensor%u", (unsigned int)sensor);
+    }
+
+    handle->bufferSize = RadarIQExporter_getSnapshotSize(handle);
+    handle->buffer = malloc(handle->bufferSize);
+    RADARIQ_ASSERT(NULL != handle->buffer);
+
+    return handle;
+}
+
+/**
+ * Stops the server if it is running and frees an exporter instance created by RadarIQExporter_init().
+ *
+ * @param obj The exporter handle returned from RadarIQExporter_init()
+ */
+void RadarIQExporter_destroy(const RadarIQExporterHandle_t obj)
+{
+    if (NULL != obj)
+    {
+        RadarIQExporter_stop(obj);
+        free(obj->sensors);
+        free(obj->buffer);
+        free(obj);
+    }
+}
+
+/**
+ * Sets the name a sensor is exported with. Must be called before RadarIQExporter_start().
+ * Names should only contain characters valid in a Prometheus label value without escaping.
+ *
+ * @param obj The exporter handle returned from RadarIQExporter_init()
+ * @param sensor The sensor index
+ * @param name The name, truncated to ::RADARIQ_EXPORTER_NAME_LEN - 1 characters
+ *
+ * @return RADARIQ_RETURN_VAL_ERR if the sensor index is out of range or the server is running,
+ *         otherwise RADARIQ_RETURN_VAL_OK
+ */
+RadarIQReturnVal_t RadarIQExporter_setSensorName(const RadarIQExporterHandle_t obj, const uint8_t sensor,
+        const char * const name)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != name);
+
+    if ((sensor >= obj->config.maxSensors) || atomic_load(&obj->isRunning))
+    {
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    strncpy(obj->sensors[sensor].name, name, RADARIQ_EXPORTER_NAME_LEN - 1u);
+    obj->sensors[sensor].name[RADARIQ_EXPORTER_NAME_LEN - 1u] = '\0';
+
+    return RADARIQ_RETURN_VAL_OK;
+}
+
+/**
+ * Creates the Unix domain socket and starts the server thread.
+ * Each client that connects is sent one snapshot in the configured format, then the connection is closed.
+ *
+ * @param obj The exporter handle returned from RadarIQExporter_init()
+ *
+ * @return RADARIQ_RETURN_VAL_ERR if the socket or thread could not be created, otherwise RADARIQ_RETURN_VAL_OK
+ */
+RadarIQReturnVal_t RadarIQExporter_start(const RadarIQExporterHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    if (atomic_load(&obj->isRunning))
+    {
+        return RADARIQ_RETURN_VAL_OK;
+    }
+
+    struct sockaddr_un address;
+    memset((void*)&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (strlen(obj->config.socketPath) >= sizeof(address.sun_path))
+    {
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+    strcpy(address.sun_path, obj->config.socketPath);
+
+    obj->listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (0 > obj->listenFd)
+    {
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    unlink(obj->config.socketPath);
+
+    if ((0 != bind(obj->listenFd, (struct sockaddr*)&address, sizeof(address))) || (0 != listen(obj->listenFd, 8)))
+    {
+        close(obj->listenFd);
+        obj->listenFd = -1;
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    atomic_store(&obj->isRunning, true);
+
+    if (0 != pthread_create(&obj->thread, NULL, RadarIQExporter_serve, obj))
+    {
+        atomic_store(&obj->isRunning, false);
+        close(obj->listenFd);
+        obj->listenFd = -1;
+        unlink(obj->config.socketPath);
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    return RADARIQ_RETURN_VAL_OK;
+}
+
+/**
+ * Stops the server thread and removes the Unix domain socket. Counters are kept.
+ *
+ * @param obj The exporter handle returned from RadarIQExporter_init()
+ */
+void RadarIQExporter_stop(const RadarIQExporterHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    if (!atomic_exchange(&obj->isRunning, false))
+    {
+        return;
+    }
+
+    pthread_join(obj->thread, NULL);
+
+    close(obj->listenFd);
+    obj->listenFd = -1;
+    unlink(obj->config.socketPath);
+}
+
+/**
+ * Records a result of RadarIQ_readSerial(). Call from the sensor's ingest thread after every call.
+ * Processing and point-cloud statistics are read from the RadarIQ handle on the same thread, so no locks are needed.
+ *
+ * @param obj The exporter handle returned from RadarIQExporter_init()
+ * @param sensor The sensor index
+ * @param radar The RadarIQ object handle the packet was read from
+ * @param command The value returned from RadarIQ_readSerial()
+ * @param parseMicros Time spent in the RadarIQ_readSerial() call that completed the packet in microseconds
+ */
+void RadarIQExporter_onPacket(const RadarIQExporterHandle_t obj, const uint8_t sensor, const RadarIQHandle_t radar,
+        const RadarIQCommand_t command, const uint32_t parseMicros)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(sensor < obj->config.maxSensors);
+
+    if (RADARIQ_CMD_NONE == command)
+    {
+        return;
+    }
+
+    RadarIQExporterSensor_t * const counters = &obj->sensors[sensor];
+
+    RadarIQExporter_add(&counters->packets, 1u);
+    RadarIQExporter_add(&counters->parseCount, 1u);
+    RadarIQExporter_add(&counters->parseSumMicros, parseMicros);
+    if (parseMicros > atomic_load_explicit(&counters->parseMaxMicros, memory_order_relaxed))
+    {
+        atomic_store_explicit(&counters->parseMaxMicros, parseMicros, memory_order_relaxed);
+    }
+
+    switch (command)
+    {
+    case RADARIQ_CMD_ERROR:
+    {
+        RadarIQExporter_add(&counters->packetErrors, 1u);
+        break;
+    }
+    case RADARIQ_CMD_UNKNOWN:
+    {
+        RadarIQExporter_add(&counters->unknownPackets, 1u);
+        break;
+    }
+    case RADARIQ_CMD_PROC_STATS:
+    {
+        RADARIQ_ASSERT(NULL != radar);
+
+        RadarIQProcessingStats_t processing;
+        RadarIQChipTemperatures_t temperatures;
+        RadarIQ_getProcessingSample(radar, &processing, &temperatures);
+
+        const int16_t values[RADARIQ_EXPORTER_NUM_TEMPERATURES] =
+        {
+            temperatures.sensor0, temperatures.sensor1, temperatures.powerManagement,
+            temperatures.rx0, temperatures.rx1, temperatures.rx2, temperatures.rx3,
+            temperatures.tx0, temperatures.tx1, temperatures.tx2
+        };
+
+        atomic_store_explicit(&counters->activeFrameCPULoad, (int32_t)processing.activeFrameCPULoad, memory_order_relaxed);
+        atomic_store_explicit(&counters->interFrameCPULoad, (int32_t)processing.interFrameCPULoad, memory_order_relaxed);
+        for (uint8_t idx = 0u; idx < RADARIQ_EXPORTER_NUM_TEMPERATURES; idx++)
+        {
+            atomic_store_explicit(&counters->temperatures[idx], values[idx], memory_order_relaxed);
+        }
+        break;
+    }
+    case RADARIQ_CMD_POINTCLOUD_STATS:
+    {
+        RADARIQ_ASSERT(NULL != radar);
+
+        RadarIQPointcloudStats_t pointcloud;
+        RadarIQ_getPointCloudStats(radar, &pointcloud);
+
+        if (pointcloud.inputPointsTruncated || pointcloud.outputPointsTruncated)
+        {
+            RadarIQExporter_add(&counters->truncatedFrames, 1u);
+        }
+        break;
+    }
+    default:
+    {
+        break;
+    }
+    }
+}
+
+/**
+ * Records a complete frame. Call from the sensor's ingest thread when a frame is complete.
+ *
+ * @param obj The exporter handle returned from RadarIQExporter_init()
+ * @param sensor The sensor index
+ * @param timeMicros The time the frame completed in microseconds, used to estimate the frame rate
+ */
+void RadarIQExporter_onFrame(const RadarIQExporterHandle_t obj, const uint8_t sensor, const uint32_t timeMicros)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(sensor < obj->config.maxSensors);
+
+    RadarIQExporterSensor_t * const counters = &obj->sensors[sensor];
+
+    RadarIQExporter_add(&counters->frames, 1u);
+
+    if (counters->isFrameSeen)
+    {
+        const int64_t interval = (int64_t)(uint32_t)(timeMicros - counters->lastFrameMicros);
+        const int64_t average = (int64_t)atomic_load_explicit(&counters->frameIntervalMicros, memory_order_relaxed);
+        const int64_t updated = (0 == average) ? interval :
+                (average + ((interval - average) / (1 << RADARIQ_EXPORTER_FRAME_EMA_SHIFT)));
+
+        atomic_store_explicit(&counters->frameIntervalMicros, (uint32_t)updated, memory_order_relaxed);
+    }
+
+    counters->lastFrameMicros = timeMicros;
+    counters->isFrameSeen = true;
+}
+
+/**
+ * Writes a snapshot of every sensor's metrics in the configured format. Safe to call from any thread.
+ *
+ * @param obj The exporter handle returned from RadarIQExporter_init()
+ * @param dest Buffer to write the snapshot into, the Prometheus text is not null-terminated
+ * @param maxLen Size of the buffer, RadarIQExporter_getSnapshotSize() bytes is always large enough
+ *
+ * @return The length of the snapshot in bytes, or 0 if the buffer was too small
+ */
+uint32_t RadarIQExporter_getSnapshot(const RadarIQExporterHandle_t obj, uint8_t * const dest, const uint32_t maxLen)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != dest);
+
+    RadarIQExporterValues_t * const values = malloc(sizeof(RadarIQExporterValues_t) * obj->config.maxSensors);
+    RADARIQ_ASSERT(NULL != values);
+
+    for (uint8_t sensor = 0u; sensor < obj->config.maxSensors; sensor++)
+    {
+        RadarIQExporter_readValues(&obj->sensors[sensor], &values[sensor]);
+    }
+
+    RadarIQExporterBuffer_t buffer = { dest, 0u, maxLen, false };
+
+    if (RADARIQ_EXPORTER_FORMAT_BINARY == obj->config.format)
+    {
+        RadarIQExporter_writeBinary(obj, values, &buffer);
+    }
+    else
+    {
+        RadarIQExporter_writeText(obj, values, &buffer);
+    }
+
+    free(values);
+
+    return buffer.isOverflowed ? 0u : buffer.len;
+}
+
+/**
+ * Gets the size of buffer always large enough for a snapshot.
+ *
+ * @param obj The exporter handle returned from RadarIQExporter_init()
+ *
+ * @return The size in bytes
+ */
+uint32_t RadarIQExporter_getSnapshotSize(const RadarIQExporterHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    if (RADARIQ_EXPORTER_FORMAT_BINARY == obj->config.format)
+    {
+        return RADARIQ_EXPORTER_BINARY_HEADER_SIZE + (RADARIQ_EXPORTER_BINARY_RECORD_SIZE * obj->config.maxSensors);
+    }
+
+    return RADARIQ_EXPORTER_TEXT_HEADER_SIZE + (RADARIQ_EXPORTER_TEXT_SENSOR_SIZE * obj->config.maxSensors);
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Server thread, writes a snapshot to each client that connects until the exporter is stopped.
+ *
+ * @param arg The exporter handle
+ *
+ * @return NULL
+ */
+static void * RadarIQExporter_serve(void * arg)
+{
+    const RadarIQExporterHandle_t obj = (RadarIQExporterHandle_t)arg;
+    struct pollfd listener = { obj->listenFd, POLLIN, 0 };
+
+    while (atomic_load(&obj->isRunning))
+    {
+        if (0 >= poll(&listener, 1u, RADARIQ_EXPORTER_POLL_MILLIS))
+        {
+            continue;
+        }
+
+        const int client = accept(obj->listenFd, NULL, NULL);
+        if (0 > client)
+        {
+            continue;
+        }
+
+        // Never let a stalled client hold up the server
+        const struct timeval timeout = { 1, 0 };
+        setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+        const uint32_t len = RadarIQExporter_getSnapshot(obj, obj->buffer, obj->bufferSize);
+        uint32_t sent = 0u;
+
+        while (sent < len)
+        {
+            const ssize_t ret = send(client, &obj->buffer[sent], len - sent, MSG_NOSIGNAL);
+            if (0 >= ret)
+            {
+                break;
+            }
+            sent += (uint32_t)ret;
+        }
+
+        close(client);
+    }
+
+    return NULL;
+}
+
+/**
+ * Adds to a counter only ever written by one thread, avoiding a locked read-modify-write.
+ *
+ * @param counter Pointer to the counter
+ * @param value The amount to add
+ */
+static void RadarIQExporter_add(atomic_uint_least64_t * const counter, const uint64_t value)
+{
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + value, memory_order_relaxed);
+}
+
+/**
+ * Copies a sensor's counters for a snapshot.
+ *
+ * @param sensor Pointer to the sensor's counters
+ * @param dest Pointer to the copy
+ */
+static void RadarIQExporter_readValues(const RadarIQExporterSensor_t * const sensor, RadarIQExporterValues_t * const dest)
+{
+    RadarIQExporterSensor_t * const counters = (RadarIQExporterSensor_t*)sensor;
+
+    dest->frames = atomic_load_explicit(&counters->frames, memory_order_relaxed);
+    dest->packets = atomic_load_explicit(&counters->packets, memory_order_relaxed);
+    dest->packetErrors = atomic_load_explicit(&counters->packetErrors, memory_order_relaxed);
+    dest->unknownPackets = atomic_load_explicit(&counters->unknownPackets, memory_order_relaxed);
+    dest->truncatedFrames = atomic_load_explicit(&counters->truncatedFrames, memory_order_relaxed);
+    dest->parseCount = atomic_load_explicit(&counters->parseCount, memory_order_relaxed);
+    dest->parseSumMicros = atomic_load_explicit(&counters->parseSumMicros, memory_order_relaxed);
+    dest->parseMaxMicros = atomic_load_explicit(&counters->parseMaxMicros, memory_order_relaxed);
+    dest->activeFrameCPULoad = atomic_load_explicit(&counters->activeFrameCPULoad, memory_order_relaxed);
+    dest->interFrameCPULoad = atomic_load_explicit(&counters->interFrameCPULoad, memory_order_relaxed);
+
+    const uint32_t interval = atomic_load_explicit(&counters->frameIntervalMicros, memory_order_relaxed);
+    dest->frameRate = (0u == interval) ? 0u : (uint32_t)(1000000000uLL / interval);
+
+    for (uint8_t idx = 0u; idx < RADARIQ_EXPORTER_NUM_TEMPERATURES; idx++)
+    {
+        dest->temperatures[idx] = (int16_t)atomic_load_explicit(&counters->temperatures[idx], memory_order_relaxed);
+    }
+}
+
+/**
+ * Writes a snapshot in the Prometheus text exposition format.
+ *
+ * @param obj The exporter handle returned from RadarIQExporter_init()
+ * @param values The counters of each sensor
+ * @param buffer The output buffer
+ */
+static void RadarIQExporter_writeText(const RadarIQExporterHandle_t obj, const RadarIQExporterValues_t * const values,
+        RadarIQExporterBuffer_t * const buffer)
+{
+    /**
+     * Counter metrics, offsets into RadarIQExporterValues_t
+     */
+    static const struct
+    {
+        const char * name;
+        const char * help;
+        size_t offset;
+    } counters[] =
+    {
+        { "radariq_frames_total", "Complete frames received", offsetof(RadarIQExporterValues_t, frames) },
+        { "radariq_packets_total", "Packets received", offsetof(RadarIQExporterValues_t, packets) },
+        { "radariq_packet_errors_total", "Packets dropped due to CRC or framing errors", offsetof(RadarIQExporterValues_t, packetErrors) },
+        { "radariq_unknown_packets_total", "Packets dropped with an unknown command", offsetof(RadarIQExporterValues_t, unknownPackets) },
+        { "radariq_truncated_frames_total", "Frames with points dropped by the device", offsetof(RadarIQExporterValues_t, truncatedFrames) }
+    };
+    const uint8_t numSensors = obj->config.maxSensors;
+
+    for (uint8_t idx = 0u; idx < (sizeof(counters) / sizeof(counters[0])); idx++)
+    {
+        RadarIQExporter_printf(buffer, "# HELP %s %s\n# TYPE %s counter\n", counters[idx].name, counters[idx].help,
+                counters[idx].name);
+        for (uint8_t sensor = 0u; sensor < numSensors; sensor++)
+        {
+            const uint64_t value = *(const uint64_t*)((const uint8_t*)&values[sensor] + counters[idx].offset);
+            RadarIQExporter_printf(buffer, "%s{sensor=\"%s\"} %llu\n", counters[idx].name, obj->sensors[sensor].name,
+                    (unsigned long long)value);
+        }
+    }
+
+    RadarIQExporter_printf(buffer, "# HELP radariq_parse_latency_microseconds Time to read and parse a packet\n"
+            "# TYPE radariq_parse_latency_microseconds summary\n");
+    for (uint8_t sensor = 0u; sensor < numSensors; sensor++)
+    {
+        RadarIQExporter_printf(buffer, "radariq_parse_latency_microseconds_sum{sensor=\"%s\"} %llu\n"
+                "radariq_parse_latency_microseconds_count{sensor=\"%s\"} %llu\n",
+                obj->sensors[sensor].name, (unsigned long long)values[sensor].parseSumMicros,
+                obj->sensors[sensor].name, (unsigned long long)values[sensor].parseCount);
+    }
+
+    RadarIQExporter_printf(buffer, "# HELP radariq_parse_latency_max_microseconds Longest time to read and parse a packet\n"
+            "# TYPE radariq_parse_latency_max_microseconds gauge\n");
+    for (uint8_t sensor = 0u; sensor < numSensors; sensor++)
+    {
+        RadarIQExporter_printf(buffer, "radariq_parse_latency_max_microseconds{sensor=\"%s\"} %lu\n",
+                obj->sensors[sensor].name, (unsigned long)values[sensor].parseMaxMicros);
+    }
+
+    RadarIQExporter_printf(buffer, "# HELP radariq_frame_rate_hertz Moving average of the received frame rate\n"
+            "# TYPE radariq_frame_rate_hertz gauge\n");
+    for (uint8_t sensor = 0u; sensor < numSensors; sensor++)
+    {
+        RadarIQExporter_printf(buffer, "radariq_frame_rate_hertz{sensor=\"%s\"} %lu.%03lu\n", obj->sensors[sensor].name,
+                (unsigned long)(values[sensor].frameRate / 1000u), (unsigned long)(values[sensor].frameRate % 1000u));
+    }
+
+    RadarIQExporter_printf(buffer, "# HELP radariq_cpu_load_percent Device CPU load\n"
+            "# TYPE radariq_cpu_load_percent gauge\n");
+    for (uint8_t sensor = 0u; sensor < numSensors; sensor++)
+    {
+        RadarIQExporter_printf(buffer, "radariq_cpu_load_percent{sensor=\"%s\",phase=\"active_frame\"} %ld\n"
+                "radariq_cpu_load_percent{sensor=\"%s\",phase=\"inter_frame\"} %ld\n",
+                obj->sensors[sensor].name, (long)values[sensor].activeFrameCPULoad,
+                obj->sensors[sensor].name, (long)values[sensor].interFrameCPULoad);
+    }
+
+    RadarIQExporter_printf(buffer, "# HELP radariq_temperature_celsius Device chip temperature\n"
+            "# TYPE radariq_temperature_celsius gauge\n");
+    for (uint8_t sensor = 0u; sensor < numSensors; sensor++)
+    {
+        for (uint8_t idx = 0u; idx < RADARIQ_EXPORTER_NUM_TEMPERATURES; idx++)
+        {
+            RadarIQExporter_printf(buffer, "radariq_temperature_celsius{sensor=\"%s\",location=\"%s\"} %d\n",
+                    obj->sensors[sensor].name, RadarIQExporter_temperatureNames[idx], (int)values[sensor].temperatures[idx]);
+        }
+    }
+}
+
+/**
+ * Writes a snapshot in the binary format, see ::RADARIQ_EXPORTER_BINARY_RECORD_SIZE.
+ *
+ * @param obj The exporter handle returned from RadarIQExporter_init()
+ * @param values The counters of each sensor
+ * @param buffer The output buffer
+ */
+static void RadarIQExporter_writeBinary(const RadarIQExporterHandle_t obj, const RadarIQExporterValues_t * const values,
+        RadarIQExporterBuffer_t * const buffer)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    RadarIQExporter_putLE(buffer, RADARIQ_EXPORTER_BINARY_MAGIC, 4u);
+    RadarIQExporter_putLE(buffer, RADARIQ_EXPORTER_BINARY_VERSION, 2u);
+    RadarIQExporter_putLE(buffer, obj->config.maxSensors, 2u);
+    RadarIQExporter_putLE(buffer, ((uint64_t)now.tv_sec * 1000000u) + ((uint64_t)now.tv_nsec / 1000u), 8u);
+
+    for (uint8_t sensor = 0u; sensor < obj->config.maxSensors; sensor++)
+    {
+        const RadarIQExporterValues_t * const value = &values[sensor];
+
+        RadarIQExporter_putBytes(buffer, obj->sensors[sensor].name, RADARIQ_EXPORTER_NAME_LEN);
+        RadarIQExporter_putLE(buffer, value->frames, 8u);
+        RadarIQExporter_putLE(buffer, value->packets, 8u);
+        RadarIQExporter_putLE(buffer, value->packetErrors, 8u);
+        RadarIQExporter_putLE(buffer, value->unknownPackets, 8u);
+        RadarIQExporter_putLE(buffer, value->truncatedFrames, 8u);
+        RadarIQExporter_putLE(buffer, value->parseCount, 8u);
+        RadarIQExporter_putLE(buffer, value->parseSumMicros, 8u);
+        RadarIQExporter_putLE(buffer, value->parseMaxMicros, 4u);
+        RadarIQExporter_putLE(buffer, value->frameRate, 4u);
+        RadarIQExporter_putLE(buffer, (uint32_t)value->activeFrameCPULoad, 4u);
+        RadarIQExporter_putLE(buffer, (uint32_t)value->interFrameCPULoad, 4u);
+        for (uint8_t idx = 0u; idx < RADARIQ_EXPORTER_NUM_TEMPERATURES; idx++)
+        {
+            RadarIQExporter_putLE(buffer, (uint16_t)value->temperatures[idx], 2u);
+        }
+    }
+}
+
+/**
+ * Appends formatted text to an output buffer, marking the buffer overflowed if it does not fit.
+ *
+ * @param buffer The output buffer
+ * @param format The printf format string
+ */
+static void RadarIQExporter_printf(RadarIQExporterBuffer_t * const buffer, const char * const format, ...)
+{
+    if (buffer->isOverflowed)
+    {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    const int len = vsnprintf((char*)&buffer->data[buffer->len], buffer->maxLen - buffer->len, format, args);
+    va_end(args);
+
+    // vsnprintf always writes a terminator, so text filling the buffer exactly is also an overflow
+    if ((0 > len) || ((uint32_t)len >= (buffer->maxLen - buffer->len)))
+    {
+        buffer->isOverflowed = true;
+        return;
+    }
+
+    buffer->len += (uint32_t)len;
+}
+
+/**
+ * Appends bytes to an output buffer, marking the buffer overflowed if they do not fit.
+ *
+ * @param buffer The output buffer
+ * @param data The bytes
+ * @param len The number of bytes
+ */
+static void RadarIQExporter_putBytes(RadarIQExporterBuffer_t * const buffer, const void * const data, const uint32_t len)
+{
+    if (buffer->isOverflowed || (len > (buffer->maxLen - buffer->len)))
+    {
+        buffer->isOverflowed = true;
+        return;
+    }
+
+    memcpy((void*)&buffer->data[buffer->len], data, len);
+    buffer->len += len;
+}
+
+/**
+ * Appends an unsigned integer to an output buffer in little-endian byte order.
+ *
+ * @param buffer The output buffer
+ * @param value The value
+ * @param len The number of bytes to write
+ */
+static void RadarIQExporter_putLE(RadarIQExporterBuffer_t * const buffer, const uint64_t value, const uint8_t len)
+{
+    uint8_t bytes[8];
+
+    for (uint8_t idx = 0u; idx < len; idx++)
+    {
+        bytes[idx] = (uint8_t)(value >> (8u * idx));
+    }
+
+    RadarIQExporter_putBytes(buffer, bytes, len);
+}
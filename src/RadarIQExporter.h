@@ -0,0 +1,99 @@
+/**
+ * @file
+ * RadarIQ SDK - Local metrics exporter.
+ * Serves per-sensor metrics as Prometheus text or a compact binary snapshot over a Unix domain socket.
+ * Requires a POSIX host with C11 atomics and pthreads.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+#ifndef SRC_RADARIQEXPORTER_H_
+#define SRC_RADARIQEXPORTER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQ.h"
+
+//===============================================================================================//
+// DEFINITIONS
+//===============================================================================================//
+
+#define RADARIQ_EXPORTER_NAME_LEN          16u       ///< Maximum length of a sensor name including the terminator
+#define RADARIQ_EXPORTER_NUM_TEMPERATURES  10u       ///< Number of chip temperatures exported per sensor
+#define RADARIQ_EXPORTER_BINARY_MAGIC      0x58514952uL    ///< "RIQX" little-endian, first 4 bytes of a binary snapshot
+#define RADARIQ_EXPORTER_BINARY_VERSION    1u        ///< Version of the binary snapshot layout
+
+/**
+ * Size of the binary snapshot header and of each sensor record in bytes.
+ * Header: magic u32, version u16, numSensors u16, timestamp u64 (CLOCK_REALTIME, microseconds)
+ * Record: name char[16], frames u64, packets u64, packetErrors u64, unknownPackets u64, truncatedFrames u64,
+ *         parseCount u64, parseSumMicros u64, parseMaxMicros u32, frameRate u32 (millihertz),
+ *         activeFrameCPULoad i32, interFrameCPULoad i32, temperatures i16[10]
+ * All fields are little-endian.
+ */
+#define RADARIQ_EXPORTER_BINARY_HEADER_SIZE    16u
+#define RADARIQ_EXPORTER_BINARY_RECORD_SIZE    (RADARIQ_EXPORTER_NAME_LEN + 56u + 16u + (2u * RADARIQ_EXPORTER_NUM_TEMPERATURES))
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Snapshot formats
+ */
+typedef enum
+{
+    RADARIQ_EXPORTER_FORMAT_PROMETHEUS = 0,     ///< Prometheus text exposition format
+    RADARIQ_EXPORTER_FORMAT_BINARY = 1          ///< Fixed-size little-endian records, see ::RADARIQ_EXPORTER_BINARY_RECORD_SIZE
+} RadarIQExporterFormat_t;
+
+/**
+ * Exporter configuration
+ */
+typedef struct
+{
+    const char * socketPath;         ///< Filesystem path of the Unix domain socket, replaced if it already exists
+    uint8_t maxSensors;              ///< Number of sensors, each identified by an index from 0 to maxSensors - 1
+    RadarIQExporterFormat_t format;  ///< Format of the snapshot written to each connecting client
+} RadarIQExporterConfig_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+typedef struct RadarIQExporter_t RadarIQExporter_t;
+typedef RadarIQExporter_t* RadarIQExporterHandle_t;
+
+//===============================================================================================//
+// FUNCTIONS
+//===============================================================================================//
+
+RadarIQExporterHandle_t RadarIQExporter_init(const RadarIQExporterConfig_t * const config);
+void RadarIQExporter_destroy(const RadarIQExporterHandle_t obj);
+RadarIQReturnVal_t RadarIQExporter_setSensorName(const RadarIQExporterHandle_t obj, const uint8_t sensor,
+        const char * const name);
+RadarIQReturnVal_t RadarIQExporter_start(const RadarIQExporterHandle_t obj);
+void RadarIQExporter_stop(const RadarIQExporterHandle_t obj);
+
+/* Ingest hooks, lock-free, each sensor must only be fed from one thread */
+void RadarIQExporter_onPacket(const RadarIQExporterHandle_t obj, const uint8_t sensor, const RadarIQHandle_t radar,
+        const RadarIQCommand_t command, const uint32_t parseMicros);
+void RadarIQExporter_onFrame(const RadarIQExporterHandle_t obj, const uint8_t sensor, const uint32_t timeMicros);
+
+uint32_t RadarIQExporter_getSnapshot(const RadarIQExporterHandle_t obj, uint8_t * const dest, const uint32_t maxLen);
+uint32_t RadarIQExporter_getSnapshotSize(const RadarIQExporterHandle_t obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_RADARIQEXPORTER_H_ */
@@ -0,0 +1,341 @@
+/**
+ * @file
+ * RadarIQ SDK - Reference-counted frame pool.
+ * Frames are parsed directly into pool buffers and published once to every registered consumer, without copying.
+ * A buffer returns to the pool when the last consumer releases it. Requires C11 atomics.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQFramePool.h"
+#include <stdatomic.h>
+#include <stddef.h>
+
+//===============================================================================================//
+// CONSTANTS
+//===============================================================================================//
+
+#define RADARIQ_FRAMEPOOL_CACHE_LINE       64u       ///< Consumer queues are aligned to a cache line so consumers don't false-share
+#define RADARIQ_FRAMEPOOL_NO_BUFFER        0xFFu     ///< Returned by RadarIQFramePool_acquire() when no buffer is free
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * A pool buffer, the frame must be the first member so a frame pointer can be converted back to its buffer
+ */
+typedef struct
+{
+    RadarIQFrame_t frame;
+    atomic_uint refs;                ///< Number of consumers yet to release the frame
+} RadarIQFramePoolBuffer_t;
+
+/**
+ * Single-producer single-consumer queue of published buffer indices.
+ * A buffer is in each queue at most once until released, so a queue as long as the largest pool can't overflow.
+ */
+typedef struct
+{
+    _Alignas(RADARIQ_FRAMEPOOL_CACHE_LINE) atomic_uint head;     ///< Written by the producer
+    _Alignas(RADARIQ_FRAMEPOOL_CACHE_LINE) atomic_uint tail;     ///< Written by the consumer
+    uint8_t indices[RADARIQ_FRAMEPOOL_MAX_BUFFERS];
+} RadarIQFramePoolQueue_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+/**
+ * The RadarIQ frame pool object definition
+ */
+struct RadarIQFramePool_t
+{
+    RadarIQFramePoolConfig_t config;
+    RadarIQFramePoolBuffer_t * buffers;
+    RadarIQFramePoolQueue_t * queues;
+    atomic_uint_least64_t freeMask;  ///< Bit set for each buffer in the pool
+    uint8_t numConsumers;
+    RadarIQHandle_t radar;
+    uint8_t current;                 ///< Buffer the radar is parsing into, owned by the producer
+    uint32_t sequence;
+    atomic_uint_least32_t overruns;
+};
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTION PROTOTYPES
+//===============================================================================================//
+
+static uint8_t RadarIQFramePool_acquire(const RadarIQFramePoolHandle_t obj);
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Allocates and initializes a frame pool instance using heap allocation. All buffers are allocated here, none
+ * are allocated while frames are published.
+ *
+ * @param config Pointer to the frame pool configuration
+ *
+ * @return A handle for an instance of the RadarIQFramePool_t object
+ */
+RadarIQFramePoolHandle_t RadarIQFramePool_init(const RadarIQFramePoolConfig_t * const config)
+{
+    RADARIQ_ASSERT(NULL != config);
+    RADARIQ_ASSERT(RADARIQ_FRAMEPOOL_MIN_BUFFERS <= config->numBuffers);
+    RADARIQ_ASSERT(RADARIQ_FRAMEPOOL_MAX_BUFFERS >= config->numBuffers);
+    RADARIQ_ASSERT(0u < config->maxConsumers);
+    RADARIQ_ASSERT(RADARIQ_FRAMEPOOL_NO_CONSUMER > config->maxConsumers);
+
+    RadarIQFramePoolHandle_t handle = malloc(sizeof(RadarIQFramePool_t));
+    RADARIQ_ASSERT(NULL != handle);
+    memset((void*)handle, 0, sizeof(RadarIQFramePool_t));
+
+    handle->config = *config;
+
+    handle->buffers = malloc(sizeof(RadarIQFramePoolBuffer_t) * config->numBuffers);
+    RADARIQ_ASSERT(NULL != handle->buffers);
+    memset((void*)handle->buffers, 0, sizeof(RadarIQFramePoolBuffer_t) * config->numBuffers);
+
+    for (uint8_t i = 0u; i < config->numBuffers; i++)
+    {
+        atomic_init(&handle->buffers[i].refs, 0u);
+    }
+
+    const size_t queuesSize = sizeof(RadarIQFramePoolQueue_t) * config->maxConsumers;
+    handle->queues = aligned_alloc(RADARIQ_FRAMEPOOL_CACHE_LINE, queuesSize);
+    RADARIQ_ASSERT(NULL != handle->queues);
+    memset((void*)handle->queues, 0, queuesSize);
+
+    for (uint8_t i = 0u; i < config->maxConsumers; i++)
+    {
+        atomic_init(&handle->queues[i].head, 0u);
+        atomic_init(&handle->queues[i].tail, 0u);
+    }
+
+    const uint_least64_t allBuffers = (RADARIQ_FRAMEPOOL_MAX_BUFFERS == config->numBuffers) ?
+            UINT64_MAX : ((1uLL << config->numBuffers) - 1uLL);
+    atomic_init(&handle->freeMask, allBuffers);
+    atomic_init(&handle->overruns, 0u);
+
+    handle->current = RadarIQFramePool_acquire(handle);
+
+    return handle;
+}
+
+/**
+ * Frees a frame pool instance created by RadarIQFramePool_init(). The attached radar is returned to parsing
+ * into its own storage. No frames taken from the pool may be used afterwards.
+ *
+ * @param obj The frame pool handle returned from RadarIQFramePool_init()
+ */
+void RadarIQFramePool_destroy(const RadarIQFramePoolHandle_t obj)
+{
+    if (NULL != obj)
+    {
+        if (NULL != obj->radar)
+        {
+            RadarIQ_setFrameBuffer(obj->radar, NULL);
+        }
+        free(obj->buffers);
+        free(obj->queues);
+        free(obj);
+    }
+}
+
+/**
+ * Registers a consumer. Every frame published afterwards is delivered to the consumer, which must release it.
+ * Consumers must be added before frames are published.
+ *
+ * @param obj The frame pool handle returned from RadarIQFramePool_init()
+ *
+ * @return The consumer id, or ::RADARIQ_FRAMEPOOL_NO_CONSUMER if the maximum number of consumers is reached
+ */
+uint8_t RadarIQFramePool_addConsumer(const RadarIQFramePoolHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    if (obj->config.maxConsumers <= obj->numConsumers)
+    {
+        return RADARIQ_FRAMEPOOL_NO_CONSUMER;
+    }
+
+    const uint8_t consumer = obj->numConsumers;
+    obj->numConsumers++;
+
+    return consumer;
+}
+
+/**
+ * Attaches a radar so that its frames are parsed directly into pool buffers.
+ * Should be called between frames, see RadarIQ_setFrameBuffer().
+ *
+ * @param obj The frame pool handle returned from RadarIQFramePool_init()
+ * @param radar The RadarIQ object handle returned from RadarIQ_init()
+ */
+void RadarIQFramePool_attach(const RadarIQFramePoolHandle_t obj, const RadarIQHandle_t radar)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != radar);
+
+    obj->radar = radar;
+    RadarIQ_setFrameBuffer(radar, &obj->buffers[obj->current].frame.data);
+}
+
+/**
+ * Publishes the frame just parsed to all consumers and moves the radar on to a free buffer.
+ * Should be called with every value returned from RadarIQ_readSerial(), other commands are ignored.
+ * If no buffer is free the frame is dropped, counted as an overrun, and the radar reuses its buffer.
+ *
+ * @param obj The frame pool handle returned from RadarIQFramePool_init()
+ * @param command The command returned from RadarIQ_readSerial()
+ *
+ * @return true if a frame was published
+ */
+bool RadarIQFramePool_publish(const RadarIQFramePoolHandle_t obj, const RadarIQCommand_t command)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != obj->radar);
+
+    if (((RADARIQ_CMD_PNT_CLOUD_FRAME != command) && (RADARIQ_CMD_OBJ_TRACKING_FRAME != command)) ||
+            (0u == obj->numConsumers))
+    {
+        return false;
+    }
+
+    const uint8_t next = RadarIQFramePool_acquire(obj);
+    if (RADARIQ_FRAMEPOOL_NO_BUFFER == next)
+    {
+        atomic_fetch_add_explicit(&obj->overruns, 1u, memory_order_relaxed);
+        return false;
+    }
+
+    RadarIQFramePoolBuffer_t * const buffer = &obj->buffers[obj->current];
+    RadarIQ_getFrameInfo(obj->radar, &buffer->frame.info);
+    buffer->frame.type = command;
+    buffer->frame.sequence = obj->sequence;
+    obj->sequence++;
+    atomic_store_explicit(&buffer->refs, obj->numConsumers, memory_order_relaxed);
+
+    // The release store of each head makes the frame and its reference count visible to that consumer
+    for (uint8_t i = 0u; i < obj->numConsumers; i++)
+    {
+        RadarIQFramePoolQueue_t * const queue = &obj->queues[i];
+        const uint32_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+        queue->indices[head & (RADARIQ_FRAMEPOOL_MAX_BUFFERS - 1u)] = obj->current;
+        atomic_store_explicit(&queue->head, head + 1u, memory_order_release);
+    }
+
+    obj->current = next;
+    RadarIQ_setFrameBuffer(obj->radar, &obj->buffers[next].frame.data);
+
+    return true;
+}
+
+/**
+ * Takes the oldest frame published to a consumer and not yet taken.
+ *
+ * @param obj The frame pool handle returned from RadarIQFramePool_init()
+ * @param consumer The consumer id returned from RadarIQFramePool_addConsumer()
+ *
+ * @return Pointer to the frame, which must be passed to RadarIQFramePool_release(), or NULL if there is none
+ */
+const RadarIQFrame_t * RadarIQFramePool_take(const RadarIQFramePoolHandle_t obj, const uint8_t consumer)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(obj->numConsumers > consumer);
+
+    RadarIQFramePoolQueue_t * const queue = &obj->queues[consumer];
+    const uint32_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+    if (atomic_load_explicit(&queue->head, memory_order_acquire) == tail)
+    {
+        return NULL;
+    }
+
+    const uint8_t index = queue->indices[tail & (RADARIQ_FRAMEPOOL_MAX_BUFFERS - 1u)];
+    atomic_store_explicit(&queue->tail, tail + 1u, memory_order_relaxed);
+
+    return &obj->buffers[index].frame;
+}
+
+/**
+ * Releases a frame taken with RadarIQFramePool_take(). The buffer returns to the pool when every consumer has
+ * released it.
+ *
+ * @param obj The frame pool handle returned from RadarIQFramePool_init()
+ * @param frame Pointer to the frame
+ */
+void RadarIQFramePool_release(const RadarIQFramePoolHandle_t obj, const RadarIQFrame_t * const frame)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != frame);
+
+    RadarIQFramePoolBuffer_t * const buffer = (RadarIQFramePoolBuffer_t *)frame;
+    const ptrdiff_t index = buffer - obj->buffers;
+    RADARIQ_ASSERT((0 <= index) && (obj->config.numBuffers > index));
+
+    if (1u == atomic_fetch_sub_explicit(&buffer->refs, 1u, memory_order_acq_rel))
+    {
+        atomic_fetch_or_explicit(&obj->freeMask, (uint_least64_t)1u << index, memory_order_release);
+    }
+}
+
+/**
+ * Gets the number of frames dropped because no buffer was free when they were published.
+ *
+ * @param obj The frame pool handle returned from RadarIQFramePool_init()
+ *
+ * @return The number of dropped frames
+ */
+uint32_t RadarIQFramePool_getOverruns(const RadarIQFramePoolHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    return atomic_load_explicit(&obj->overruns, memory_order_relaxed);
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Removes the lowest numbered free buffer from the pool.
+ *
+ * @param obj The frame pool handle returned from RadarIQFramePool_init()
+ *
+ * @return The buffer index, or RADARIQ_FRAMEPOOL_NO_BUFFER if no buffer is free
+ */
+static uint8_t RadarIQFramePool_acquire(const RadarIQFramePoolHandle_t obj)
+{
+    uint_least64_t mask = atomic_load_explicit(&obj->freeMask, memory_order_relaxed);
+    uint_least64_t lowest;
+
+    do
+    {
+        if (0u == mask)
+        {
+            return RADARIQ_FRAMEPOOL_NO_BUFFER;
+        }
+        lowest = mask & (~mask + 1u);
+    }
+    while (!atomic_compare_exchange_weak_explicit(&obj->freeMask, &mask, mask & ~lowest,
+            memory_order_acquire, memory_order_relaxed));
+
+    uint8_t index = 0u;
+    while (1u != lowest)
+    {
+        lowest >>= 1u;
+        index++;
+    }
+
+    return index;
+}
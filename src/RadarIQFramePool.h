@@ -0,0 +1,76 @@
+/**
+ * @file
+ * RadarIQ SDK - Reference-counted frame pool.
+ * Frames are parsed directly into pool buffers and published once to every registered consumer, without copying.
+ * A buffer returns to the pool when the last consumer releases it. Requires C11 atomics.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+#ifndef SRC_RADARIQFRAMEPOOL_H_
+#define SRC_RADARIQFRAMEPOOL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQ.h"
+
+//===============================================================================================//
+// DEFINITIONS
+//===============================================================================================//
+
+#define RADARIQ_FRAMEPOOL_MIN_BUFFERS      2u        ///< One buffer being parsed into and at least one published
+#define RADARIQ_FRAMEPOOL_MAX_BUFFERS      64u       ///< Free buffers are tracked in a 64-bit mask
+#define RADARIQ_FRAMEPOOL_NO_CONSUMER      0xFFu     ///< Returned by RadarIQFramePool_addConsumer() when full
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Frame pool configuration
+ */
+typedef struct
+{
+    uint8_t numBuffers;              ///< Number of frame buffers, ::RADARIQ_FRAMEPOOL_MIN_BUFFERS to ::RADARIQ_FRAMEPOOL_MAX_BUFFERS
+    uint8_t maxConsumers;            ///< Maximum number of consumers
+} RadarIQFramePoolConfig_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+typedef struct RadarIQFramePool_t RadarIQFramePool_t;
+typedef RadarIQFramePool_t* RadarIQFramePoolHandle_t;
+
+//===============================================================================================//
+// FUNCTIONS
+//===============================================================================================//
+
+RadarIQFramePoolHandle_t RadarIQFramePool_init(const RadarIQFramePoolConfig_t * const config);
+void RadarIQFramePool_destroy(const RadarIQFramePoolHandle_t obj);
+uint8_t RadarIQFramePool_addConsumer(const RadarIQFramePoolHandle_t obj);
+void RadarIQFramePool_attach(const RadarIQFramePoolHandle_t obj, const RadarIQHandle_t radar);
+
+/* Producer, must be called from the thread that calls RadarIQ_readSerial() */
+bool RadarIQFramePool_publish(const RadarIQFramePoolHandle_t obj, const RadarIQCommand_t command);
+
+/* Consumers, each consumer id must only be taken from by one thread, frames may be released from any thread */
+const RadarIQFrame_t * RadarIQFramePool_take(const RadarIQFramePoolHandle_t obj, const uint8_t consumer);
+void RadarIQFramePool_release(const RadarIQFramePoolHandle_t obj, const RadarIQFrame_t * const frame);
+
+uint32_t RadarIQFramePool_getOverruns(const RadarIQFramePoolHandle_t obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_RADARIQFRAMEPOOL_H_ */
@@ -0,0 +1,481 @@
+/**
+ * @file
+ * RadarIQ SDK - Occupancy grid.
+ * Incrementally updated 2D/3D log-odds occupancy grid with tiled storage and dirty-tile tracking
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQOccupancy.h"
+#include <math.h>
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+/**
+ * The RadarIQ occupancy grid object definition
+ * Cells are stored tile by tile so each tile is one contiguous block of ::RADARIQ_OCCUPANCY_TILE_CELLS bytes
+ */
+struct RadarIQOccupancy_t
+{
+    RadarIQOccupancyConfig_t config;
+    uint8_t tileShift[3];            ///< log2 of the tile edge length along x, y and z
+    uint16_t numTilesX;
+    uint16_t numTilesY;
+    uint16_t numTilesZ;
+    uint32_t numTiles;
+    uint32_t updateCount;
+
+    int8_t * cells;                  ///< Cell log-odds, numTiles * RADARIQ_OCCUPANCY_TILE_CELLS
+    uint8_t * tileOccupied;          ///< Number of non-zero cells in each tile
+    uint8_t * tileFlags;             ///< Active and dirty flags of each tile
+    uint32_t * activeTiles;          ///< Tiles with at least one non-zero cell, the only tiles visited by decay
+    uint32_t numActive;
+    uint32_t * dirtyTiles;           ///< Tiles changed since they were last pulled
+    uint32_t numDirty;
+};
+
+//===============================================================================================//
+// CONSTANTS
+//===============================================================================================//
+
+#define RADARIQ_OCCUPANCY_FLAG_ACTIVE     0x01u     ///< Tile is in the active list
+#define RADARIQ_OCCUPANCY_FLAG_DIRTY      0x02u     ///< Tile is in the dirty list
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTION PROTOTYPES
+//===============================================================================================//
+
+static void RadarIQOccupancy_decay(const RadarIQOccupancyHandle_t obj);
+static void RadarIQOccupancy_hit(const RadarIQOccupancyHandle_t obj, const int32_t cx, const int32_t cy,
+        const int32_t cz);
+static int8_t * RadarIQOccupancy_locate(const RadarIQOccupancyHandle_t obj, const int32_t cx, const int32_t cy,
+        const int32_t cz, uint32_t * const tile);
+static void RadarIQOccupancy_markDirty(const RadarIQOccupancyHandle_t obj, const uint32_t tile);
+static int32_t RadarIQOccupancy_getCellIndex(const int32_t offset, const uint16_t cellSize);
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Allocates and initializes an occupancy grid instance using heap allocation.
+ *
+ * @param config Pointer to the grid configuration
+ *
+ * @return A handle for an instance of the RadarIQOccupancy_t object
+ */
+RadarIQOccupancyHandle_t RadarIQOccupancy_init(const RadarIQOccupancyConfig_t * const config)
+{
+    RADARIQ_ASSERT(NULL != config);
+    RADARIQ_ASSERT(0u < config->cellSize);
+    RADARIQ_ASSERT(0u < config->sizeX);
+    RADARIQ_ASSERT(0u < config->sizeY);
+    RADARIQ_ASSERT(0u < config->sizeZ);
+    RADARIQ_ASSERT(0 < config->hitLogOdds);
+    RADARIQ_ASSERT(0 <= config->decayLogOdds);
+    RADARIQ_ASSERT(0 < config->maxLogOdds);
+
+    RadarIQOccupancyHandle_t handle = malloc(sizeof(RadarIQOccupancy_t));
+    RADARIQ_ASSERT(NULL != handle);
+    memset((void*)handle, 0, sizeof(RadarIQOccupancy_t));
+
+    handle->config = *config;
+
+    // 2D grids use flat 8x8 tiles, 3D grids use 4x4x4 tiles
+    const bool is3D = (1u < config->sizeZ);
+    handle->tileShift[0] = is3D ? 2u : 3u;
+    handle->tileShift[1] = is3D ? 2u : 3u;
+    handle->tileShift[2] = is3D ? 2u : 0u;
+
+    handle->numTilesX = (uint16_t)((config->sizeX + (1u << handle->tileShift[0]) - 1u) >> handle->tileShift[0]);
+    handle->numTilesY = (uint16_t)((config->sizeY + (1u << handle->tileShift[1]) - 1u) >> handle->tileShift[1]);
+    handle->numTilesZ = (uint16_t)((config->sizeZ + (1u << handle->tileShift[2]) - 1u) >> handle->tileShift[2]);
+    handle->numTiles = (uint32_t)handle->numTilesX * handle->numTilesY * handle->numTilesZ;
+
+    handle->config.sizeX = (uint16_t)(handle->numTilesX << handle->tileShift[0]);
+    handle->config.sizeY = (uint16_t)(handle->numTilesY << handle->tileShift[1]);
+    handle->config.sizeZ = (uint16_t)(handle->numTilesZ << handle->tileShift[2]);
+
+    handle->cells = calloc(handle->numTiles, RADARIQ_OCCUPANCY_TILE_CELLS);
+    handle->tileOccupied = calloc(handle->numTiles, sizeof(uint8_t));
+    handle->tileFlags = calloc(handle->numTiles, sizeof(uint8_t));
+    handle->activeTiles = malloc(handle->numTiles * sizeof(uint32_t));
+    handle->dirtyTiles = malloc(handle->numTiles * sizeof(uint32_t));
+    RADARIQ_ASSERT(NULL != handle->cells);
+    RADARIQ_ASSERT(NULL != handle->tileOccupied);
+    RADARIQ_ASSERT(NULL != handle->tileFlags);
+    RADARIQ_ASSERT(NULL != handle->activeTiles);
+    RADARIQ_ASSERT(NULL != handle->dirtyTiles);
+
+    return handle;
+}
+
+/**
+ * Frees an occupancy grid instance created by RadarIQOccupancy_init().
+ *
+ * @param obj The occupancy grid handle returned from RadarIQOccupancy_init()
+ */
+void RadarIQOccupancy_destroy(const RadarIQOccupancyHandle_t obj)
+{
+    if (NULL != obj)
+    {
+        free(obj->cells);
+        free(obj->tileOccupied);
+        free(obj->tileFlags);
+        free(obj->activeTiles);
+        free(obj->dirtyTiles);
+        free(obj);
+    }
+}
+
+/**
+ * Clears every cell of the grid. All previously occupied tiles are marked dirty.
+ *
+ * @param obj The occupancy grid handle returned from RadarIQOccupancy_init()
+ */
+void RadarIQOccupancy_clear(const RadarIQOccupancyHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    for (uint32_t idx = 0u; idx < obj->numActive; idx++)
+    {
+        const uint32_t tile = obj->activeTiles[idx];
+
+        memset((void*)&obj->cells[tile * RADARIQ_OCCUPANCY_TILE_CELLS], 0, RADARIQ_OCCUPANCY_TILE_CELLS);
+        obj->tileOccupied[tile] = 0u;
+        obj->tileFlags[tile] &= (uint8_t)~RADARIQ_OCCUPANCY_FLAG_ACTIVE;
+        RadarIQOccupancy_markDirty(obj, tile);
+    }
+
+    obj->numActive = 0u;
+}
+
+/**
+ * Updates the grid with the points of one frame in the sensor frame.
+ * Each point adds a hit to its cell, and every configured decay interval all occupied cells decay towards free.
+ * Only tiles holding occupied cells are visited so the cost scales with occupancy, not grid size.
+ *
+ * @param obj The occupancy grid handle returned from RadarIQOccupancy_init()
+ * @param points Pointer to the frame points, e.g. RadarIQDataPointCloud_t::points
+ * @param numPoints The number of points in the frame
+ */
+void RadarIQOccupancy_update(const RadarIQOccupancyHandle_t obj, const RadarIQDataPoint_t * const points,
+        const uint16_t numPoints)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT((NULL != points) || (0u == numPoints));
+
+    RadarIQOccupancy_decay(obj);
+
+    for (uint16_t idx = 0u; idx < numPoints; idx++)
+    {
+        RadarIQOccupancy_hit(obj,
+                RadarIQOccupancy_getCellIndex((int32_t)points[idx].x - obj->config.originX, obj->config.cellSize),
+                RadarIQOccupancy_getCellIndex((int32_t)points[idx].y - obj->config.originY, obj->config.cellSize),
+                RadarIQOccupancy_getCellIndex((int32_t)points[idx].z - obj->config.originZ, obj->config.cellSize));
+    }
+}
+
+/**
+ * Updates the grid with the points of one frame already transformed into the world frame.
+ *
+ * @param obj The occupancy grid handle returned from RadarIQOccupancy_init()
+ * @param x Pointer to the world x-coordinates in millimeters, e.g. from RadarIQTransform_points()
+ * @param y Pointer to the world y-coordinates in millimeters
+ * @param z Pointer to the world z-coordinates in millimeters
+ * @param numPoints The number of points in the frame
+ */
+void RadarIQOccupancy_updateWorld(const RadarIQOccupancyHandle_t obj, const float * const x, const float * const y,
+        const float * const z, const uint16_t numPoints)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(((NULL != x) && (NULL != y) && (NULL != z)) || (0u == numPoints));
+
+    const float scale = 1.0f / (float)obj->config.cellSize;
+
+    RadarIQOccupancy_decay(obj);
+
+    for (uint16_t idx = 0u; idx < numPoints; idx++)
+    {
+        const float cx = floorf((x[idx] - (float)obj->config.originX) * scale);
+        const float cy = floorf((y[idx] - (float)obj->config.originY) * scale);
+        const float cz = floorf((z[idx] - (float)obj->config.originZ) * scale);
+
+        if ((0.0f <= cx) && (0.0f <= cy) && (65536.0f > cx) && (65536.0f > cy) && (-65536.0f < cz) && (65536.0f > cz))
+        {
+            RadarIQOccupancy_hit(obj, (int32_t)cx, (int32_t)cy, (int32_t)cz);
+        }
+    }
+}
+
+/**
+ * Gets the log-odds of the cell containing a position.
+ *
+ * @param obj The occupancy grid handle returned from RadarIQOccupancy_init()
+ * @param x The x-coordinate in millimeters
+ * @param y The y-coordinate in millimeters
+ * @param z The z-coordinate in millimeters
+ *
+ * @return The cell log-odds, or 0 if the position is outside the grid
+ */
+int8_t RadarIQOccupancy_getCell(const RadarIQOccupancyHandle_t obj, const int16_t x, const int16_t y, const int16_t z)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    const int32_t cx = RadarIQOccupancy_getCellIndex((int32_t)x - obj->config.originX, obj->config.cellSize);
+    const int32_t cy = RadarIQOccupancy_getCellIndex((int32_t)y - obj->config.originY, obj->config.cellSize);
+    const int32_t cz = RadarIQOccupancy_getCellIndex((int32_t)z - obj->config.originZ, obj->config.cellSize);
+
+    const int8_t * const cell = RadarIQOccupancy_locate(obj, cx, cy, cz, NULL);
+
+    return (NULL != cell) ? *cell : 0;
+}
+
+/**
+ * Gets the total number of tiles in the grid.
+ *
+ * @param obj The occupancy grid handle returned from RadarIQOccupancy_init()
+ *
+ * @return The number of tiles
+ */
+uint32_t RadarIQOccupancy_getNumTiles(const RadarIQOccupancyHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    return obj->numTiles;
+}
+
+/**
+ * Pulls the indices of tiles changed since they were last pulled. Returned tiles are marked clean.
+ * Call repeatedly until it returns 0 to drain all changes.
+ *
+ * @param obj The occupancy grid handle returned from RadarIQOccupancy_init()
+ * @param tiles Pointer to an array to copy the changed tile indices into
+ * @param maxTiles The length of the array
+ *
+ * @return The number of tile indices copied
+ */
+uint32_t RadarIQOccupancy_getDirtyTiles(const RadarIQOccupancyHandle_t obj, uint32_t * const tiles,
+        const uint32_t maxTiles)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT((NULL != tiles) || (0u == maxTiles));
+
+    uint32_t count = 0u;
+
+    while ((count < maxTiles) && (0u < obj->numDirty))
+    {
+        obj->numDirty--;
+        const uint32_t tile = obj->dirtyTiles[obj->numDirty];
+
+        obj->tileFlags[tile] &= (uint8_t)~RADARIQ_OCCUPANCY_FLAG_DIRTY;
+        tiles[count] = tile;
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * Gets the cells of a tile.
+ * Cells are ordered x fastest, then y, then z, within the tile's extent.
+ *
+ * @param obj The occupancy grid handle returned from RadarIQOccupancy_init()
+ * @param tile The tile index, e.g. from RadarIQOccupancy_getDirtyTiles()
+ * @param info Pointer to a RadarIQOccupancyTile_t struct to copy the tile location into, or NULL
+ *
+ * @return Pointer to the ::RADARIQ_OCCUPANCY_TILE_CELLS cells of the tile
+ */
+const int8_t * RadarIQOccupancy_getTile(const RadarIQOccupancyHandle_t obj, const uint32_t tile,
+        RadarIQOccupancyTile_t * const info)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(tile < obj->numTiles);
+
+    if (NULL != info)
+    {
+        info->x = (uint16_t)((tile % obj->numTilesX) << obj->tileShift[0]);
+        info->y = (uint16_t)(((tile / obj->numTilesX) % obj->numTilesY) << obj->tileShift[1]);
+        info->z = (uint16_t)((tile / ((uint32_t)obj->numTilesX * obj->numTilesY)) << obj->tileShift[2]);
+        info->sizeX = (uint8_t)(1u << obj->tileShift[0]);
+        info->sizeY = (uint8_t)(1u << obj->tileShift[1]);
+        info->sizeZ = (uint8_t)(1u << obj->tileShift[2]);
+    }
+
+    return &obj->cells[tile * RADARIQ_OCCUPANCY_TILE_CELLS];
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Applies a decay step to all occupied tiles if one is due.
+ *
+ * @param obj The occupancy grid handle returned from RadarIQOccupancy_init()
+ */
+static void RadarIQOccupancy_decay(const RadarIQOccupancyHandle_t obj)
+{
+    obj->updateCount++;
+
+    if ((0u == obj->config.decayInterval) || (0u != (obj->updateCount % obj->config.decayInterval)))
+    {
+        return;
+    }
+
+    const int8_t step = obj->config.decayLogOdds;
+    uint32_t idx = 0u;
+
+    while (idx < obj->numActive)
+    {
+        const uint32_t tile = obj->activeTiles[idx];
+        int8_t * const cells = &obj->cells[tile * RADARIQ_OCCUPANCY_TILE_CELLS];
+
+        for (uint8_t cell = 0u; cell < RADARIQ_OCCUPANCY_TILE_CELLS; cell++)
+        {
+            if (0 < cells[cell])
+            {
+                cells[cell] = (cells[cell] > step) ? (int8_t)(cells[cell] - step) : 0;
+                if (0 == cells[cell])
+                {
+                    obj->tileOccupied[tile]--;
+                }
+            }
+        }
+
+        RadarIQOccupancy_markDirty(obj, tile);
+
+        // Tiles with no occupied cells leave the active list, swapping in the last entry
+        if (0u == obj->tileOccupied[tile])
+        {
+            obj->tileFlags[tile] &= (uint8_t)~RADARIQ_OCCUPANCY_FLAG_ACTIVE;
+            obj->numActive--;
+            obj->activeTiles[idx] = obj->activeTiles[obj->numActive];
+        }
+        else
+        {
+            idx++;
+        }
+    }
+}
+
+/**
+ * Adds a hit to a cell.
+ *
+ * @param obj The occupancy grid handle returned from RadarIQOccupancy_init()
+ * @param cx The cell x-index
+ * @param cy The cell y-index
+ * @param cz The cell z-index
+ */
+static void RadarIQOccupancy_hit(const RadarIQOccupancyHandle_t obj, const int32_t cx, const int32_t cy,
+        const int32_t cz)
+{
+    uint32_t tile;
+    int8_t * const cell = RadarIQOccupancy_locate(obj, cx, cy, cz, &tile);
+
+    if (NULL == cell)
+    {
+        return;
+    }
+
+    const int16_t value = (int16_t)(*cell + obj->config.hitLogOdds);
+    const int8_t clamped = (value > obj->config.maxLogOdds) ? obj->config.maxLogOdds : ((0 > value) ? 0 : (int8_t)value);
+
+    if (clamped == *cell)
+    {
+        return;
+    }
+
+    if (0 == *cell)
+    {
+        obj->tileOccupied[tile]++;
+    }
+    *cell = clamped;
+
+    if (0u == (obj->tileFlags[tile] & RADARIQ_OCCUPANCY_FLAG_ACTIVE))
+    {
+        obj->tileFlags[tile] |= RADARIQ_OCCUPANCY_FLAG_ACTIVE;
+        obj->activeTiles[obj->numActive] = tile;
+        obj->numActive++;
+    }
+
+    RadarIQOccupancy_markDirty(obj, tile);
+}
+
+/**
+ * Locates the storage of a cell within the tiled cell array.
+ *
+ * @param obj The occupancy grid handle returned from RadarIQOccupancy_init()
+ * @param cx The cell x-index
+ * @param cy The cell y-index
+ * @param cz The cell z-index
+ * @param tile Pointer to a variable to store the tile index into, or NULL
+ *
+ * @return Pointer to the cell, or NULL if the cell is outside the grid
+ */
+static int8_t * RadarIQOccupancy_locate(const RadarIQOccupancyHandle_t obj, const int32_t cx, const int32_t cy,
+        const int32_t cz, uint32_t * const tile)
+{
+    // 2D grids ignore height
+    const int32_t z = (1u == obj->config.sizeZ) ? 0 : cz;
+
+    if ((0 > cx) || (0 > cy) || (0 > z) || (obj->config.sizeX <= cx) || (obj->config.sizeY <= cy) ||
+            (obj->config.sizeZ <= z))
+    {
+        return NULL;
+    }
+
+    const uint32_t tileIdx = ((((uint32_t)z >> obj->tileShift[2]) * obj->numTilesY +
+            ((uint32_t)cy >> obj->tileShift[1])) * obj->numTilesX) + ((uint32_t)cx >> obj->tileShift[0]);
+    const uint32_t offset = ((((uint32_t)z & ((1u << obj->tileShift[2]) - 1u)) <<
+            (obj->tileShift[0] + obj->tileShift[1])) |
+            (((uint32_t)cy & ((1u << obj->tileShift[1]) - 1u)) << obj->tileShift[0]) |
+            ((uint32_t)cx & ((1u << obj->tileShift[0]) - 1u)));
+
+    if (NULL != tile)
+    {
+        *tile = tileIdx;
+    }
+
+    return &obj->cells[(tileIdx * RADARIQ_OCCUPANCY_TILE_CELLS) + offset];
+}
+
+/**
+ * Adds a tile to the dirty list if it is not already in it.
+ *
+ * @param obj The occupancy grid handle returned from RadarIQOccupancy_init()
+ * @param tile The tile index
+ */
+static void RadarIQOccupancy_markDirty(const RadarIQOccupancyHandle_t obj, const uint32_t tile)
+{
+    if (0u == (obj->tileFlags[tile] & RADARIQ_OCCUPANCY_FLAG_DIRTY))
+    {
+        obj->tileFlags[tile] |= RADARIQ_OCCUPANCY_FLAG_DIRTY;
+        obj->dirtyTiles[obj->numDirty] = tile;
+        obj->numDirty++;
+    }
+}
+
+/**
+ * Gets the cell index of an offset from the grid origin, rounding towards negative infinity.
+ *
+ * @param offset The offset from the grid origin in millimeters
+ * @param cellSize The cell edge length in millimeters
+ *
+ * @return The cell index, negative if the offset is below the origin
+ */
+static int32_t RadarIQOccupancy_getCellIndex(const int32_t offset, const uint16_t cellSize)
+{
+    const int32_t size = (int32_t)cellSize;
+
+    return (offset >= 0) ? (offset / size) : (((offset + 1) / size) - 1);
+}
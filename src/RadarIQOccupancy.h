@@ -0,0 +1,96 @@
+/**
+ * @file
+ * RadarIQ SDK - Occupancy grid.
+ * Incrementally updated 2D/3D log-odds occupancy grid with tiled storage and dirty-tile tracking
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+#ifndef SRC_RADARIQOCCUPANCY_H_
+#define SRC_RADARIQOCCUPANCY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQ.h"
+
+//===============================================================================================//
+// DEFINITIONS
+//===============================================================================================//
+
+#define RADARIQ_OCCUPANCY_TILE_CELLS       64u       ///< Number of cells stored contiguously in one tile
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Occupancy grid configuration
+ * A 2D grid is configured with a z-size of 1 cell, ignores height and uses 8x8 tiles, a 3D grid uses 4x4x4 tiles
+ */
+typedef struct
+{
+    uint16_t cellSize;               ///< Cell edge length in millimeters
+    uint16_t sizeX;                  ///< Number of cells along x, rounded up to a whole tile
+    uint16_t sizeY;                  ///< Number of cells along y, rounded up to a whole tile
+    uint16_t sizeZ;                  ///< Number of cells along z, 1 for a 2D grid, otherwise rounded up to a whole tile
+    int16_t originX;                 ///< World x-coordinate of the grid's minimum corner in millimeters
+    int16_t originY;                 ///< World y-coordinate of the grid's minimum corner in millimeters
+    int16_t originZ;                 ///< World z-coordinate of the grid's minimum corner in millimeters
+    int8_t hitLogOdds;               ///< Log-odds added to a cell for each point falling in it, greater than 0
+    int8_t decayLogOdds;             ///< Log-odds removed from every occupied cell per decay step, 0 or more
+    int8_t maxLogOdds;               ///< Upper clamp of a cell's log-odds
+    uint8_t decayInterval;           ///< Number of updates between decay steps, 0 to disable decay
+} RadarIQOccupancyConfig_t;
+
+/**
+ * Location of a tile within the grid
+ */
+typedef struct
+{
+    uint16_t x;                      ///< Cell x-index of the tile's first cell
+    uint16_t y;                      ///< Cell y-index of the tile's first cell
+    uint16_t z;                      ///< Cell z-index of the tile's first cell
+    uint8_t sizeX;                   ///< Tile edge length along x in cells
+    uint8_t sizeY;                   ///< Tile edge length along y in cells
+    uint8_t sizeZ;                   ///< Tile edge length along z in cells
+} RadarIQOccupancyTile_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+typedef struct RadarIQOccupancy_t RadarIQOccupancy_t;
+typedef RadarIQOccupancy_t* RadarIQOccupancyHandle_t;
+
+//===============================================================================================//
+// FUNCTIONS
+//===============================================================================================//
+
+RadarIQOccupancyHandle_t RadarIQOccupancy_init(const RadarIQOccupancyConfig_t * const config);
+void RadarIQOccupancy_destroy(const RadarIQOccupancyHandle_t obj);
+void RadarIQOccupancy_clear(const RadarIQOccupancyHandle_t obj);
+void RadarIQOccupancy_update(const RadarIQOccupancyHandle_t obj, const RadarIQDataPoint_t * const points,
+        const uint16_t numPoints);
+void RadarIQOccupancy_updateWorld(const RadarIQOccupancyHandle_t obj, const float * const x, const float * const y,
+        const float * const z, const uint16_t numPoints);
+int8_t RadarIQOccupancy_getCell(const RadarIQOccupancyHandle_t obj, const int16_t x, const int16_t y, const int16_t z);
+uint32_t RadarIQOccupancy_getNumTiles(const RadarIQOccupancyHandle_t obj);
+uint32_t RadarIQOccupancy_getDirtyTiles(const RadarIQOccupancyHandle_t obj, uint32_t * const tiles,
+        const uint32_t maxTiles);
+const int8_t * RadarIQOccupancy_getTile(const RadarIQOccupancyHandle_t obj, const uint32_t tile,
+        RadarIQOccupancyTile_t * const info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_RADARIQOCCUPANCY_H_ */
@@ -0,0 +1,753 @@
+/**
+ * @file
+ * RadarIQ SDK - Multi-sensor processing pipeline.
+ * Runs ingest as stages on a work-stealing thread pool: byte chunks are decoded and assembled into frames, then
+ * frames are passed to user processing. Each sensor's stages run in order, different sensors run in parallel.
+ * Requires a POSIX host with C11 atomics and pthreads.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "RadarIQPipeline.h"
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+
+//===============================================================================================//
+// CONSTANTS
+//===============================================================================================//
+
+#define RADARIQ_PIPELINE_BATCH             16u       ///< Tasks a strand runs before yielding its worker to other strands
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * A strand runs one sensor's tasks of one kind in order, on whichever worker picks it up.
+ * Posting a task to an idle strand schedules it, so a strand is in at most one worker deque at a time.
+ */
+typedef struct
+{
+    atomic_uint pending;             ///< Tasks posted and not yet run, the strand is scheduled while non-zero
+    uint8_t sensor;
+    bool isProcess;                  ///< Runs process tasks rather than decode tasks
+} RadarIQPipelineStrand_t;
+
+/**
+ * A chunk of received data awaiting decode
+ */
+typedef struct
+{
+    uint8_t data[RADARIQ_PIPELINE_CHUNK_SIZE];
+    uint16_t len;
+    uint32_t submitMicros;
+} RadarIQPipelineChunk_t;
+
+/**
+ * A sensor's handle and queues. Chunks are a single-producer single-consumer ring between the submitting thread
+ * and the decode strand, frames are handed to the process strand through the sensor's frame pool.
+ */
+typedef struct
+{
+    RadarIQHandle_t radar;
+    RadarIQFramePoolHandle_t pool;
+    uint8_t consumer;
+    RadarIQPipelineChunk_t * chunks;
+    atomic_uint chunkHead;           ///< Written by the submitting thread
+    atomic_uint chunkTail;           ///< Written by the decode strand
+    RadarIQPipelineStrand_t decode;
+    RadarIQPipelineStrand_t process;
+    bool isAssembling;               ///< Decode strand only, a frame has started since the last one completed
+    uint32_t assemblyMicros;         ///< Decode strand only, submit time of the chunk that started the frame
+    uint32_t published;              ///< Decode strand only, number of frames published
+    uint32_t * publishMicros;        ///< Completion time of each frame in flight, by sequence modulo framesPerSensor
+} RadarIQPipelineSensor_t;
+
+/**
+ * A worker thread and its deque of scheduled strands.
+ * The owner pushes and pops at the tail, thieves take the oldest strand from the head.
+ */
+typedef struct
+{
+    struct RadarIQPipeline_t * pipeline;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    RadarIQPipelineStrand_t ** strands;
+    uint32_t head;
+    uint32_t tail;
+} RadarIQPipelineWorker_t;
+
+/**
+ * Lock-free statistics of one stage, updated by any worker
+ */
+typedef struct
+{
+    atomic_uint_least32_t depth;
+    atomic_uint_least32_t maxDepth;
+    atomic_uint_least64_t count;
+    atomic_uint_least64_t dropped;
+    atomic_uint_least64_t sumLatencyMicros;
+    atomic_uint_least32_t maxLatencyMicros;
+} RadarIQPipelineStageCounters_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+/**
+ * The RadarIQ pipeline object definition
+ */
+struct RadarIQPipeline_t
+{
+    RadarIQPipelineConfig_t config;
+    RadarIQPipelineSensor_t * sensors;
+    uint8_t numSensors;
+    RadarIQPipelineWorker_t * workers;
+    uint32_t dequeSize;              ///< Capacity of each worker deque, the number of strands
+
+    atomic_uint queued;              ///< Strands in all deques
+    atomic_uint sleepers;            ///< Workers waiting for a strand to be scheduled
+    pthread_mutex_t sleepLock;
+    pthread_cond_t wake;
+    atomic_bool isRunning;
+    bool isStarted;
+    uint8_t numStarted;              ///< Worker threads created, fewer than the workers if thread creation failed
+
+    RadarIQPipelineStageCounters_t stages[RADARIQ_PIPELINE_NUM_STAGES];
+};
+
+//===============================================================================================//
+// FILE-SCOPE VARIABLES
+//===============================================================================================//
+
+static _Thread_local RadarIQPipelineWorker_t * RadarIQPipeline_currentWorker = NULL;    ///< Worker of the calling thread
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTION PROTOTYPES
+//===============================================================================================//
+
+static void * RadarIQPipeline_work(void * arg);
+static void RadarIQPipeline_post(const RadarIQPipelineHandle_t obj, RadarIQPipelineStrand_t * const strand);
+static void RadarIQPipeline_schedule(const RadarIQPipelineHandle_t obj, RadarIQPipelineStrand_t * const strand);
+static RadarIQPipelineStrand_t * RadarIQPipeline_pop(RadarIQPipelineWorker_t * const worker);
+static RadarIQPipelineStrand_t * RadarIQPipeline_steal(const RadarIQPipelineHandle_t obj,
+        const RadarIQPipelineWorker_t * const thief);
+static void RadarIQPipeline_runStrand(const RadarIQPipelineHandle_t obj, RadarIQPipelineStrand_t * const strand);
+
+// Tasks
+static void RadarIQPipeline_decode(const RadarIQPipelineHandle_t obj, const uint8_t index);
+static void RadarIQPipeline_process(const RadarIQPipelineHandle_t obj, const uint8_t index);
+
+// Statistics
+static void RadarIQPipeline_enter(const RadarIQPipelineHandle_t obj, const RadarIQPipelineStage_t stage);
+static void RadarIQPipeline_leave(const RadarIQPipelineHandle_t obj, const RadarIQPipelineStage_t stage,
+        const uint32_t startMicros);
+static void RadarIQPipeline_max(atomic_uint_least32_t * const max, const uint32_t value);
+static uint32_t RadarIQPipeline_getMicros(void);
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Allocates and initializes a pipeline instance using heap allocation.
+ * Workers are not started until RadarIQPipeline_start() is called.
+ *
+ * @param config Pointer to the pipeline configuration
+ *
+ * @return A handle for an instance of the RadarIQPipeline_t object
+ */
+RadarIQPipelineHandle_t RadarIQPipeline_init(const RadarIQPipelineConfig_t * const config)
+{
+    RADARIQ_ASSERT(NULL != config);
+    RADARIQ_ASSERT(0u < config->numWorkers);
+    RADARIQ_ASSERT(0u < config->maxSensors);
+    RADARIQ_ASSERT(RADARIQ_PIPELINE_NO_SENSOR > config->maxSensors);
+    RADARIQ_ASSERT(0u < config->chunksPerSensor);
+    RADARIQ_ASSERT(RADARIQ_PIPELINE_MAX_CHUNKS >= config->chunksPerSensor);
+    RADARIQ_ASSERT(0u == (config->chunksPerSensor & (config->chunksPerSensor - 1u)));
+    RADARIQ_ASSERT(NULL != config->process);
+
+    RadarIQPipelineHandle_t handle = malloc(sizeof(RadarIQPipeline_t));
+    RADARIQ_ASSERT(NULL != handle);
+    memset((void*)handle, 0, sizeof(RadarIQPipeline_t));
+
+    handle->config = *config;
+
+    handle->sensors = malloc(sizeof(RadarIQPipelineSensor_t) * config->maxSensors);
+    RADARIQ_ASSERT(NULL != handle->sensors);
+    memset((void*)handle->sensors, 0, sizeof(RadarIQPipelineSensor_t) * config->maxSensors);
+
+    handle->dequeSize = 2u * config->maxSensors;
+    handle->workers = malloc(sizeof(RadarIQPipelineWorker_t) * config->numWorkers);
+    RADARIQ_ASSERT(NULL != handle->workers);
+    memset((void*)handle->workers, 0, sizeof(RadarIQPipelineWorker_t) * config->numWorkers);
+
+    for (uint8_t i = 0u; i < config->numWorkers; i++)
+    {
+        RadarIQPipelineWorker_t * const worker = &handle->workers[i];
+        worker->pipeline = handle;
+        pthread_mutex_init(&worker->lock, NULL);
+        worker->strands = malloc(sizeof(RadarIQPipelineStrand_t *) * handle->dequeSize);
+        RADARIQ_ASSERT(NULL != worker->strands);
+    }
+
+    atomic_init(&handle->queued, 0u);
+    atomic_init(&handle->sleepers, 0u);
+    atomic_init(&handle->isRunning, false);
+    pthread_mutex_init(&handle->sleepLock, NULL);
+    pthread_cond_init(&handle->wake, NULL);
+
+    return handle;
+}
+
+/**
+ * Stops the workers if they are running and frees a pipeline instance created by RadarIQPipeline_init().
+ * The sensors' handles are returned to parsing into their own storage.
+ *
+ * @param obj The pipeline handle returned from RadarIQPipeline_init()
+ */
+void RadarIQPipeline_destroy(const RadarIQPipelineHandle_t obj)
+{
+    if (NULL != obj)
+    {
+        RadarIQPipeline_stop(obj);
+
+        for (uint8_t i = 0u; i < obj->numSensors; i++)
+        {
+            RadarIQFramePool_destroy(obj->sensors[i].pool);
+            free(obj->sensors[i].chunks);
+            free(obj->sensors[i].publishMicros);
+        }
+
+        for (uint8_t i = 0u; i < obj->config.numWorkers; i++)
+        {
+            pthread_mutex_destroy(&obj->workers[i].lock);
+            free(obj->workers[i].strands);
+        }
+
+        pthread_mutex_destroy(&obj->sleepLock);
+        pthread_cond_destroy(&obj->wake);
+        free(obj->workers);
+        free(obj->sensors);
+        free(obj);
+    }
+}
+
+/**
+ * Adds a sensor to the pipeline. Must be called before RadarIQPipeline_start().
+ * The handle is then parsed into by the workers and must not be read from otherwise, frames are passed to the
+ * process callback instead.
+ *
+ * @param obj The pipeline handle returned from RadarIQPipeline_init()
+ * @param radar The RadarIQ object handle returned from RadarIQ_init()
+ *
+ * @return The sensor index, or ::RADARIQ_PIPELINE_NO_SENSOR if the maximum number of sensors is reached or the
+ *         pipeline has been started
+ */
+uint8_t RadarIQPipeline_addSensor(const RadarIQPipelineHandle_t obj, const RadarIQHandle_t radar)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != radar);
+
+    if ((obj->config.maxSensors <= obj->numSensors) || obj->isStarted)
+    {
+        return RADARIQ_PIPELINE_NO_SENSOR;
+    }
+
+    const uint8_t index = obj->numSensors;
+    RadarIQPipelineSensor_t * const sensor = &obj->sensors[index];
+    const RadarIQFramePoolConfig_t poolConfig = { obj->config.framesPerSensor, 1u };
+
+    sensor->radar = radar;
+    sensor->pool = RadarIQFramePool_init(&poolConfig);
+    sensor->consumer = RadarIQFramePool_addConsumer(sensor->pool);
+    RadarIQFramePool_attach(sensor->pool, radar);
+
+    sensor->chunks = malloc(sizeof(RadarIQPipelineChunk_t) * obj->config.chunksPerSensor);
+    RADARIQ_ASSERT(NULL != sensor->chunks);
+    sensor->publishMicros = malloc(sizeof(uint32_t) * obj->config.framesPerSensor);
+    RADARIQ_ASSERT(NULL != sensor->publishMicros);
+
+    atomic_init(&sensor->chunkHead, 0u);
+    atomic_init(&sensor->chunkTail, 0u);
+    atomic_init(&sensor->decode.pending, 0u);
+    atomic_init(&sensor->process.pending, 0u);
+    sensor->decode.sensor = index;
+    sensor->process.sensor = index;
+    sensor->process.isProcess = true;
+
+    obj->numSensors++;
+
+    return index;
+}
+
+/**
+ * Starts the worker threads. A pipeline can only be started once.
+ *
+ * @param obj The pipeline handle returned from RadarIQPipeline_init()
+ *
+ * @return RADARIQ_RETURN_VAL_ERR if the pipeline was already started or a thread could not be created,
+ *         otherwise RADARIQ_RETURN_VAL_OK
+ */
+RadarIQReturnVal_t RadarIQPipeline_start(const RadarIQPipelineHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    if (obj->isStarted)
+    {
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    obj->isStarted = true;
+    atomic_store(&obj->isRunning, true);
+
+    for (uint8_t i = 0u; i < obj->config.numWorkers; i++)
+    {
+        if (0 != pthread_create(&obj->workers[i].thread, NULL, RadarIQPipeline_work, (void*)&obj->workers[i]))
+        {
+            // Threads already created are joined by RadarIQPipeline_stop()
+            RadarIQPipeline_stop(obj);
+            return RADARIQ_RETURN_VAL_ERR;
+        }
+
+        obj->numStarted++;
+    }
+
+    return RADARIQ_RETURN_VAL_OK;
+}
+
+/**
+ * Stops the worker threads once they finish their current task. Queued tasks are discarded.
+ *
+ * @param obj The pipeline handle returned from RadarIQPipeline_init()
+ */
+void RadarIQPipeline_stop(const RadarIQPipelineHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    if (!atomic_exchange(&obj->isRunning, false))
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&obj->sleepLock);
+    pthread_cond_broadcast(&obj->wake);
+    pthread_mutex_unlock(&obj->sleepLock);
+
+    for (uint8_t i = 0u; i < obj->numStarted; i++)
+    {
+        pthread_join(obj->workers[i].thread, NULL);
+    }
+
+    obj->numStarted = 0u;
+}
+
+/**
+ * Queues data received from a sensor for decoding. The data is copied, so the caller's buffer can be reused.
+ *
+ * @param obj The pipeline handle returned from RadarIQPipeline_init()
+ * @param sensor The sensor index returned from RadarIQPipeline_addSensor()
+ * @param data Pointer to the received bytes
+ * @param len Number of bytes
+ *
+ * @return RADARIQ_RETURN_VAL_ERR if the sensor's chunk queue filled and data was dropped,
+ *         otherwise RADARIQ_RETURN_VAL_OK
+ */
+RadarIQReturnVal_t RadarIQPipeline_submitBytes(const RadarIQPipelineHandle_t obj, const uint8_t sensor,
+        const uint8_t * const data, const uint32_t len)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(obj->numSensors > sensor);
+    RADARIQ_ASSERT((NULL != data) || (0u == len));
+
+    RadarIQPipelineSensor_t * const state = &obj->sensors[sensor];
+    const uint32_t mask = obj->config.chunksPerSensor - 1u;
+    uint32_t offset = 0u;
+
+    while (offset < len)
+    {
+        const uint32_t head = atomic_load_explicit(&state->chunkHead, memory_order_relaxed);
+
+        if ((head - atomic_load_explicit(&state->chunkTail, memory_order_acquire)) >= obj->config.chunksPerSensor)
+        {
+            const uint32_t remaining = len - offset;
+            atomic_fetch_add_explicit(&obj->stages[RADARIQ_PIPELINE_STAGE_DECODE].dropped,
+                    (remaining + RADARIQ_PIPELINE_CHUNK_SIZE - 1u) / RADARIQ_PIPELINE_CHUNK_SIZE, memory_order_relaxed);
+            return RADARIQ_RETURN_VAL_ERR;
+        }
+
+        RadarIQPipelineChunk_t * const chunk = &state->chunks[head & mask];
+        const uint32_t chunkLen = ((len - offset) < RADARIQ_PIPELINE_CHUNK_SIZE) ? (len - offset) :
+                RADARIQ_PIPELINE_CHUNK_SIZE;
+
+        memcpy((void*)chunk->data, (const void*)&data[offset], chunkLen);
+        chunk->len = (uint16_t)chunkLen;
+        chunk->submitMicros = RadarIQPipeline_getMicros();
+        offset += chunkLen;
+
+        atomic_store_explicit(&state->chunkHead, head + 1u, memory_order_release);
+        RadarIQPipeline_enter(obj, RADARIQ_PIPELINE_STAGE_DECODE);
+        RadarIQPipeline_post(obj, &state->decode);
+    }
+
+    return RADARIQ_RETURN_VAL_OK;
+}
+
+/**
+ * Gets a copy of a stage's statistics.
+ *
+ * @param obj The pipeline handle returned from RadarIQPipeline_init()
+ * @param stage The stage
+ * @param dest Pointer to a RadarIQPipelineStageStats_t struct to copy the statistics into
+ */
+void RadarIQPipeline_getStageStats(const RadarIQPipelineHandle_t obj, const RadarIQPipelineStage_t stage,
+        RadarIQPipelineStageStats_t * const dest)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(RADARIQ_PIPELINE_NUM_STAGES > stage);
+    RADARIQ_ASSERT(NULL != dest);
+
+    const RadarIQPipelineStageCounters_t * const counters = &obj->stages[stage];
+
+    dest->depth = atomic_load_explicit(&counters->depth, memory_order_relaxed);
+    dest->maxDepth = atomic_load_explicit(&counters->maxDepth, memory_order_relaxed);
+    dest->count = atomic_load_explicit(&counters->count, memory_order_relaxed);
+    dest->dropped = atomic_load_explicit(&counters->dropped, memory_order_relaxed);
+    dest->sumLatencyMicros = atomic_load_explicit(&counters->sumLatencyMicros, memory_order_relaxed);
+    dest->maxLatencyMicros = atomic_load_explicit(&counters->maxLatencyMicros, memory_order_relaxed);
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS - Scheduling
+//===============================================================================================//
+
+/**
+ * Worker thread: runs strands from its own deque, steals from the other workers when it is empty,
+ * and sleeps while no strand is scheduled anywhere.
+ *
+ * @param arg Pointer to the worker
+ */
+static void * RadarIQPipeline_work(void * arg)
+{
+    RadarIQPipelineWorker_t * const worker = (RadarIQPipelineWorker_t *)arg;
+    const RadarIQPipelineHandle_t obj = worker->pipeline;
+
+    RadarIQPipeline_currentWorker = worker;
+
+    while (atomic_load_explicit(&obj->isRunning, memory_order_relaxed))
+    {
+        RadarIQPipelineStrand_t * strand = RadarIQPipeline_pop(worker);
+
+        if (NULL == strand)
+        {
+            strand = RadarIQPipeline_steal(obj, worker);
+        }
+
+        if (NULL != strand)
+        {
+            atomic_fetch_sub(&obj->queued, 1u);
+            RadarIQPipeline_runStrand(obj, strand);
+            continue;
+        }
+
+        // Registering as a sleeper before checking for work pairs with RadarIQPipeline_schedule() so no wakeup is lost
+        pthread_mutex_lock(&obj->sleepLock);
+        atomic_fetch_add(&obj->sleepers, 1u);
+        while ((0u == atomic_load(&obj->queued)) && atomic_load(&obj->isRunning))
+        {
+            pthread_cond_wait(&obj->wake, &obj->sleepLock);
+        }
+        atomic_fetch_sub(&obj->sleepers, 1u);
+        pthread_mutex_unlock(&obj->sleepLock);
+    }
+
+    return NULL;
+}
+
+/**
+ * Posts a task to a strand, scheduling the strand if it was idle.
+ * The task's data must be published before this is called.
+ *
+ * @param obj The pipeline handle returned from RadarIQPipeline_init()
+ * @param strand Pointer to the strand
+ */
+static void RadarIQPipeline_post(const RadarIQPipelineHandle_t obj, RadarIQPipelineStrand_t * const strand)
+{
+    if (0u == atomic_fetch_add_explicit(&strand->pending, 1u, memory_order_acq_rel))
+    {
+        RadarIQPipeline_schedule(obj, strand);
+    }
+}
+
+/**
+ * Pushes a strand onto the calling worker's deque, or the sensor's home worker when called from another thread,
+ * and wakes a sleeping worker.
+ *
+ * @param obj The pipeline handle returned from RadarIQPipeline_init()
+ * @param strand Pointer to the strand
+ */
+static void RadarIQPipeline_schedule(const RadarIQPipelineHandle_t obj, RadarIQPipelineStrand_t * const strand)
+{
+    RadarIQPipelineWorker_t * worker = RadarIQPipeline_currentWorker;
+
+    if ((NULL == worker) || (obj != worker->pipeline))
+    {
+        worker = &obj->workers[strand->sensor % obj->config.numWorkers];
+    }
+
+    pthread_mutex_lock(&worker->lock);
+    worker->strands[worker->tail % obj->dequeSize] = strand;
+    worker->tail++;
+    pthread_mutex_unlock(&worker->lock);
+
+    atomic_fetch_add(&obj->queued, 1u);
+
+    if (0u < atomic_load(&obj->sleepers))
+    {
+        pthread_mutex_lock(&obj->sleepLock);
+        pthread_cond_signal(&obj->wake);
+        pthread_mutex_unlock(&obj->sleepLock);
+    }
+}
+
+/**
+ * Takes the most recently scheduled strand from a worker's own deque.
+ *
+ * @param worker Pointer to the worker
+ *
+ * @return Pointer to the strand, or NULL if the deque is empty
+ */
+static RadarIQPipelineStrand_t * RadarIQPipeline_pop(RadarIQPipelineWorker_t * const worker)
+{
+    RadarIQPipelineStrand_t * strand = NULL;
+
+    pthread_mutex_lock(&worker->lock);
+    if (worker->head != worker->tail)
+    {
+        worker->tail--;
+        strand = worker->strands[worker->tail % worker->pipeline->dequeSize];
+    }
+    pthread_mutex_unlock(&worker->lock);
+
+    return strand;
+}
+
+/**
+ * Takes the oldest scheduled strand from another worker's deque, trying each worker in turn.
+ *
+ * @param obj The pipeline handle returned from RadarIQPipeline_init()
+ * @param thief Pointer to the calling worker
+ *
+ * @return Pointer to the strand, or NULL if every deque is empty
+ */
+static RadarIQPipelineStrand_t * RadarIQPipeline_steal(const RadarIQPipelineHandle_t obj,
+        const RadarIQPipelineWorker_t * const thief)
+{
+    const uint8_t self = (uint8_t)(thief - obj->workers);
+
+    for (uint8_t i = 1u; i < obj->config.numWorkers; i++)
+    {
+        RadarIQPipelineWorker_t * const victim = &obj->workers[(self + i) % obj->config.numWorkers];
+        RadarIQPipelineStrand_t * strand = NULL;
+
+        pthread_mutex_lock(&victim->lock);
+        if (victim->head != victim->tail)
+        {
+            strand = victim->strands[victim->head % obj->dequeSize];
+            victim->head++;
+        }
+        pthread_mutex_unlock(&victim->lock);
+
+        if (NULL != strand)
+        {
+            return strand;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Runs a batch of a strand's tasks. The strand stays scheduled while it has tasks, so it is requeued if tasks
+ * remain after the batch.
+ *
+ * @param obj The pipeline handle returned from RadarIQPipeline_init()
+ * @param strand Pointer to the strand
+ */
+static void RadarIQPipeline_runStrand(const RadarIQPipelineHandle_t obj, RadarIQPipelineStrand_t * const strand)
+{
+    for (uint8_t task = 0u; task < RADARIQ_PIPELINE_BATCH; task++)
+    {
+        if (strand->isProcess)
+        {
+            RadarIQPipeline_process(obj, strand->sensor);
+        }
+        else
+        {
+            RadarIQPipeline_decode(obj, strand->sensor);
+        }
+
+        if (1u == atomic_fetch_sub_explicit(&strand->pending, 1u, memory_order_acq_rel))
+        {
+            return;
+        }
+    }
+
+    RadarIQPipeline_schedule(obj, strand);
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS - Tasks
+//===============================================================================================//
+
+/**
+ * Decode task: parses a sensor's oldest chunk and hands each completed frame to the process strand.
+ *
+ * @param obj The pipeline handle returned from RadarIQPipeline_init()
+ * @param index The sensor index
+ */
+static void RadarIQPipeline_decode(const RadarIQPipelineHandle_t obj, const uint8_t index)
+{
+    RadarIQPipelineSensor_t * const sensor = &obj->sensors[index];
+    const uint32_t tail = atomic_load_explicit(&sensor->chunkTail, memory_order_relaxed);
+    const RadarIQPipelineChunk_t * const chunk = &sensor->chunks[tail & (obj->config.chunksPerSensor - 1u)];
+
+    for (uint16_t i = 0u; i < chunk->len; i++)
+    {
+        if (!sensor->isAssembling)
+        {
+            sensor->isAssembling = true;
+            sensor->assemblyMicros = chunk->submitMicros;
+            RadarIQPipeline_enter(obj, RADARIQ_PIPELINE_STAGE_ASSEMBLY);
+        }
+
+        const RadarIQCommand_t command = RadarIQ_processByte(sensor->radar, chunk->data[i]);
+
+        if ((RADARIQ_CMD_PNT_CLOUD_FRAME != command) && (RADARIQ_CMD_OBJ_TRACKING_FRAME != command))
+        {
+            continue;
+        }
+
+        sensor->isAssembling = false;
+        RadarIQPipeline_leave(obj, RADARIQ_PIPELINE_STAGE_ASSEMBLY, sensor->assemblyMicros);
+
+        // The slot of the next sequence is free, at most framesPerSensor - 1 frames are in flight
+        sensor->publishMicros[sensor->published % obj->config.framesPerSensor] = RadarIQPipeline_getMicros();
+
+        if (RadarIQFramePool_publish(sensor->pool, command))
+        {
+            sensor->published++;
+            RadarIQPipeline_enter(obj, RADARIQ_PIPELINE_STAGE_PROCESS);
+            RadarIQPipeline_post(obj, &sensor->process);
+        }
+        else
+        {
+            atomic_fetch_add_explicit(&obj->stages[RADARIQ_PIPELINE_STAGE_PROCESS].dropped, 1u,
+                    memory_order_relaxed);
+        }
+    }
+
+    // Releasing the chunk lets the submitting thread overwrite it, so it must not be read afterwards
+    RadarIQPipeline_leave(obj, RADARIQ_PIPELINE_STAGE_DECODE, chunk->submitMicros);
+    atomic_store_explicit(&sensor->chunkTail, tail + 1u, memory_order_release);
+}
+
+/**
+ * Process task: passes a sensor's oldest completed frame to the process callback and returns it to the pool.
+ *
+ * @param obj The pipeline handle returned from RadarIQPipeline_init()
+ * @param index The sensor index
+ */
+static void RadarIQPipeline_process(const RadarIQPipelineHandle_t obj, const uint8_t index)
+{
+    RadarIQPipelineSensor_t * const sensor = &obj->sensors[index];
+    const RadarIQFrame_t * const frame = RadarIQFramePool_take(sensor->pool, sensor->consumer);
+
+    if (NULL == frame)
+    {
+        return;
+    }
+
+    obj->config.process(obj->config.context, index, frame);
+
+    RadarIQPipeline_leave(obj, RADARIQ_PIPELINE_STAGE_PROCESS,
+            sensor->publishMicros[frame->sequence % obj->config.framesPerSensor]);
+    RadarIQFramePool_release(sensor->pool, frame);
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS - Statistics
+//===============================================================================================//
+
+/**
+ * Counts an item entering a stage.
+ *
+ * @param obj The pipeline handle returned from RadarIQPipeline_init()
+ * @param stage The stage
+ */
+static void RadarIQPipeline_enter(const RadarIQPipelineHandle_t obj, const RadarIQPipelineStage_t stage)
+{
+    RadarIQPipelineStageCounters_t * const counters = &obj->stages[stage];
+    const uint32_t depth = atomic_fetch_add_explicit(&counters->depth, 1u, memory_order_relaxed) + 1u;
+
+    RadarIQPipeline_max(&counters->maxDepth, depth);
+}
+
+/**
+ * Counts an item leaving a stage.
+ *
+ * @param obj The pipeline handle returned from RadarIQPipeline_init()
+ * @param stage The stage
+ * @param startMicros Time the item entered the stage
+ */
+static void RadarIQPipeline_leave(const RadarIQPipelineHandle_t obj, const RadarIQPipelineStage_t stage,
+        const uint32_t startMicros)
+{
+    RadarIQPipelineStageCounters_t * const counters = &obj->stages[stage];
+    const uint32_t latency = RadarIQPipeline_getMicros() - startMicros;
+
+    atomic_fetch_sub_explicit(&counters->depth, 1u, memory_order_relaxed);
+    atomic_fetch_add_explicit(&counters->count, 1u, memory_order_relaxed);
+    atomic_fetch_add_explicit(&counters->sumLatencyMicros, latency, memory_order_relaxed);
+    RadarIQPipeline_max(&counters->maxLatencyMicros, latency);
+}
+
+/**
+ * Raises a maximum shared between workers.
+ *
+ * @param max Pointer to the maximum
+ * @param value The value to raise it to
+ */
+static void RadarIQPipeline_max(atomic_uint_least32_t * const max, const uint32_t value)
+{
+    uint_least32_t current = atomic_load_explicit(max, memory_order_relaxed);
+
+    while ((current < value) &&
+            !atomic_compare_exchange_weak_explicit(max, &current, value, memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * Gets the monotonic time.
+ *
+ * @return Time in microseconds, wrapping after 71 minutes
+ */
+static uint32_t RadarIQPipeline_getMicros(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)(((uint64_t)now.tv_sec * 1000000u) + ((uint64_t)now.tv_nsec / 1000u));
+}
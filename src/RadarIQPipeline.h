@@ -0,0 +1,114 @@
+/**
+ * @file
+ * RadarIQ SDK - Multi-sensor processing pipeline.
+ * Runs ingest as stages on a work-stealing thread pool: byte chunks are decoded and assembled into frames, then
+ * frames are passed to user processing. Each sensor's stages run in order, different sensors run in parallel.
+ * Requires a POSIX host with C11 atomics and pthreads.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+#ifndef SRC_RADARIQPIPELINE_H_
+#define SRC_RADARIQPIPELINE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQ.h"
+#include "RadarIQFramePool.h"
+
+//===============================================================================================//
+// DEFINITIONS
+//===============================================================================================//
+
+#define RADARIQ_PIPELINE_CHUNK_SIZE        512u      ///< Bytes held by each queued chunk of received data
+#define RADARIQ_PIPELINE_MAX_CHUNKS        64u       ///< Largest number of chunks queued per sensor
+#define RADARIQ_PIPELINE_NO_SENSOR         0xFFu     ///< Returned by RadarIQPipeline_addSensor() when full
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Pipeline stages
+ */
+typedef enum
+{
+    RADARIQ_PIPELINE_STAGE_DECODE = 0,          ///< Byte chunks parsed by RadarIQ_processByte(), per chunk
+    RADARIQ_PIPELINE_STAGE_ASSEMBLY = 1,        ///< Frames from their first chunk to completion, per frame
+    RADARIQ_PIPELINE_STAGE_PROCESS = 2,         ///< Frames from completion to the process callback returning, per frame
+    RADARIQ_PIPELINE_NUM_STAGES = 3
+} RadarIQPipelineStage_t;
+
+/**
+ * Frame processing callback, called on a worker thread. Calls for one sensor are in frame order and never concurrent.
+ *
+ * @param context The context pointer from the pipeline configuration
+ * @param sensor The sensor index returned from RadarIQPipeline_addSensor()
+ * @param frame The frame, only valid until the callback returns
+ */
+typedef void(*RadarIQPipelineProcess_t)(void * const context, const uint8_t sensor, const RadarIQFrame_t * const frame);
+
+/**
+ * Pipeline configuration
+ */
+typedef struct
+{
+    uint8_t numWorkers;              ///< Number of worker threads
+    uint8_t maxSensors;              ///< Maximum number of sensors
+    uint8_t chunksPerSensor;         ///< Chunks queued per sensor before received data is dropped, a power of 2
+    uint8_t framesPerSensor;         ///< Frame buffers per sensor, see RadarIQFramePoolConfig_t::numBuffers
+    RadarIQPipelineProcess_t process;                ///< Frame processing callback
+    void * context;                  ///< Pointer passed to the processing callback
+} RadarIQPipelineConfig_t;
+
+/**
+ * Statistics of one stage since initialization
+ */
+typedef struct
+{
+    uint32_t depth;                  ///< Number of items currently queued or in progress
+    uint32_t maxDepth;               ///< Largest depth seen
+    uint64_t count;                  ///< Number of items completed
+    uint64_t dropped;                ///< Number of items dropped because the stage's queue was full
+    uint64_t sumLatencyMicros;       ///< Sum of the items' latencies, divide by count for the mean
+    uint32_t maxLatencyMicros;       ///< Largest latency of an item
+} RadarIQPipelineStageStats_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+typedef struct RadarIQPipeline_t RadarIQPipeline_t;
+typedef RadarIQPipeline_t* RadarIQPipelineHandle_t;
+
+//===============================================================================================//
+// FUNCTIONS
+//===============================================================================================//
+
+RadarIQPipelineHandle_t RadarIQPipeline_init(const RadarIQPipelineConfig_t * const config);
+void RadarIQPipeline_destroy(const RadarIQPipelineHandle_t obj);
+uint8_t RadarIQPipeline_addSensor(const RadarIQPipelineHandle_t obj, const RadarIQHandle_t radar);
+RadarIQReturnVal_t RadarIQPipeline_start(const RadarIQPipelineHandle_t obj);
+void RadarIQPipeline_stop(const RadarIQPipelineHandle_t obj);
+
+/* Ingest, each sensor must only be fed from one thread */
+RadarIQReturnVal_t RadarIQPipeline_submitBytes(const RadarIQPipelineHandle_t obj, const uint8_t sensor,
+        const uint8_t * const data, const uint32_t len);
+
+void RadarIQPipeline_getStageStats(const RadarIQPipelineHandle_t obj, const RadarIQPipelineStage_t stage,
+        RadarIQPipelineStageStats_t * const dest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_RADARIQPIPELINE_H_ */
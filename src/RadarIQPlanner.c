@@ -0,0 +1,337 @@
+/**
+ * @file
+ * RadarIQ SDK - UART bandwidth planner.
+ * A frame is modelled as its sub-frames plus any statistics packets. Every byte between the head and foot may be
+ * escaped, the expected share of escapes is measured from the transport counters once enough bytes have been
+ * received and starts at ::RADARIQ_PLANNER_ESCAPE_PERMILLE.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQPlanner.h"
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+/**
+ * The RadarIQ planner object definition
+ */
+struct RadarIQPlanner_t
+{
+    RadarIQPlannerConfig_t config;
+    uint16_t escapePermille;         ///< Escaped bytes per thousand decoded bytes
+    bool hasSample;                  ///< The counters below hold a previous measurement
+    uint32_t lastMillis;             ///< Time of the previous measurement
+    uint32_t lastBytesIn;            ///< Bytes received at the previous measurement
+    uint32_t lastEscapeBytesIn;      ///< Escape bytes received at the previous measurement
+};
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTION PROTOTYPES
+//===============================================================================================//
+
+static uint32_t RadarIQPlanner_divideUp(const uint64_t dividend, const uint64_t divisor);
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Allocates and initializes a planner instance using heap allocation. One instance is needed per sensor.
+ *
+ * @param config Pointer to the planner configuration
+ *
+ * @return A handle for an instance of the RadarIQPlanner_t object
+ */
+RadarIQPlannerHandle_t RadarIQPlanner_init(const RadarIQPlannerConfig_t * const config)
+{
+    RADARIQ_ASSERT(NULL != config);
+    RADARIQ_ASSERT(0u < config->baudRate);
+    RADARIQ_ASSERT(0u < config->pointsPerSubframe);
+    RADARIQ_ASSERT(0u < config->objectsPerSubframe);
+    RADARIQ_ASSERT(0u < config->maxUtilisation);
+
+    RadarIQPlannerHandle_t handle = malloc(sizeof(RadarIQPlanner_t));
+    RADARIQ_ASSERT(NULL != handle);
+    memset((void*)handle, 0, sizeof(RadarIQPlanner_t));
+
+    handle->config = *config;
+    handle->escapePermille = RADARIQ_PLANNER_ESCAPE_PERMILLE;
+
+    return handle;
+}
+
+/**
+ * Frees a planner instance created by RadarIQPlanner_init().
+ *
+ * @param obj The planner handle returned from RadarIQPlanner_init()
+ */
+void RadarIQPlanner_destroy(const RadarIQPlannerHandle_t obj)
+{
+    free(obj);
+}
+
+/**
+ * Models the link use of capture settings.
+ *
+ * @param obj The planner handle returned from RadarIQPlanner_init()
+ * @param settings Pointer to the settings to model
+ * @param dest Pointer to write the estimate to
+ *
+ * @return True if the settings fit within the configured utilisation
+ */
+bool RadarIQPlanner_estimate(const RadarIQPlannerHandle_t obj, const RadarIQPlannerSettings_t * const settings,
+        RadarIQPlannerEstimate_t * const dest)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != settings);
+    RADARIQ_ASSERT(NULL != dest);
+    RADARIQ_ASSERT(0u < settings->frameRate);
+
+    uint32_t records;
+    uint32_t recordSize;
+    uint32_t perSubframe;
+    uint32_t escapable = 0u;
+    uint32_t framing = 0u;
+    uint32_t packets = 0u;
+
+    if (RADARIQ_MODE_POINT_CLOUD == settings->mode)
+    {
+        uint32_t frames = 1u;
+        if (RADARIQ_DENSITY_DENSE == settings->density)
+        {
+            frames = RADARIQ_PLANNER_DENSE_FRAMES;
+        }
+        else if (RADARIQ_DENSITY_VERY_DENSE == settings->density)
+        {
+            frames = RADARIQ_PLANNER_VERY_DENSE_FRAMES;
+        }
+
+        records = (uint32_t)settings->count * frames;
+        if (obj->config.maxPointsPerFrame < records)
+        {
+            records = obj->config.maxPointsPerFrame;
+        }
+        recordSize = RADARIQ_PLANNER_POINT_SIZE;
+        perSubframe = obj->config.pointsPerSubframe;
+
+        if (obj->config.isPointCloudStatsEnabled)
+        {
+            escapable += RADARIQ_PLANNER_POINTCLOUD_STATS_SIZE - 2u;
+            framing += 2u;
+            packets++;
+        }
+    }
+    else
+    {
+        records = settings->count;
+        recordSize = RADARIQ_PLANNER_OBJECT_SIZE;
+        perSubframe = obj->config.objectsPerSubframe;
+    }
+
+    if (obj->config.isProcStatsEnabled)
+    {
+        escapable += RADARIQ_PLANNER_PROC_STATS_SIZE - 2u;
+        framing += 2u;
+        packets++;
+    }
+
+    // An empty frame is still sent as one END sub-frame
+    const uint32_t subframes = (0u == records) ? 1u : RadarIQPlanner_divideUp(records, perSubframe);
+    escapable += (subframes * (RADARIQ_PLANNER_SUBFRAME_OVERHEAD - 2u)) + (records * recordSize);
+    framing += subframes * 2u;
+    packets += subframes;
+
+    const uint32_t escapes = RadarIQPlanner_divideUp((uint64_t)escapable * obj->escapePermille, 1000u);
+    const uint32_t periodMicros = 1000000u / settings->frameRate;
+
+    dest->records = (uint16_t)records;
+    dest->packets = (uint16_t)packets;
+    dest->frameBytes = framing + escapable + escapes;
+    dest->worstCaseBytes = framing + (escapable * 2u);
+    dest->frameMicros = RadarIQPlanner_divideUp((uint64_t)dest->frameBytes * RADARIQ_PLANNER_BITS_PER_BYTE * 1000000u,
+            obj->config.baudRate);
+    dest->periodMicros = periodMicros;
+
+    const uint32_t utilisation = RadarIQPlanner_divideUp((uint64_t)dest->frameMicros * 100u, periodMicros);
+    dest->utilisation = (UINT8_MAX < utilisation) ? UINT8_MAX : (uint8_t)utilisation;
+    dest->isWithinBudget = (utilisation <= obj->config.maxUtilisation);
+
+    return dest->isWithinBudget;
+}
+
+/**
+ * Finds the highest frame rate the link carries with the other settings unchanged.
+ *
+ * @param obj The planner handle returned from RadarIQPlanner_init()
+ * @param settings Pointer to the settings, the frame rate is ignored
+ *
+ * @return The highest frame rate that fits within the configured utilisation, or 0 if even
+ *         ::RADARIQ_MIN_FRAME_RATE does not fit
+ */
+uint8_t RadarIQPlanner_getMaxFrameRate(const RadarIQPlannerHandle_t obj,
+        const RadarIQPlannerSettings_t * const settings)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != settings);
+
+    RadarIQPlannerSettings_t candidate = *settings;
+    RadarIQPlannerEstimate_t estimate;
+
+    for (candidate.frameRate = RADARIQ_MAX_FRAME_RATE; RADARIQ_MIN_FRAME_RATE <= candidate.frameRate;
+            candidate.frameRate--)
+    {
+        if (RadarIQPlanner_estimate(obj, &candidate, &estimate))
+        {
+            return candidate.frameRate;
+        }
+    }
+
+    return 0u;
+}
+
+/**
+ * Lowers settings until they fit within the configured utilisation. The frame rate is lowered first, then in
+ * point-cloud mode the point density, keeping the highest frame rate that fits at each density.
+ *
+ * @param obj The planner handle returned from RadarIQPlanner_init()
+ * @param settings Pointer to the settings to fit, updated in place
+ *
+ * @return RADARIQ_RETURN_VAL_OK if the settings fit unchanged, RADARIQ_RETURN_VAL_WARNING if they were lowered,
+ *         or RADARIQ_RETURN_VAL_ERR if nothing fits and they were left at the lowest settings
+ */
+RadarIQReturnVal_t RadarIQPlanner_fit(const RadarIQPlannerHandle_t obj, RadarIQPlannerSettings_t * const settings)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != settings);
+
+    RadarIQReturnVal_t ret = RADARIQ_RETURN_VAL_OK;
+
+    if (RADARIQ_MIN_FRAME_RATE > settings->frameRate)
+    {
+        settings->frameRate = RADARIQ_MIN_FRAME_RATE;
+        ret = RADARIQ_RETURN_VAL_WARNING;
+    }
+    else if (RADARIQ_MAX_FRAME_RATE < settings->frameRate)
+    {
+        settings->frameRate = RADARIQ_MAX_FRAME_RATE;
+        ret = RADARIQ_RETURN_VAL_WARNING;
+    }
+
+    RadarIQPlannerEstimate_t estimate;
+    if (RadarIQPlanner_estimate(obj, settings, &estimate))
+    {
+        return ret;
+    }
+
+    while (true)
+    {
+        const uint8_t frameRate = RadarIQPlanner_getMaxFrameRate(obj, settings);
+        if (0u < frameRate)
+        {
+            // A lower density may fit faster than requested, the requested rate is kept as the limit
+            if (frameRate < settings->frameRate)
+            {
+                settings->frameRate = frameRate;
+            }
+            return RADARIQ_RETURN_VAL_WARNING;
+        }
+
+        if ((RADARIQ_MODE_POINT_CLOUD != settings->mode) || (RADARIQ_DENSITY_NORMAL == settings->density))
+        {
+            break;
+        }
+
+        settings->density = (RadarIQPointDensity_t)(settings->density - 1);
+    }
+
+    settings->frameRate = RADARIQ_MIN_FRAME_RATE;
+
+    return RADARIQ_RETURN_VAL_ERR;
+}
+
+/**
+ * Measures the link utilisation since the previous call from the radar's transport counters, and updates the
+ * escape rate used by later estimates. Should be called periodically, e.g. once a second.
+ *
+ * @param obj The planner handle returned from RadarIQPlanner_init()
+ * @param radar The RadarIQ object handle of the sensor on the link
+ * @param nowMillis Current time in milliseconds
+ * @param dest Pointer to write the measurement to
+ *
+ * @return False if this is the first call or no time has passed, when dest is not written
+ */
+bool RadarIQPlanner_measure(const RadarIQPlannerHandle_t obj, const RadarIQHandle_t radar, const uint32_t nowMillis,
+        RadarIQPlannerMeasurement_t * const dest)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != radar);
+    RADARIQ_ASSERT(NULL != dest);
+
+    RadarIQTransportStats_t stats;
+    RadarIQ_getTransportStats(radar, &stats);
+
+    // Unsigned differences stay correct across counter and clock wrap-around
+    const uint32_t elapsed = nowMillis - obj->lastMillis;
+    const uint32_t bytes = stats.counters.bytesIn - obj->lastBytesIn;
+    const uint32_t escapes = stats.counters.escapeBytesIn - obj->lastEscapeBytesIn;
+    const bool hasSample = obj->hasSample;
+
+    if (hasSample && (0u == elapsed))
+    {
+        return false;
+    }
+
+    obj->hasSample = true;
+    obj->lastMillis = nowMillis;
+    obj->lastBytesIn = stats.counters.bytesIn;
+    obj->lastEscapeBytesIn = stats.counters.escapeBytesIn;
+
+    if (!hasSample)
+    {
+        return false;
+    }
+
+    if ((RADARIQ_PLANNER_MIN_SAMPLE_BYTES <= bytes) && (escapes < bytes))
+    {
+        obj->escapePermille = (uint16_t)(((uint64_t)escapes * 1000u) / (bytes - escapes));
+    }
+
+    dest->bytesPerSecond = (uint32_t)(((uint64_t)bytes * 1000u) / elapsed);
+    dest->capacityBytesPerSecond = obj->config.baudRate / RADARIQ_PLANNER_BITS_PER_BYTE;
+
+    const uint32_t utilisation = RadarIQPlanner_divideUp((uint64_t)dest->bytesPerSecond * 100u,
+            dest->capacityBytesPerSecond);
+    dest->utilisation = (UINT8_MAX < utilisation) ? UINT8_MAX : (uint8_t)utilisation;
+    dest->escapePermille = obj->escapePermille;
+    dest->isWithinBudget = (utilisation <= obj->config.maxUtilisation);
+
+    return true;
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Divides rounding up, so estimates err towards saturation.
+ *
+ * @param dividend The dividend
+ * @param divisor The divisor, non-zero
+ *
+ * @return The quotient rounded up, limited to UINT32_MAX
+ */
+static uint32_t RadarIQPlanner_divideUp(const uint64_t dividend, const uint64_t divisor)
+{
+    const uint64_t quotient = (dividend + divisor - 1u) / divisor;
+
+    return (UINT32_MAX < quotient) ? UINT32_MAX : (uint32_t)quotient;
+}
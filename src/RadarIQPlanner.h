@@ -0,0 +1,124 @@
+/**
+ * @file
+ * RadarIQ SDK - UART bandwidth planner.
+ * Models the bytes each frame puts on the UART for a capture mode, point density, expected point or object count
+ * and frame rate, including sub-frame headers, CRCs, framing bytes and escapes, and measures the link utilisation
+ * actually seen from the transport counters. Settings can be checked, or lowered until they fit, before the link
+ * saturates and frames queue up behind each other.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+#ifndef SRC_RADARIQPLANNER_H_
+#define SRC_RADARIQPLANNER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQ.h"
+
+//===============================================================================================//
+// DEFINITIONS
+//===============================================================================================//
+
+#define RADARIQ_PLANNER_BITS_PER_BYTE          10u       ///< UART bits per byte with 8N1 framing
+#define RADARIQ_PLANNER_POINT_SIZE             9u        ///< Bytes of one point in a point-cloud sub-frame
+#define RADARIQ_PLANNER_OBJECT_SIZE            19u       ///< Bytes of one object in an object-tracking sub-frame
+#define RADARIQ_PLANNER_SUBFRAME_OVERHEAD      8u        ///< Head, command, variant, sub-frame type, count, CRC and foot bytes of a sub-frame
+#define RADARIQ_PLANNER_PROC_STATS_SIZE        54u       ///< Bytes of a processing statistics packet before escaping
+#define RADARIQ_PLANNER_POINTCLOUD_STATS_SIZE  32u       ///< Bytes of a point-cloud statistics packet before escaping
+#define RADARIQ_PLANNER_DENSE_FRAMES           2u        ///< Captured frames assumed aggregated into one frame at ::RADARIQ_DENSITY_DENSE
+#define RADARIQ_PLANNER_VERY_DENSE_FRAMES      4u        ///< Captured frames assumed aggregated into one frame at ::RADARIQ_DENSITY_VERY_DENSE
+#define RADARIQ_PLANNER_ESCAPE_PERMILLE        12u       ///< Escaped bytes per thousand assumed until measured, 3 of 256 byte values are escaped
+#define RADARIQ_PLANNER_MIN_SAMPLE_BYTES       1024u     ///< Fewest bytes received before a measurement updates the escape rate
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Planner configuration
+ */
+typedef struct
+{
+    uint32_t baudRate;               ///< UART baud rate
+    uint8_t pointsPerSubframe;       ///< Most points the device sends in one point-cloud sub-frame
+    uint8_t objectsPerSubframe;      ///< Most objects the device sends in one object-tracking sub-frame
+    uint16_t maxPointsPerFrame;      ///< Points per frame the device truncates to
+    bool isProcStatsEnabled;         ///< The device sends processing statistics with every frame
+    bool isPointCloudStatsEnabled;   ///< The device sends point-cloud statistics with every point-cloud frame
+    uint8_t maxUtilisation;          ///< Percentage of the link a plan may use, leaving the rest for responses and bursts
+} RadarIQPlannerConfig_t;
+
+/**
+ * Capture settings to plan for
+ */
+typedef struct
+{
+    RadarIQCaptureMode_t mode;       ///< Capture mode
+    RadarIQPointDensity_t density;   ///< Point density, point-cloud mode only
+    uint16_t count;                  ///< Expected points per captured frame in point-cloud mode, or objects per frame
+    uint8_t frameRate;               ///< Frame rate in frames/second
+} RadarIQPlannerSettings_t;
+
+/**
+ * Modelled link use of some settings
+ */
+typedef struct
+{
+    uint16_t records;                ///< Points or objects sent per frame after aggregation and truncation
+    uint16_t packets;                ///< Packets sent per frame, including statistics
+    uint32_t frameBytes;             ///< Bytes on the wire per frame with the expected escapes
+    uint32_t worstCaseBytes;         ///< Bytes on the wire per frame if every escapable byte is escaped
+    uint32_t frameMicros;            ///< Time to send one frame in microseconds
+    uint32_t periodMicros;           ///< Frame period in microseconds
+    uint8_t utilisation;             ///< Percentage of the link used, limited to 255
+    bool isWithinBudget;             ///< Utilisation is at most the configured maximum
+} RadarIQPlannerEstimate_t;
+
+/**
+ * Measured link use
+ */
+typedef struct
+{
+    uint32_t bytesPerSecond;         ///< Bytes received per second over the last interval
+    uint32_t capacityBytesPerSecond; ///< Bytes the link carries per second
+    uint8_t utilisation;             ///< Percentage of the link used over the last interval, limited to 255
+    uint16_t escapePermille;         ///< Escaped bytes per thousand decoded bytes, used by later estimates
+    bool isWithinBudget;             ///< Utilisation is at most the configured maximum
+} RadarIQPlannerMeasurement_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+typedef struct RadarIQPlanner_t RadarIQPlanner_t;
+typedef RadarIQPlanner_t* RadarIQPlannerHandle_t;
+
+//===============================================================================================//
+// FUNCTIONS
+//===============================================================================================//
+
+RadarIQPlannerHandle_t RadarIQPlanner_init(const RadarIQPlannerConfig_t * const config);
+void RadarIQPlanner_destroy(const RadarIQPlannerHandle_t obj);
+bool RadarIQPlanner_estimate(const RadarIQPlannerHandle_t obj, const RadarIQPlannerSettings_t * const settings,
+        RadarIQPlannerEstimate_t * const dest);
+uint8_t RadarIQPlanner_getMaxFrameRate(const RadarIQPlannerHandle_t obj,
+        const RadarIQPlannerSettings_t * const settings);
+RadarIQReturnVal_t RadarIQPlanner_fit(const RadarIQPlannerHandle_t obj, RadarIQPlannerSettings_t * const settings);
+bool RadarIQPlanner_measure(const RadarIQPlannerHandle_t obj, const RadarIQHandle_t radar, const uint32_t nowMillis,
+        RadarIQPlannerMeasurement_t * const dest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_RADARIQPLANNER_H_ */
@@ -0,0 +1,283 @@
+/**
+ * @file
+ * RadarIQ SDK - Raw data spooling.
+ * Records are gathered in a heap buffer and written when the next one would not fit. The file is unbuffered by the
+ * C library so each write goes to the file system whole. Chunks larger than the buffer are written directly.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQRawSpool.h"
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+/**
+ * The RadarIQ raw spool object definition
+ */
+struct RadarIQRawSpool_t
+{
+    RadarIQRawSpoolConfig_t config;
+    FILE * file;                     ///< Spool file, NULL when closed
+    bool isFailed;                   ///< A write failed, chunks are dropped until the file is reopened
+    uint8_t * buffer;                ///< Records waiting to be written
+    uint32_t bufferLen;
+    RadarIQRawSpoolStats_t stats;
+};
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTION PROTOTYPES
+//===============================================================================================//
+
+static bool RadarIQRawSpool_write(const RadarIQRawSpoolHandle_t obj, const uint8_t * const data, const uint32_t len);
+static void RadarIQRawSpool_pack32(const uint32_t data, uint8_t * const dest);
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Allocates and initializes a raw spool instance using heap allocation.
+ * The file is not created until RadarIQRawSpool_open() is called.
+ *
+ * @param config Pointer to the spool configuration
+ *
+ * @return A handle for an instance of the RadarIQRawSpool_t object
+ */
+RadarIQRawSpoolHandle_t RadarIQRawSpool_init(const RadarIQRawSpoolConfig_t * const config)
+{
+    RADARIQ_ASSERT(NULL != config);
+    RADARIQ_ASSERT(NULL != config->path);
+    RADARIQ_ASSERT(RADARIQ_RAWSPOOL_MIN_BUFFER <= config->bufferSize);
+
+    RadarIQRawSpoolHandle_t handle = malloc(sizeof(RadarIQRawSpool_t));
+    RADARIQ_ASSERT(NULL != handle);
+    memset((void*)handle, 0, sizeof(RadarIQRawSpool_t));
+
+    handle->config = *config;
+
+    handle->buffer = malloc(config->bufferSize);
+    RADARIQ_ASSERT(NULL != handle->buffer);
+
+    return handle;
+}
+
+/**
+ * Closes the file if it is open and frees a raw spool instance created by RadarIQRawSpool_init().
+ *
+ * @param obj The raw spool handle returned from RadarIQRawSpool_init()
+ */
+void RadarIQRawSpool_destroy(const RadarIQRawSpoolHandle_t obj)
+{
+    if (NULL != obj)
+    {
+        (void)RadarIQRawSpool_close(obj);
+        free(obj->buffer);
+        free(obj);
+    }
+}
+
+/**
+ * Creates the spool file, replacing any existing file.
+ *
+ * @param obj The raw spool handle returned from RadarIQRawSpool_init()
+ *
+ * @return RADARIQ_RETURN_VAL_ERR if the file could not be created, otherwise RADARIQ_RETURN_VAL_OK
+ */
+RadarIQReturnVal_t RadarIQRawSpool_open(const RadarIQRawSpoolHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    if (NULL != obj->file)
+    {
+        return RADARIQ_RETURN_VAL_OK;
+    }
+
+    obj->file = fopen(obj->config.path, "wb");
+    if (NULL == obj->file)
+    {
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    // Writes are already gathered in the spool buffer
+    (void)setvbuf(obj->file, NULL, _IONBF, 0u);
+
+    obj->isFailed = false;
+    obj->bufferLen = 0u;
+
+    return RADARIQ_RETURN_VAL_OK;
+}
+
+/**
+ * Writes any buffered records and closes the spool file.
+ *
+ * @param obj The raw spool handle returned from RadarIQRawSpool_init()
+ *
+ * @return RADARIQ_RETURN_VAL_ERR if a write failed since the file was opened, otherwise RADARIQ_RETURN_VAL_OK
+ */
+RadarIQReturnVal_t RadarIQRawSpool_close(const RadarIQRawSpoolHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    if (NULL == obj->file)
+    {
+        return RADARIQ_RETURN_VAL_OK;
+    }
+
+    RadarIQReturnVal_t ret = RadarIQRawSpool_flush(obj);
+
+    if (0 != fclose(obj->file))
+    {
+        ret = RADARIQ_RETURN_VAL_ERR;
+    }
+    obj->file = NULL;
+
+    return ret;
+}
+
+/**
+ * Writes any buffered records to the spool file, e.g. when capture pauses.
+ *
+ * @param obj The raw spool handle returned from RadarIQRawSpool_init()
+ *
+ * @return RADARIQ_RETURN_VAL_ERR if the file is not open or a write failed since it was opened,
+ *         otherwise RADARIQ_RETURN_VAL_OK
+ */
+RadarIQReturnVal_t RadarIQRawSpool_flush(const RadarIQRawSpoolHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    if ((NULL == obj->file) || obj->isFailed)
+    {
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    if (!RadarIQRawSpool_write(obj, obj->buffer, obj->bufferLen))
+    {
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+    obj->bufferLen = 0u;
+
+    return RADARIQ_RETURN_VAL_OK;
+}
+
+/**
+ * Raw data callback storing a chunk as a record, pass to RadarIQ_setRawDataCallback() with the spool handle as
+ * the context.
+ *
+ * @param context The raw spool handle returned from RadarIQRawSpool_init()
+ * @param chunk The chunk to store
+ */
+void RadarIQRawSpool_onChunk(void * const context, const RadarIQRawChunk_t * const chunk)
+{
+    RADARIQ_ASSERT(NULL != context);
+    RADARIQ_ASSERT(NULL != chunk);
+
+    const RadarIQRawSpoolHandle_t obj = (RadarIQRawSpoolHandle_t)context;
+
+    if ((NULL == obj->file) || obj->isFailed)
+    {
+        obj->stats.dropped++;
+        return;
+    }
+
+    const uint32_t recordSize = RADARIQ_RAWSPOOL_HEADER_SIZE + chunk->len;
+    if (((obj->config.bufferSize - obj->bufferLen) < recordSize) && (RADARIQ_RETURN_VAL_OK != RadarIQRawSpool_flush(obj)))
+    {
+        obj->stats.dropped++;
+        return;
+    }
+
+    uint8_t * const header = &obj->buffer[obj->bufferLen];
+    RadarIQRawSpool_pack32(RADARIQ_RAWSPOOL_MAGIC, &header[0]);
+    RadarIQRawSpool_pack32(chunk->sequence, &header[4]);
+    RadarIQRawSpool_pack32(chunk->offset, &header[8]);
+    header[12] = (uint8_t)(chunk->len & 0xFFu);
+    header[13] = (uint8_t)(chunk->len >> 8u);
+    header[14] = (chunk->isLast ? RADARIQ_RAWSPOOL_FLAG_LAST : 0u) | (chunk->isValid ? RADARIQ_RAWSPOOL_FLAG_VALID : 0u);
+    header[15] = 0u;
+    obj->bufferLen += RADARIQ_RAWSPOOL_HEADER_SIZE;
+
+    if ((obj->config.bufferSize - obj->bufferLen) >= chunk->len)
+    {
+        memcpy((void*)&obj->buffer[obj->bufferLen], (const void*)chunk->data, chunk->len);
+        obj->bufferLen += chunk->len;
+    }
+    // A chunk larger than the buffer is written directly after its header
+    else if ((RADARIQ_RETURN_VAL_OK != RadarIQRawSpool_flush(obj)) ||
+            !RadarIQRawSpool_write(obj, chunk->data, chunk->len))
+    {
+        obj->stats.dropped++;
+        return;
+    }
+
+    obj->stats.records++;
+}
+
+/**
+ * Gets the spool statistics.
+ *
+ * @param obj The raw spool handle returned from RadarIQRawSpool_init()
+ * @param dest Pointer to a RadarIQRawSpoolStats_t struct to copy the statistics into
+ */
+void RadarIQRawSpool_getStats(const RadarIQRawSpoolHandle_t obj, RadarIQRawSpoolStats_t * const dest)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != dest);
+
+    *dest = obj->stats;
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Writes bytes to the spool file, marking the spool failed if they are not all written.
+ *
+ * @param obj The raw spool handle returned from RadarIQRawSpool_init()
+ * @param data The bytes to write
+ * @param len The number of bytes
+ *
+ * @return True if every byte was written
+ */
+static bool RadarIQRawSpool_write(const RadarIQRawSpoolHandle_t obj, const uint8_t * const data, const uint32_t len)
+{
+    if (0u == len)
+    {
+        return true;
+    }
+
+    if (len != fwrite((const void*)data, 1u, len, obj->file))
+    {
+        obj->isFailed = true;
+        return false;
+    }
+
+    obj->stats.bytes += len;
+    obj->stats.writes++;
+
+    return true;
+}
+
+/**
+ * Packs a 32-bit value into 4 bytes, little-endian.
+ *
+ * @param data The value
+ * @param dest Pointer to the 4 destination bytes
+ */
+static void RadarIQRawSpool_pack32(const uint32_t data, uint8_t * const dest)
+{
+    dest[0] = (uint8_t)(data & 0xFFu);
+    dest[1] = (uint8_t)((data >> 8u) & 0xFFu);
+    dest[2] = (uint8_t)((data >> 16u) & 0xFFu);
+    dest[3] = (uint8_t)(data >> 24u);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file
+ * RadarIQ SDK - Raw data spooling.
+ * Writes the chunks streamed by RadarIQ_setRawDataCallback() straight to a file, gathered into large sequential
+ * writes so capture is not held up by the file system. Each chunk is stored as a record that offline tools can
+ * reassemble into packets.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+#ifndef SRC_RADARIQRAWSPOOL_H_
+#define SRC_RADARIQRAWSPOOL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQ.h"
+
+//===============================================================================================//
+// DEFINITIONS
+//===============================================================================================//
+
+#define RADARIQ_RAWSPOOL_MAGIC             0x52514952uL    ///< "RIQR" little-endian, first 4 bytes of every record
+#define RADARIQ_RAWSPOOL_MIN_BUFFER        4096u     ///< Smallest write buffer in bytes
+
+/**
+ * Record layout, all fields little-endian:
+ * magic u32, sequence u32, offset u32, len u16, flags u8, reserved u8, then len payload bytes.
+ * Fields are those of the RadarIQRawChunk_t the record was written from.
+ */
+#define RADARIQ_RAWSPOOL_HEADER_SIZE       16u       ///< Size of a record header in bytes
+#define RADARIQ_RAWSPOOL_FLAG_LAST         0x01u     ///< Record flag, the chunk is the last of its packet
+#define RADARIQ_RAWSPOOL_FLAG_VALID        0x02u     ///< Record flag, the packet's CRC matched
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Spool configuration
+ */
+typedef struct
+{
+    const char * path;               ///< Path of the file to write, replaced if it already exists
+    uint32_t bufferSize;             ///< Bytes gathered before each write, at least ::RADARIQ_RAWSPOOL_MIN_BUFFER
+} RadarIQRawSpoolConfig_t;
+
+/**
+ * Spool statistics
+ */
+typedef struct
+{
+    uint32_t records;                ///< Number of records written or buffered
+    uint64_t bytes;                  ///< Number of bytes written to the file
+    uint32_t writes;                 ///< Number of writes to the file
+    uint32_t dropped;                ///< Number of chunks dropped because the file is not open or a write failed
+} RadarIQRawSpoolStats_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+typedef struct RadarIQRawSpool_t RadarIQRawSpool_t;
+typedef RadarIQRawSpool_t* RadarIQRawSpoolHandle_t;
+
+//===============================================================================================//
+// FUNCTIONS
+//===============================================================================================//
+
+RadarIQRawSpoolHandle_t RadarIQRawSpool_init(const RadarIQRawSpoolConfig_t * const config);
+void RadarIQRawSpool_destroy(const RadarIQRawSpoolHandle_t obj);
+RadarIQReturnVal_t RadarIQRawSpool_open(const RadarIQRawSpoolHandle_t obj);
+RadarIQReturnVal_t RadarIQRawSpool_close(const RadarIQRawSpoolHandle_t obj);
+RadarIQReturnVal_t RadarIQRawSpool_flush(const RadarIQRawSpoolHandle_t obj);
+void RadarIQRawSpool_onChunk(void * const context, const RadarIQRawChunk_t * const chunk);
+void RadarIQRawSpool_getStats(const RadarIQRawSpoolHandle_t obj, RadarIQRawSpoolStats_t * const dest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_RADARIQRAWSPOOL_H_ */
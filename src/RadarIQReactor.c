@@ -0,0 +1,544 @@
+/**
+ * @file
+ * RadarIQ SDK - Multi-sensor I/O reactor.
+ * Drives many RadarIQ handles from one thread: waits on all their transports with a single poll(), feeds each
+ * handle the bytes read in bulk and dispatches packets to handlers. Command timeouts are kept in a timer wheel.
+ * Requires a POSIX host, each transport must be a file descriptor such as a serial port or socket.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "RadarIQReactor.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+
+//===============================================================================================//
+// CONSTANTS
+//===============================================================================================//
+
+#define RADARIQ_REACTOR_READ_SIZE          4096u     ///< Bytes read from a transport per wakeup
+#define RADARIQ_REACTOR_NO_TIMER           0xFFu     ///< End of a timer wheel slot's list
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * A sensor driven by the reactor
+ */
+typedef struct
+{
+    RadarIQHandle_t radar;
+    int fd;
+    RadarIQReactorHandler_t handler;
+    void * context;
+    bool isOpen;
+
+    bool isTimerArmed;               ///< A command is awaiting its response
+    RadarIQCommand_t timerCommand;   ///< The command awaiting its response
+    uint32_t timerDeadline;          ///< Tick the command times out at
+    uint8_t timerNext;               ///< Next sensor in the timer's wheel slot
+    uint8_t timerPrev;               ///< Previous sensor in the timer's wheel slot
+} RadarIQReactorSensor_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+/**
+ * The RadarIQ reactor object definition
+ */
+struct RadarIQReactor_t
+{
+    RadarIQReactorConfig_t config;
+    RadarIQReactorSensor_t * sensors;
+    struct pollfd * pollFds;         ///< One per sensor, closed sensors have a negative fd so poll() skips them
+    uint8_t numSensors;
+    uint8_t * readBuffer;
+
+    uint8_t wheel[RADARIQ_REACTOR_WHEEL_SLOTS];     ///< First sensor of each slot's timer list
+    uint16_t numTimers;
+    uint32_t tick;                   ///< Ticks processed since initialization
+    uint32_t epochMillis;            ///< Monotonic time of tick 0
+};
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTION PROTOTYPES
+//===============================================================================================//
+
+static void RadarIQReactor_send(void * const context, uint8_t * const data, const uint16_t len);
+static int32_t RadarIQReactor_read(const RadarIQReactorHandle_t obj, const uint8_t index);
+static void RadarIQReactor_close(const RadarIQReactorHandle_t obj, const uint8_t index);
+static uint32_t RadarIQReactor_getMillis(void);
+static uint32_t RadarIQReactor_getTick(const RadarIQReactorHandle_t obj);
+
+// Timer wheel
+static void RadarIQReactor_armTimer(const RadarIQReactorHandle_t obj, const uint8_t index, const uint32_t deadline);
+static void RadarIQReactor_cancelTimer(const RadarIQReactorHandle_t obj, const uint8_t index);
+static int32_t RadarIQReactor_advanceTimers(const RadarIQReactorHandle_t obj);
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Allocates and initializes a reactor instance using heap allocation.
+ *
+ * @param config Pointer to the reactor configuration
+ *
+ * @return A handle for an instance of the RadarIQReactor_t object
+ */
+RadarIQReactorHandle_t RadarIQReactor_init(const RadarIQReactorConfig_t * const config)
+{
+    RADARIQ_ASSERT(NULL != config);
+    RADARIQ_ASSERT(0u < config->maxSensors);
+    RADARIQ_ASSERT(RADARIQ_REACTOR_NO_SENSOR > config->maxSensors);
+    RADARIQ_ASSERT(0u < config->tickMillis);
+
+    RadarIQReactorHandle_t handle = malloc(sizeof(RadarIQReactor_t));
+    RADARIQ_ASSERT(NULL != handle);
+    memset((void*)handle, 0, sizeof(RadarIQReactor_t));
+
+    handle->config = *config;
+
+    handle->sensors = malloc(sizeof(RadarIQReactorSensor_t) * config->maxSensors);
+    RADARIQ_ASSERT(NULL != handle->sensors);
+    memset((void*)handle->sensors, 0, sizeof(RadarIQReactorSensor_t) * config->maxSensors);
+
+    handle->pollFds = malloc(sizeof(struct pollfd) * config->maxSensors);
+    RADARIQ_ASSERT(NULL != handle->pollFds);
+
+    handle->readBuffer = malloc(RADARIQ_REACTOR_READ_SIZE);
+    RADARIQ_ASSERT(NULL != handle->readBuffer);
+
+    memset((void*)handle->wheel, RADARIQ_REACTOR_NO_TIMER, sizeof(handle->wheel));
+    handle->epochMillis = RadarIQReactor_getMillis();
+
+    return handle;
+}
+
+/**
+ * Frees a reactor instance created by RadarIQReactor_init(). The sensors' file descriptors are not closed and their
+ * handles are returned to the send callback passed to RadarIQ_init().
+ *
+ * @param obj The reactor handle returned from RadarIQReactor_init()
+ */
+void RadarIQReactor_destroy(const RadarIQReactorHandle_t obj)
+{
+    if (NULL != obj)
+    {
+        for (uint8_t i = 0u; i < obj->numSensors; i++)
+        {
+            RadarIQ_setSendCallback(obj->sensors[i].radar, NULL, NULL);
+        }
+        free(obj->sensors);
+        free(obj->pollFds);
+        free(obj->readBuffer);
+        free(obj);
+    }
+}
+
+/**
+ * Adds a sensor to the reactor. The file descriptor is made non-blocking and the handle's commands are sent to it.
+ * The handle must then only be used from the reactor thread, and its blocking UART command functions must not be
+ * used as they read with the RadarIQ_init() callback, commands are sent with RadarIQReactor_sendCommand() instead.
+ *
+ * @param obj The reactor handle returned from RadarIQReactor_init()
+ * @param radar The RadarIQ object handle returned from RadarIQ_init()
+ * @param fd File descriptor of the sensor's transport
+ * @param handler Function called with the sensor's events
+ * @param context Pointer passed to the handler
+ *
+ * @return The sensor index, or ::RADARIQ_REACTOR_NO_SENSOR if the maximum number of sensors is reached
+ */
+uint8_t RadarIQReactor_addSensor(const RadarIQReactorHandle_t obj, const RadarIQHandle_t radar, const int fd,
+        const RadarIQReactorHandler_t handler, void * const context)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != radar);
+    RADARIQ_ASSERT(0 <= fd);
+    RADARIQ_ASSERT(NULL != handler);
+
+    if (obj->config.maxSensors <= obj->numSensors)
+    {
+        return RADARIQ_REACTOR_NO_SENSOR;
+    }
+
+    const int flags = fcntl(fd, F_GETFL);
+    if ((0 > flags) || (0 > fcntl(fd, F_SETFL, flags | O_NONBLOCK)))
+    {
+        return RADARIQ_REACTOR_NO_SENSOR;
+    }
+
+    const uint8_t index = obj->numSensors;
+    RadarIQReactorSensor_t * const sensor = &obj->sensors[index];
+
+    sensor->radar = radar;
+    sensor->fd = fd;
+    sensor->handler = handler;
+    sensor->context = context;
+    sensor->isOpen = true;
+
+    obj->pollFds[index].fd = fd;
+    obj->pollFds[index].events = POLLIN;
+    obj->pollFds[index].revents = 0;
+
+    RadarIQ_setSendCallback(radar, RadarIQReactor_send, (void*)sensor);
+    obj->numSensors++;
+
+    return index;
+}
+
+/**
+ * Sends a command to a sensor. The handler is called with ::RADARIQ_REACTOR_EVENT_RESPONSE when the response
+ * arrives, or with ::RADARIQ_REACTOR_EVENT_TIMEOUT if it has not arrived after the timeout.
+ * Only one command per sensor may await its response at a time.
+ *
+ * @param obj The reactor handle returned from RadarIQReactor_init()
+ * @param sensor The sensor index returned from RadarIQReactor_addSensor()
+ * @param command The command to send
+ * @param variant The command variant
+ * @param payload Pointer to the command's parameters, may be NULL if len is 0
+ * @param len Number of parameter bytes, at most ::RADARIQ_MAX_COMMAND_PAYLOAD
+ * @param timeoutMillis Time to wait for the response in milliseconds
+ *
+ * @return ::RADARIQ_RETURN_VAL_ERR if the sensor is closed, already awaiting a response or the payload is too long,
+ * otherwise ::RADARIQ_RETURN_VAL_OK
+ */
+RadarIQReturnVal_t RadarIQReactor_sendCommand(const RadarIQReactorHandle_t obj, const uint8_t sensor,
+        const RadarIQCommand_t command, const RadarIQCommandVariant_t variant, const uint8_t * const payload,
+        const uint8_t len, const uint32_t timeoutMillis)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(obj->numSensors > sensor);
+
+    RadarIQReactorSensor_t * const state = &obj->sensors[sensor];
+
+    if ((!state->isOpen) || state->isTimerArmed)
+    {
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    if (RADARIQ_RETURN_VAL_OK != RadarIQ_sendCommand(state->radar, command, variant, payload, len))
+    {
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    // The wheel may not have advanced since poll() returned, so the deadline is counted from the current time.
+    // The current tick started up to a tick ago, so one more keeps the timeout from firing early
+    const uint32_t ticks = (timeoutMillis + obj->config.tickMillis - 1u) / obj->config.tickMillis;
+    state->timerCommand = command;
+    RadarIQReactor_armTimer(obj, sensor, RadarIQReactor_getTick(obj) + ticks + 1u);
+
+    return RADARIQ_RETURN_VAL_OK;
+}
+
+/**
+ * Waits for data on any sensor's transport and processes it, then fires expired command timeouts.
+ * Should be called in a loop on the reactor thread, all handlers are called from here.
+ *
+ * @param obj The reactor handle returned from RadarIQReactor_init()
+ * @param timeoutMillis Longest time to wait for data in milliseconds, or -1 to wait indefinitely
+ *
+ * @return The number of events dispatched, or -1 if poll() failed
+ */
+int32_t RadarIQReactor_run(const RadarIQReactorHandle_t obj, const int32_t timeoutMillis)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    int32_t waitMillis = timeoutMillis;
+
+    // Wake up once a tick only while a command awaits its response
+    if ((0u < obj->numTimers) && ((0 > waitMillis) || ((int32_t)obj->config.tickMillis < waitMillis)))
+    {
+        waitMillis = (int32_t)obj->config.tickMillis;
+    }
+
+    const int ready = poll(obj->pollFds, obj->numSensors, waitMillis);
+
+    if ((0 > ready) && (EINTR != errno))
+    {
+        return -1;
+    }
+
+    int32_t events = 0;
+
+    for (uint8_t i = 0u; (i < obj->numSensors) && (0 < ready); i++)
+    {
+        const short revents = obj->pollFds[i].revents;
+
+        if (0 != (revents & POLLIN))
+        {
+            events += RadarIQReactor_read(obj, i);
+        }
+        else if (0 != (revents & (POLLERR | POLLHUP | POLLNVAL)))
+        {
+            RadarIQReactor_close(obj, i);
+            events++;
+        }
+    }
+
+    events += RadarIQReactor_advanceTimers(obj);
+
+    return events;
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Send callback of the sensors' handles, writes a packet to the sensor's file descriptor.
+ * Packets are short, so a full transmit buffer is waited on rather than queued.
+ *
+ * @param context Pointer to the sensor
+ * @param data Pointer to the encoded packet
+ * @param len Length of the packet in bytes
+ */
+static void RadarIQReactor_send(void * const context, uint8_t * const data, const uint16_t len)
+{
+    const RadarIQReactorSensor_t * const sensor = (const RadarIQReactorSensor_t *)context;
+    uint16_t sent = 0u;
+
+    while (sent < len)
+    {
+        const ssize_t written = write(sensor->fd, &data[sent], len - sent);
+
+        if (0 < written)
+        {
+            sent += (uint16_t)written;
+        }
+        else if ((0 > written) && ((EAGAIN == errno) || (EWOULDBLOCK == errno)))
+        {
+            struct pollfd pollFd = { sensor->fd, POLLOUT, 0 };
+            (void)poll(&pollFd, 1u, 10);
+        }
+        else if ((0 > written) && (EINTR == errno))
+        {
+            continue;
+        }
+        else
+        {
+            // A failed transport is detected and reported by the next poll
+            break;
+        }
+    }
+}
+
+/**
+ * Reads the bytes available from a sensor's transport and feeds them to its handle, dispatching each packet.
+ *
+ * @param obj The reactor handle returned from RadarIQReactor_init()
+ * @param index The sensor index
+ *
+ * @return The number of events dispatched
+ */
+static int32_t RadarIQReactor_read(const RadarIQReactorHandle_t obj, const uint8_t index)
+{
+    RadarIQReactorSensor_t * const sensor = &obj->sensors[index];
+    const ssize_t len = read(sensor->fd, obj->readBuffer, RADARIQ_REACTOR_READ_SIZE);
+
+    if (0 >= len)
+    {
+        if ((0 > len) && ((EAGAIN == errno) || (EWOULDBLOCK == errno) || (EINTR == errno)))
+        {
+            return 0;
+        }
+
+        RadarIQReactor_close(obj, index);
+        return 1;
+    }
+
+    int32_t events = 0;
+
+    for (ssize_t i = 0; i < len; i++)
+    {
+        const RadarIQCommand_t command = RadarIQ_processByte(sensor->radar, obj->readBuffer[i]);
+
+        // Unknown packets and packets failing decoding, the CRC check or their command's rules are counted in the
+        // handle's transport counters, see RadarIQ_getTransportStats()
+        if ((RADARIQ_CMD_NONE == command) || (RADARIQ_CMD_ERROR == command) || (RADARIQ_CMD_UNKNOWN == command))
+        {
+            continue;
+        }
+
+        RadarIQReactorEvent_t event = RADARIQ_REACTOR_EVENT_PACKET;
+
+        if (sensor->isTimerArmed && (sensor->timerCommand == command))
+        {
+            RadarIQReactor_cancelTimer(obj, index);
+            event = RADARIQ_REACTOR_EVENT_RESPONSE;
+        }
+
+        sensor->handler(sensor->context, index, sensor->radar, event, command);
+        events++;
+    }
+
+    return events;
+}
+
+/**
+ * Stops polling a sensor whose transport was closed or failed and notifies its handler.
+ *
+ * @param obj The reactor handle returned from RadarIQReactor_init()
+ * @param index The sensor index
+ */
+static void RadarIQReactor_close(const RadarIQReactorHandle_t obj, const uint8_t index)
+{
+    RadarIQReactorSensor_t * const sensor = &obj->sensors[index];
+
+    if (sensor->isTimerArmed)
+    {
+        RadarIQReactor_cancelTimer(obj, index);
+    }
+
+    sensor->isOpen = false;
+    obj->pollFds[index].fd = -1;
+
+    sensor->handler(sensor->context, index, sensor->radar, RADARIQ_REACTOR_EVENT_CLOSED, RADARIQ_CMD_NONE);
+}
+
+/**
+ * Gets the monotonic time.
+ *
+ * @return Time in milliseconds, wrapping after 49 days
+ */
+static uint32_t RadarIQReactor_getMillis(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)(((uint64_t)now.tv_sec * 1000u) + ((uint64_t)now.tv_nsec / 1000000u));
+}
+
+/**
+ * Gets the tick of the current time, which the timer wheel may not have advanced to yet.
+ *
+ * @param obj The reactor handle returned from RadarIQReactor_init()
+ *
+ * @return Ticks elapsed since initialization
+ */
+static uint32_t RadarIQReactor_getTick(const RadarIQReactorHandle_t obj)
+{
+    return (RadarIQReactor_getMillis() - obj->epochMillis) / obj->config.tickMillis;
+}
+
+/**
+ * Adds a sensor's command timer to the wheel slot of its deadline.
+ *
+ * @param obj The reactor handle returned from RadarIQReactor_init()
+ * @param index The sensor index
+ * @param deadline Tick the timer fires at
+ */
+static void RadarIQReactor_armTimer(const RadarIQReactorHandle_t obj, const uint8_t index, const uint32_t deadline)
+{
+    RadarIQReactorSensor_t * const sensor = &obj->sensors[index];
+    uint8_t * const slot = &obj->wheel[deadline & (RADARIQ_REACTOR_WHEEL_SLOTS - 1u)];
+
+    sensor->timerDeadline = deadline;
+    sensor->timerPrev = RADARIQ_REACTOR_NO_TIMER;
+    sensor->timerNext = *slot;
+
+    if (RADARIQ_REACTOR_NO_TIMER != *slot)
+    {
+        obj->sensors[*slot].timerPrev = index;
+    }
+
+    *slot = index;
+    sensor->isTimerArmed = true;
+    obj->numTimers++;
+}
+
+/**
+ * Removes a sensor's command timer from its wheel slot.
+ *
+ * @param obj The reactor handle returned from RadarIQReactor_init()
+ * @param index The sensor index
+ */
+static void RadarIQReactor_cancelTimer(const RadarIQReactorHandle_t obj, const uint8_t index)
+{
+    RadarIQReactorSensor_t * const sensor = &obj->sensors[index];
+
+    if (RADARIQ_REACTOR_NO_TIMER != sensor->timerPrev)
+    {
+        obj->sensors[sensor->timerPrev].timerNext = sensor->timerNext;
+    }
+    else
+    {
+        obj->wheel[sensor->timerDeadline & (RADARIQ_REACTOR_WHEEL_SLOTS - 1u)] = sensor->timerNext;
+    }
+
+    if (RADARIQ_REACTOR_NO_TIMER != sensor->timerNext)
+    {
+        obj->sensors[sensor->timerNext].timerPrev = sensor->timerPrev;
+    }
+
+    sensor->isTimerArmed = false;
+    obj->numTimers--;
+}
+
+/**
+ * Advances the timer wheel to the current time, firing every timer whose deadline has passed.
+ * A slot holds timers of later revolutions too, so only those due are fired. After a gap longer than a revolution
+ * each slot is visited once, which still fires every due timer.
+ *
+ * @param obj The reactor handle returned from RadarIQReactor_init()
+ *
+ * @return The number of timeout events dispatched
+ */
+static int32_t RadarIQReactor_advanceTimers(const RadarIQReactorHandle_t obj)
+{
+    const uint32_t now = RadarIQReactor_getTick(obj);
+    uint32_t steps = now - obj->tick;
+    int32_t events = 0;
+
+    if (0u == obj->numTimers)
+    {
+        obj->tick = now;
+        return 0;
+    }
+
+    if (RADARIQ_REACTOR_WHEEL_SLOTS < steps)
+    {
+        obj->tick = now - RADARIQ_REACTOR_WHEEL_SLOTS;
+        steps = RADARIQ_REACTOR_WHEEL_SLOTS;
+    }
+
+    for (uint32_t step = 0u; step < steps; step++)
+    {
+        obj->tick++;
+
+        uint8_t index = obj->wheel[obj->tick & (RADARIQ_REACTOR_WHEEL_SLOTS - 1u)];
+
+        while (RADARIQ_REACTOR_NO_TIMER != index)
+        {
+            RadarIQReactorSensor_t * const sensor = &obj->sensors[index];
+            const uint8_t next = sensor->timerNext;
+
+            if (0 >= (int32_t)(sensor->timerDeadline - obj->tick))
+            {
+                RadarIQReactor_cancelTimer(obj, index);
+                RadarIQ_expireCommand(sensor->radar);
+                sensor->handler(sensor->context, index, sensor->radar, RADARIQ_REACTOR_EVENT_TIMEOUT,
+                        sensor->timerCommand);
+                events++;
+            }
+
+            index = next;
+        }
+    }
+
+    return events;
+}
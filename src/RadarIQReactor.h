@@ -0,0 +1,96 @@
+/**
+ * @file
+ * RadarIQ SDK - Multi-sensor I/O reactor.
+ * Drives many RadarIQ handles from one thread: waits on all their transports with a single poll(), feeds each
+ * handle the bytes read in bulk and dispatches packets to handlers. Command timeouts are kept in a timer wheel.
+ * Requires a POSIX host, each transport must be a file descriptor such as a serial port or socket.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+#ifndef SRC_RADARIQREACTOR_H_
+#define SRC_RADARIQREACTOR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQ.h"
+
+//===============================================================================================//
+// DEFINITIONS
+//===============================================================================================//
+
+#define RADARIQ_REACTOR_NO_SENSOR          0xFFu     ///< Returned by RadarIQReactor_addSensor() when full
+#define RADARIQ_REACTOR_WHEEL_SLOTS        256u      ///< Number of timer wheel slots, a power of 2
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Events dispatched to a sensor's handler
+ */
+typedef enum
+{
+    RADARIQ_REACTOR_EVENT_PACKET = 0,           ///< A packet other than a command response was parsed, e.g. a frame
+    RADARIQ_REACTOR_EVENT_RESPONSE = 1,         ///< The response to a command sent with RadarIQReactor_sendCommand()
+    RADARIQ_REACTOR_EVENT_TIMEOUT = 2,          ///< No response to a command arrived within its timeout
+    RADARIQ_REACTOR_EVENT_CLOSED = 3            ///< The transport was closed or failed and is no longer polled
+} RadarIQReactorEvent_t;
+
+/**
+ * Handler of a sensor's events, called on the reactor thread.
+ * For packets and responses the handle's getters return the packet's data until the handler returns.
+ * Unknown, corrupt or malformed packets are not dispatched, they are counted by RadarIQ_getTransportStats().
+ *
+ * @param context The context pointer passed to RadarIQReactor_addSensor()
+ * @param sensor The sensor index returned from RadarIQReactor_addSensor()
+ * @param radar The sensor's RadarIQ object handle
+ * @param event The event
+ * @param command The packet's command, or the command sent for ::RADARIQ_REACTOR_EVENT_TIMEOUT
+ */
+typedef void(*RadarIQReactorHandler_t)(void * const context, const uint8_t sensor, const RadarIQHandle_t radar,
+        const RadarIQReactorEvent_t event, const RadarIQCommand_t command);
+
+/**
+ * Reactor configuration
+ */
+typedef struct
+{
+    uint8_t maxSensors;              ///< Maximum number of sensors
+    uint16_t tickMillis;             ///< Timer wheel resolution, timeouts fire up to one tick late
+} RadarIQReactorConfig_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+typedef struct RadarIQReactor_t RadarIQReactor_t;
+typedef RadarIQReactor_t* RadarIQReactorHandle_t;
+
+//===============================================================================================//
+// FUNCTIONS
+//===============================================================================================//
+
+RadarIQReactorHandle_t RadarIQReactor_init(const RadarIQReactorConfig_t * const config);
+void RadarIQReactor_destroy(const RadarIQReactorHandle_t obj);
+uint8_t RadarIQReactor_addSensor(const RadarIQReactorHandle_t obj, const RadarIQHandle_t radar, const int fd,
+        const RadarIQReactorHandler_t handler, void * const context);
+RadarIQReturnVal_t RadarIQReactor_sendCommand(const RadarIQReactorHandle_t obj, const uint8_t sensor,
+        const RadarIQCommand_t command, const RadarIQCommandVariant_t variant, const uint8_t * const payload,
+        const uint8_t len, const uint32_t timeoutMillis);
+int32_t RadarIQReactor_run(const RadarIQReactorHandle_t obj, const int32_t timeoutMillis);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_RADARIQREACTOR_H_ */
@@ -0,0 +1,624 @@
+/**
+ * @file
+ * RadarIQ SDK - Shared-memory frame publisher.
+ * The ring is a header followed by sequence-numbered slots. Each slot is a seqlock: the publisher makes the slot's
+ * sequence odd while writing it and sets it to 2 * (record sequence + 1) when done, so a subscriber can tell whether
+ * the record it is reading in place is still the one it acquired. Requires a POSIX host with C11 atomics.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#define _POSIX_C_SOURCE 200809L
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE              // syscall() for futexes
+#endif
+
+#include "RadarIQShm.h"
+#include <fcntl.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+//===============================================================================================//
+// CONSTANTS
+//===============================================================================================//
+
+#define RADARIQ_SHM_CACHE_LINE             64u       ///< Slots and shared counters are aligned to a cache line
+#define RADARIQ_SHM_POLL_MILLIS            1         ///< Wait interval where futexes are not available
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Start of the shared memory, mapped read-write by subscribers so they can register as waiters
+ */
+typedef struct
+{
+    atomic_uint_least32_t magic;     ///< ::RADARIQ_SHM_MAGIC once the layout is initialized
+    uint32_t version;                ///< ::RADARIQ_SHM_VERSION
+    uint32_t recordSize;             ///< sizeof(RadarIQShmRecord_t), rejects subscribers built with other limits
+    uint32_t numSlots;
+    uint64_t slotsOffset;            ///< Offset of the first slot, a multiple of the page size
+    _Alignas(RADARIQ_SHM_CACHE_LINE) atomic_uint_least64_t head;    ///< Number of records completely written
+    atomic_uint isClosed;            ///< Set when the publisher is destroyed
+    _Alignas(RADARIQ_SHM_CACHE_LINE) atomic_uint futexWord;         ///< Incremented on every publish, waited on by subscribers
+    atomic_uint waiters;             ///< Number of subscribers waiting on the futex word
+} RadarIQShmHeader_t;
+
+/**
+ * A ring slot
+ */
+typedef struct
+{
+    _Alignas(RADARIQ_SHM_CACHE_LINE) atomic_uint_least64_t seq;     ///< Odd while being written, 2 * (record sequence + 1) when complete
+    RadarIQShmRecord_t record;
+} RadarIQShmSlot_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+/**
+ * The RadarIQ shared-memory publisher object definition
+ */
+struct RadarIQShmPublisher_t
+{
+    RadarIQShmPublisherConfig_t config;
+    RadarIQShmHeader_t * header;
+    RadarIQShmSlot_t * slots;
+    size_t mapSize;
+    uint64_t count;                  ///< Number of records published
+};
+
+/**
+ * The RadarIQ shared-memory subscriber object definition
+ */
+struct RadarIQShmSubscriber_t
+{
+    const char * name;
+    RadarIQShmHeader_t * header;
+    size_t headerSize;
+    const RadarIQShmSlot_t * slots;
+    size_t slotsSize;
+    uint32_t mask;
+    uint64_t next;                   ///< Sequence of the next record to read
+    uint64_t heldSeq;                ///< Slot sequence of the acquired record, 0 if none is held
+    const RadarIQShmSlot_t * held;
+    uint64_t lost;
+};
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTION PROTOTYPES
+//===============================================================================================//
+
+static size_t RadarIQShm_getHeaderSize(void);
+static void RadarIQShm_wake(RadarIQShmHeader_t * const header);
+static void RadarIQShm_waitWord(RadarIQShmHeader_t * const header, const unsigned int word, const int32_t timeoutMillis);
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS - Publisher
+//===============================================================================================//
+
+/**
+ * Allocates and initializes a shared-memory publisher instance using heap allocation.
+ *
+ * @param config Pointer to the publisher configuration, the name must remain valid until the publisher is destroyed
+ *
+ * @return A handle for an instance of the RadarIQShmPublisher_t object
+ */
+RadarIQShmPublisherHandle_t RadarIQShmPublisher_init(const RadarIQShmPublisherConfig_t * const config)
+{
+    RADARIQ_ASSERT(NULL != config);
+    RADARIQ_ASSERT(NULL != config->name);
+    RADARIQ_ASSERT(RADARIQ_SHM_MIN_SLOTS <= config->numSlots);
+    RADARIQ_ASSERT(RADARIQ_SHM_MAX_SLOTS >= config->numSlots);
+    RADARIQ_ASSERT(0u == (config->numSlots & (config->numSlots - 1u)));
+
+    RadarIQShmPublisherHandle_t handle = malloc(sizeof(RadarIQShmPublisher_t));
+    RADARIQ_ASSERT(NULL != handle);
+    memset((void*)handle, 0, sizeof(RadarIQShmPublisher_t));
+
+    handle->config = *config;
+
+    return handle;
+}
+
+/**
+ * Marks the ring closed, wakes waiting subscribers and removes the shared memory object.
+ * Subscribers that have it mapped can still read the remaining records.
+ *
+ * @param obj The publisher handle returned from RadarIQShmPublisher_init()
+ */
+void RadarIQShmPublisher_destroy(const RadarIQShmPublisherHandle_t obj)
+{
+    if (NULL != obj)
+    {
+        if (NULL != obj->header)
+        {
+            atomic_store(&obj->header->isClosed, 1u);
+            RadarIQShm_wake(obj->header);
+
+            (void)munmap((void*)obj->header, obj->mapSize);
+            (void)shm_unlink(obj->config.name);
+        }
+        free(obj);
+    }
+}
+
+/**
+ * Creates the shared memory object and initializes the ring. An existing object with the same name is unlinked
+ * first, subscribers still mapping it see it as closed.
+ *
+ * @param obj The publisher handle returned from RadarIQShmPublisher_init()
+ *
+ * @return RADARIQ_RETURN_VAL_ERR if the shared memory could not be created or mapped, otherwise RADARIQ_RETURN_VAL_OK
+ */
+RadarIQReturnVal_t RadarIQShmPublisher_open(const RadarIQShmPublisherHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    if (NULL != obj->header)
+    {
+        return RADARIQ_RETURN_VAL_OK;
+    }
+
+    const size_t headerSize = RadarIQShm_getHeaderSize();
+    const size_t mapSize = headerSize + (sizeof(RadarIQShmSlot_t) * obj->config.numSlots);
+
+    (void)shm_unlink(obj->config.name);
+
+    const int fd = shm_open(obj->config.name, O_CREAT | O_EXCL | O_RDWR, 0660);
+    if (0 > fd)
+    {
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    void * const map = (0 == ftruncate(fd, (off_t)mapSize)) ?
+            mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+
+    if (MAP_FAILED == map)
+    {
+        (void)shm_unlink(obj->config.name);
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    // ftruncate() zero-fills, so every slot's sequence starts at 0 which no record uses
+    RadarIQShmHeader_t * const header = (RadarIQShmHeader_t *)map;
+    header->version = RADARIQ_SHM_VERSION;
+    header->recordSize = (uint32_t)sizeof(RadarIQShmRecord_t);
+    header->numSlots = obj->config.numSlots;
+    header->slotsOffset = headerSize;
+    atomic_init(&header->head, 0u);
+    atomic_init(&header->isClosed, 0u);
+    atomic_init(&header->futexWord, 0u);
+    atomic_init(&header->waiters, 0u);
+    atomic_store_explicit(&header->magic, RADARIQ_SHM_MAGIC, memory_order_release);
+
+    obj->header = header;
+    obj->slots = (RadarIQShmSlot_t *)((uint8_t *)map + headerSize);
+    obj->mapSize = mapSize;
+    obj->count = 0u;
+
+    return RADARIQ_RETURN_VAL_OK;
+}
+
+/**
+ * Publishes the packet just parsed by the radar if it completed a frame or carried processing statistics.
+ * Never waits for subscribers, the oldest record is overwritten when the ring is full.
+ *
+ * @param obj The publisher handle returned from RadarIQShmPublisher_init()
+ * @param radar The RadarIQ object handle that parsed the packet
+ * @param command The command returned by RadarIQ_readSerial() or RadarIQ_processByte()
+ *
+ * @return True if a record was published
+ */
+bool RadarIQShmPublisher_publish(const RadarIQShmPublisherHandle_t obj, const RadarIQHandle_t radar,
+        const RadarIQCommand_t command)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != radar);
+
+    if (NULL == obj->header)
+    {
+        return false;
+    }
+
+    const bool isFrame = ((RADARIQ_CMD_PNT_CLOUD_FRAME == command) || (RADARIQ_CMD_OBJ_TRACKING_FRAME == command));
+
+    if (!isFrame && (RADARIQ_CMD_PROC_STATS != command))
+    {
+        return false;
+    }
+
+    const uint64_t sequence = obj->count;
+    RadarIQShmSlot_t * const slot = &obj->slots[sequence & (obj->config.numSlots - 1u)];
+    RadarIQShmRecord_t * const record = &slot->record;
+
+    atomic_store_explicit(&slot->seq, (2u * sequence) + 1u, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    record->sequence = sequence;
+    if (isFrame)
+    {
+        record->recordType = RADARIQ_SHM_RECORD_FRAME;
+        record->payload.frame.type = command;
+        RadarIQ_getFrameInfo(radar, &record->payload.frame.info);
+        RadarIQ_getData(radar, &record->payload.frame.data);
+    }
+    else
+    {
+        record->recordType = RADARIQ_SHM_RECORD_STATS;
+        RadarIQ_getProcessingSample(radar, &record->payload.stats.processing, &record->payload.stats.temperatures);
+    }
+
+    atomic_store_explicit(&slot->seq, 2u * (sequence + 1u), memory_order_release);
+    atomic_store_explicit(&obj->header->head, sequence + 1u, memory_order_release);
+    obj->count = sequence + 1u;
+
+    RadarIQShm_wake(obj->header);
+
+    return true;
+}
+
+/**
+ * Gets the number of records published since the ring was opened.
+ *
+ * @param obj The publisher handle returned from RadarIQShmPublisher_init()
+ *
+ * @return The number of records
+ */
+uint64_t RadarIQShmPublisher_getCount(const RadarIQShmPublisherHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    return obj->count;
+}
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS - Subscriber
+//===============================================================================================//
+
+/**
+ * Allocates and initializes a shared-memory subscriber instance using heap allocation.
+ *
+ * @param name Shared memory object name given to the publisher, must remain valid until the subscriber is destroyed
+ *
+ * @return A handle for an instance of the RadarIQShmSubscriber_t object
+ */
+RadarIQShmSubscriberHandle_t RadarIQShmSubscriber_init(const char * const name)
+{
+    RADARIQ_ASSERT(NULL != name);
+
+    RadarIQShmSubscriberHandle_t handle = malloc(sizeof(RadarIQShmSubscriber_t));
+    RADARIQ_ASSERT(NULL != handle);
+    memset((void*)handle, 0, sizeof(RadarIQShmSubscriber_t));
+
+    handle->name = name;
+
+    return handle;
+}
+
+/**
+ * Unmaps the ring and frees a subscriber instance created by RadarIQShmSubscriber_init().
+ * No views acquired from it may be used afterwards.
+ *
+ * @param obj The subscriber handle returned from RadarIQShmSubscriber_init()
+ */
+void RadarIQShmSubscriber_destroy(const RadarIQShmSubscriberHandle_t obj)
+{
+    if (NULL != obj)
+    {
+        if (NULL != obj->header)
+        {
+            (void)munmap((void*)obj->slots, obj->slotsSize);
+            (void)munmap((void*)obj->header, obj->headerSize);
+        }
+        free(obj);
+    }
+}
+
+/**
+ * Maps a publisher's ring. Slots are mapped read-only. Reading starts with the next record published.
+ *
+ * @param obj The subscriber handle returned from RadarIQShmSubscriber_init()
+ *
+ * @return RADARIQ_RETURN_VAL_ERR if the ring doesn't exist yet or was built with a different layout,
+ *         otherwise RADARIQ_RETURN_VAL_OK
+ */
+RadarIQReturnVal_t RadarIQShmSubscriber_open(const RadarIQShmSubscriberHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    if (NULL != obj->header)
+    {
+        return RADARIQ_RETURN_VAL_OK;
+    }
+
+    const int fd = shm_open(obj->name, O_RDWR, 0);
+    if (0 > fd)
+    {
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    struct stat info;
+    const size_t headerSize = RadarIQShm_getHeaderSize();
+
+    if ((0 != fstat(fd, &info)) || ((off_t)headerSize > info.st_size))
+    {
+        close(fd);
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    RadarIQShmHeader_t * const header = mmap(NULL, headerSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == (void*)header)
+    {
+        close(fd);
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    const size_t slotsSize = sizeof(RadarIQShmSlot_t) * header->numSlots;
+
+    if ((RADARIQ_SHM_MAGIC != atomic_load_explicit(&header->magic, memory_order_acquire)) ||
+        (RADARIQ_SHM_VERSION != header->version) ||
+        (sizeof(RadarIQShmRecord_t) != header->recordSize) ||
+        (headerSize != header->slotsOffset) ||
+        ((off_t)(headerSize + slotsSize) != info.st_size))
+    {
+        (void)munmap((void*)header, headerSize);
+        close(fd);
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    const void * const slots = mmap(NULL, slotsSize, PROT_READ, MAP_SHARED, fd, (off_t)headerSize);
+    close(fd);
+
+    if (MAP_FAILED == slots)
+    {
+        (void)munmap((void*)header, headerSize);
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    obj->header = header;
+    obj->headerSize = headerSize;
+    obj->slots = (const RadarIQShmSlot_t *)slots;
+    obj->slotsSize = slotsSize;
+    obj->mask = header->numSlots - 1u;
+    obj->next = atomic_load_explicit(&header->head, memory_order_acquire);
+    obj->held = NULL;
+    obj->lost = 0u;
+
+    return RADARIQ_RETURN_VAL_OK;
+}
+
+/**
+ * Gets a read-only view of the next record, in place in shared memory. The view must be given back with
+ * RadarIQShmSubscriber_release(), which reports whether the publisher overwrote it while it was being read.
+ *
+ * @param obj The subscriber handle returned from RadarIQShmSubscriber_init()
+ * @param record Pointer to set to the view, unchanged if no record is returned
+ *
+ * @return ::RADARIQ_SHM_READ_OK or ::RADARIQ_SHM_READ_OVERRUN if a view was returned,
+ *         otherwise ::RADARIQ_SHM_READ_EMPTY or ::RADARIQ_SHM_READ_CLOSED
+ */
+RadarIQShmRead_t RadarIQShmSubscriber_acquire(const RadarIQShmSubscriberHandle_t obj,
+        const RadarIQShmRecord_t ** const record)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != record);
+    RADARIQ_ASSERT(NULL == obj->held);
+
+    if (NULL == obj->header)
+    {
+        return RADARIQ_SHM_READ_EMPTY;
+    }
+
+    const uint64_t numSlots = (uint64_t)obj->mask + 1u;
+    RadarIQShmRead_t result = RADARIQ_SHM_READ_OK;
+
+    for (;;)
+    {
+        const bool isClosed = (0u != atomic_load_explicit(&obj->header->isClosed, memory_order_acquire));
+        const uint64_t head = atomic_load_explicit(&obj->header->head, memory_order_acquire);
+
+        if (obj->next >= head)
+        {
+            return isClosed ? RADARIQ_SHM_READ_CLOSED : RADARIQ_SHM_READ_EMPTY;
+        }
+
+        // The slot after the newest record may be being overwritten, so one fewer than numSlots records are readable
+        const uint64_t oldest = (head >= numSlots) ? (head - numSlots + 1u) : 0u;
+
+        if (obj->next < oldest)
+        {
+            obj->lost += oldest - obj->next;
+            obj->next = oldest;
+            result = RADARIQ_SHM_READ_OVERRUN;
+        }
+
+        const RadarIQShmSlot_t * const slot = &obj->slots[obj->next & obj->mask];
+        const uint64_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+
+        if ((2u * (obj->next + 1u)) == seq)
+        {
+            obj->held = slot;
+            obj->heldSeq = seq;
+            *record = &slot->record;
+            return result;
+        }
+
+        // The publisher lapped the record since head was read, the next pass skips past it
+    }
+}
+
+/**
+ * Gives back the view returned by RadarIQShmSubscriber_acquire() and moves on to the next record.
+ *
+ * @param obj The subscriber handle returned from RadarIQShmSubscriber_init()
+ *
+ * @return True if the record was unchanged while it was held, false if it was overwritten and any data read
+ *         from it must be discarded. An overwritten record is counted as lost.
+ */
+bool RadarIQShmSubscriber_release(const RadarIQShmSubscriberHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != obj->held);
+
+    atomic_thread_fence(memory_order_acquire);
+    const bool isValid = (obj->heldSeq == atomic_load_explicit(&obj->held->seq, memory_order_relaxed));
+
+    if (!isValid)
+    {
+        obj->lost++;
+    }
+
+    obj->held = NULL;
+    obj->next++;
+
+    return isValid;
+}
+
+/**
+ * Waits until a record is available to acquire or the publisher is destroyed.
+ *
+ * @param obj The subscriber handle returned from RadarIQShmSubscriber_init()
+ * @param timeoutMillis Maximum time to wait in milliseconds, or ::RADARIQ_SHM_WAIT_FOREVER
+ *
+ * @return True if a record is available or the ring is closed, false on timeout
+ */
+bool RadarIQShmSubscriber_wait(const RadarIQShmSubscriberHandle_t obj, const int32_t timeoutMillis)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    if (NULL == obj->header)
+    {
+        return false;
+    }
+
+    RadarIQShmHeader_t * const header = obj->header;
+    struct timespec start;
+    (void)clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (;;)
+    {
+        // Read the word before checking, a publish after the check changes the word and fails the futex wait
+        const unsigned int word = atomic_load(&header->futexWord);
+
+        if ((obj->next < atomic_load(&header->head)) || (0u != atomic_load(&header->isClosed)))
+        {
+            return true;
+        }
+
+        int32_t remaining = RADARIQ_SHM_WAIT_FOREVER;
+
+        if (0 <= timeoutMillis)
+        {
+            struct timespec now;
+            (void)clock_gettime(CLOCK_MONOTONIC, &now);
+            const int64_t elapsed = ((int64_t)(now.tv_sec - start.tv_sec) * 1000) +
+                    ((now.tv_nsec - start.tv_nsec) / 1000000);
+
+            if (elapsed >= timeoutMillis)
+            {
+                return false;
+            }
+            remaining = timeoutMillis - (int32_t)elapsed;
+        }
+
+        atomic_fetch_add(&header->waiters, 1u);
+        RadarIQShm_waitWord(header, word, remaining);
+        atomic_fetch_sub(&header->waiters, 1u);
+    }
+}
+
+/**
+ * Gets the number of records this subscriber missed, either skipped on overrun or overwritten while held.
+ *
+ * @param obj The subscriber handle returned from RadarIQShmSubscriber_init()
+ *
+ * @return The number of records lost
+ */
+uint64_t RadarIQShmSubscriber_getLost(const RadarIQShmSubscriberHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    return obj->lost;
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Gets the size of the ring header rounded up to the page size, so the slots can be mapped separately.
+ *
+ * @return The header size in bytes
+ */
+static size_t RadarIQShm_getHeaderSize(void)
+{
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    const size_t page = (0 < pageSize) ? (size_t)pageSize : 4096u;
+
+    return ((sizeof(RadarIQShmHeader_t) + page - 1u) / page) * page;
+}
+
+/**
+ * Bumps the futex word and wakes waiting subscribers, skipping the system call when none are waiting.
+ *
+ * @param header The ring header
+ */
+static void RadarIQShm_wake(RadarIQShmHeader_t * const header)
+{
+    atomic_fetch_add(&header->futexWord, 1u);
+
+#if defined(__linux__)
+    if (0u != atomic_load(&header->waiters))
+    {
+        (void)syscall(SYS_futex, (void*)&header->futexWord, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+    }
+#endif
+}
+
+/**
+ * Sleeps until the futex word changes from an expected value, the timeout expires or a signal arrives.
+ * Without futexes sleeps for a short interval instead.
+ *
+ * @param header The ring header
+ * @param word The value the futex word had when the ring was last checked
+ * @param timeoutMillis Maximum time to sleep in milliseconds, or ::RADARIQ_SHM_WAIT_FOREVER
+ */
+static void RadarIQShm_waitWord(RadarIQShmHeader_t * const header, const unsigned int word, const int32_t timeoutMillis)
+{
+#if defined(__linux__)
+    struct timespec timeout;
+    timeout.tv_sec = timeoutMillis / 1000;
+    timeout.tv_nsec = (long)(timeoutMillis % 1000) * 1000000L;
+
+    (void)syscall(SYS_futex, (void*)&header->futexWord, FUTEX_WAIT, word, (0 <= timeoutMillis) ? &timeout : NULL,
+            NULL, 0);
+#else
+    (void)header;
+    (void)word;
+
+    const int32_t sleepMillis = ((0 <= timeoutMillis) && (RADARIQ_SHM_POLL_MILLIS > timeoutMillis)) ?
+            timeoutMillis : RADARIQ_SHM_POLL_MILLIS;
+    const struct timespec interval = { 0, (long)sleepMillis * 1000000L };
+    (void)nanosleep(&interval, NULL);
+#endif
+}
@@ -0,0 +1,141 @@
+/**
+ * @file
+ * RadarIQ SDK - Shared-memory frame publisher.
+ * The process that owns a sensor publishes completed frames and processing statistics into a POSIX shared-memory
+ * ring, and any number of other processes subscribe to it. Subscribers read records in place through read-only
+ * views. The publisher never waits for subscribers: a subscriber that falls a whole ring behind is told it was
+ * overrun and skips to the oldest record still present.
+ * Requires a POSIX host with C11 atomics, wakeups use futexes on Linux.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+#ifndef SRC_RADARIQSHM_H_
+#define SRC_RADARIQSHM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQ.h"
+
+//===============================================================================================//
+// DEFINITIONS
+//===============================================================================================//
+
+#define RADARIQ_SHM_MAGIC                  0x4D485352uL    ///< "RSHM" little-endian, first 4 bytes of the shared memory
+#define RADARIQ_SHM_VERSION                1u        ///< Version of the shared memory layout
+#define RADARIQ_SHM_MIN_SLOTS              2u        ///< One slot being written and at least one readable
+#define RADARIQ_SHM_MAX_SLOTS              1024u     ///< Largest number of ring slots
+#define RADARIQ_SHM_WAIT_FOREVER           (-1)      ///< Timeout for RadarIQShmSubscriber_wait() that never expires
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Kinds of record in the ring
+ */
+typedef enum
+{
+    RADARIQ_SHM_RECORD_FRAME = 0,               ///< A completed point-cloud or object-tracking frame
+    RADARIQ_SHM_RECORD_STATS = 1                ///< Processing statistics and chip temperatures
+} RadarIQShmRecordType_t;
+
+/**
+ * Frame record
+ */
+typedef struct
+{
+    RadarIQCommand_t type;           ///< ::RADARIQ_CMD_PNT_CLOUD_FRAME or ::RADARIQ_CMD_OBJ_TRACKING_FRAME
+    RadarIQFrameInfo_t info;         ///< Subframe completeness of the frame
+    RadarIQData_t data;              ///< The frame, pointCloud or objectTracking depending on type
+} RadarIQShmFrame_t;
+
+/**
+ * Statistics record
+ */
+typedef struct
+{
+    RadarIQProcessingStats_t processing;         ///< Processing statistics
+    RadarIQChipTemperatures_t temperatures;      ///< Chip temperatures
+} RadarIQShmStats_t;
+
+/**
+ * A record in the ring, read in place by subscribers
+ */
+typedef struct
+{
+    RadarIQShmRecordType_t recordType;           ///< Selects the member of payload
+    uint64_t sequence;                           ///< Number of records published before this one
+    union
+    {
+        RadarIQShmFrame_t frame;                 ///< Valid for ::RADARIQ_SHM_RECORD_FRAME
+        RadarIQShmStats_t stats;                 ///< Valid for ::RADARIQ_SHM_RECORD_STATS
+    } payload;
+} RadarIQShmRecord_t;
+
+/**
+ * Result of RadarIQShmSubscriber_acquire()
+ */
+typedef enum
+{
+    RADARIQ_SHM_READ_OK = 0,                    ///< A view of the next record was returned
+    RADARIQ_SHM_READ_OVERRUN = 1,               ///< Records were overwritten before they were read, a view of the oldest remaining record was returned
+    RADARIQ_SHM_READ_EMPTY = 2,                 ///< No record has been published since the last one read
+    RADARIQ_SHM_READ_CLOSED = 3                 ///< The publisher was destroyed and every record has been read
+} RadarIQShmRead_t;
+
+/**
+ * Publisher configuration
+ */
+typedef struct
+{
+    const char * name;               ///< Shared memory object name, e.g. "/radariq0", replaced if it already exists
+    uint16_t numSlots;               ///< Number of ring slots, a power of 2 from ::RADARIQ_SHM_MIN_SLOTS to ::RADARIQ_SHM_MAX_SLOTS
+} RadarIQShmPublisherConfig_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+typedef struct RadarIQShmPublisher_t RadarIQShmPublisher_t;
+typedef RadarIQShmPublisher_t* RadarIQShmPublisherHandle_t;
+
+typedef struct RadarIQShmSubscriber_t RadarIQShmSubscriber_t;
+typedef RadarIQShmSubscriber_t* RadarIQShmSubscriberHandle_t;
+
+//===============================================================================================//
+// FUNCTIONS
+//===============================================================================================//
+
+/* Publisher, must be called from the thread that calls RadarIQ_readSerial() */
+RadarIQShmPublisherHandle_t RadarIQShmPublisher_init(const RadarIQShmPublisherConfig_t * const config);
+void RadarIQShmPublisher_destroy(const RadarIQShmPublisherHandle_t obj);
+RadarIQReturnVal_t RadarIQShmPublisher_open(const RadarIQShmPublisherHandle_t obj);
+bool RadarIQShmPublisher_publish(const RadarIQShmPublisherHandle_t obj, const RadarIQHandle_t radar,
+        const RadarIQCommand_t command);
+uint64_t RadarIQShmPublisher_getCount(const RadarIQShmPublisherHandle_t obj);
+
+/* Subscriber, each subscriber must only be used from one thread */
+RadarIQShmSubscriberHandle_t RadarIQShmSubscriber_init(const char * const name);
+void RadarIQShmSubscriber_destroy(const RadarIQShmSubscriberHandle_t obj);
+RadarIQReturnVal_t RadarIQShmSubscriber_open(const RadarIQShmSubscriberHandle_t obj);
+RadarIQShmRead_t RadarIQShmSubscriber_acquire(const RadarIQShmSubscriberHandle_t obj,
+        const RadarIQShmRecord_t ** const record);
+bool RadarIQShmSubscriber_release(const RadarIQShmSubscriberHandle_t obj);
+bool RadarIQShmSubscriber_wait(const RadarIQShmSubscriberHandle_t obj, const int32_t timeoutMillis);
+uint64_t RadarIQShmSubscriber_getLost(const RadarIQShmSubscriberHandle_t obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_RADARIQSHM_H_ */
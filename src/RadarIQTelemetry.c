@@ -0,0 +1,570 @@
+/**
+ * @file
+ * RadarIQ SDK - Device health telemetry.
+ * Rolling 1 second, 1 minute and 1 hour windows of the statistics reported by the device, in fixed memory
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQTelemetry.h"
+#include <limits.h>
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Aggregate of one statistic over one bin of a window
+ */
+typedef struct
+{
+    int64_t sum;
+    uint32_t count;
+    int32_t min;
+    int32_t max;
+    uint16_t buckets[RADARIQ_TELEMETRY_BUCKETS];    ///< Log-linear histogram, saturating counts
+} RadarIQTelemetryBin_t;
+
+/**
+ * Ring position of a window, shared by every statistic
+ */
+typedef struct
+{
+    uint32_t binStart;               ///< Time the current bin was started in milliseconds
+    uint8_t current;                 ///< Index of the bin receiving samples
+    bool isStarted;
+} RadarIQTelemetryClock_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+/**
+ * The RadarIQ telemetry object definition
+ * Each window is a ring of ::RADARIQ_TELEMETRY_BINS bins, the oldest bin is cleared and reused as time advances
+ */
+struct RadarIQTelemetry_t
+{
+    RadarIQTelemetryConfig_t config;
+    uint8_t slot[RADARIQ_TELEMETRY_NUM_STATS];      ///< Storage slot of each enabled statistic
+    uint8_t numSlots;
+    RadarIQTelemetryClock_t clock[RADARIQ_TELEMETRY_NUM_WINDOWS];
+    RadarIQTelemetryTruncation_t truncation[RADARIQ_TELEMETRY_NUM_WINDOWS][RADARIQ_TELEMETRY_BINS];
+    RadarIQTelemetryBin_t * bins;    ///< numSlots * RADARIQ_TELEMETRY_NUM_WINDOWS * RADARIQ_TELEMETRY_BINS
+};
+
+//===============================================================================================//
+// CONSTANTS
+//===============================================================================================//
+
+#define RADARIQ_TELEMETRY_NO_SLOT          0xFFu     ///< Slot of a statistic that is not aggregated
+
+/**
+ * Length of one bin of each window in milliseconds
+ */
+static const uint32_t RadarIQTelemetry_binMillis[RADARIQ_TELEMETRY_NUM_WINDOWS] =
+{
+    1000u / RADARIQ_TELEMETRY_BINS,
+    60000u / RADARIQ_TELEMETRY_BINS,
+    3600000u / RADARIQ_TELEMETRY_BINS
+};
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTION PROTOTYPES
+//===============================================================================================//
+
+static void RadarIQTelemetry_advance(const RadarIQTelemetryHandle_t obj, const uint32_t timeMillis);
+static void RadarIQTelemetry_clearBin(const RadarIQTelemetryHandle_t obj, const uint8_t window, const uint8_t bin);
+static void RadarIQTelemetry_addSample(const RadarIQTelemetryHandle_t obj, const RadarIQTelemetryStat_t stat,
+        const int32_t value);
+static RadarIQTelemetryBin_t * RadarIQTelemetry_getBin(const RadarIQTelemetryHandle_t obj, const uint8_t slot,
+        const uint8_t window, const uint8_t bin);
+static uint8_t RadarIQTelemetry_getBucket(const int32_t value);
+static int32_t RadarIQTelemetry_getPercentile(const uint32_t * const buckets, const RadarIQTelemetrySummary_t * const summary,
+        const uint8_t percentile);
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Allocates and initializes a telemetry instance using heap allocation.
+ *
+ * @param config Pointer to the telemetry configuration
+ *
+ * @return A handle for an instance of the RadarIQTelemetry_t object
+ */
+RadarIQTelemetryHandle_t RadarIQTelemetry_init(const RadarIQTelemetryConfig_t * const config)
+{
+    RADARIQ_ASSERT(NULL != config);
+
+    RadarIQTelemetryHandle_t handle = malloc(sizeof(RadarIQTelemetry_t));
+    RADARIQ_ASSERT(NULL != handle);
+    memset((void*)handle, 0, sizeof(RadarIQTelemetry_t));
+
+    handle->config = *config;
+
+    for (uint8_t stat = 0u; stat < RADARIQ_TELEMETRY_NUM_STATS; stat++)
+    {
+        if (0u != (config->statMask & RADARIQ_TELEMETRY_STAT_MASK(stat)))
+        {
+            handle->slot[stat] = handle->numSlots;
+            handle->numSlots++;
+        }
+        else
+        {
+            handle->slot[stat] = RADARIQ_TELEMETRY_NO_SLOT;
+        }
+    }
+
+    if (0u < handle->numSlots)
+    {
+        handle->bins = calloc((uint32_t)handle->numSlots * RADARIQ_TELEMETRY_NUM_WINDOWS * RADARIQ_TELEMETRY_BINS,
+                sizeof(RadarIQTelemetryBin_t));
+        RADARIQ_ASSERT(NULL != handle->bins);
+    }
+
+    return handle;
+}
+
+/**
+ * Frees a telemetry instance created by RadarIQTelemetry_init().
+ *
+ * @param obj The telemetry handle returned from RadarIQTelemetry_init()
+ */
+void RadarIQTelemetry_destroy(const RadarIQTelemetryHandle_t obj)
+{
+    if (NULL != obj)
+    {
+        free(obj->bins);
+        free(obj);
+    }
+}
+
+/**
+ * Discards every sample from all windows.
+ *
+ * @param obj The telemetry handle returned from RadarIQTelemetry_init()
+ */
+void RadarIQTelemetry_reset(const RadarIQTelemetryHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    memset((void*)obj->clock, 0, sizeof(obj->clock));
+    memset((void*)obj->truncation, 0, sizeof(obj->truncation));
+
+    if (NULL != obj->bins)
+    {
+        memset((void*)obj->bins, 0, (uint32_t)obj->numSlots * RADARIQ_TELEMETRY_NUM_WINDOWS * RADARIQ_TELEMETRY_BINS
+                * sizeof(RadarIQTelemetryBin_t));
+    }
+}
+
+/**
+ * Adds a processing statistics packet to every window.
+ * Call after RadarIQ_readSerial() returns RADARIQ_CMD_PROC_STATS, with the statistics from RadarIQ_getStatistics().
+ * Runs in constant time.
+ *
+ * @param obj The telemetry handle returned from RadarIQTelemetry_init()
+ * @param processing Pointer to the processing statistics
+ * @param temperatures Pointer to the chip temperatures sent in the same packet
+ * @param timeMillis The time the packet was received in milliseconds
+ */
+void RadarIQTelemetry_addProcessingStats(const RadarIQTelemetryHandle_t obj,
+        const RadarIQProcessingStats_t * const processing, const RadarIQChipTemperatures_t * const temperatures,
+        const uint32_t timeMillis)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != processing);
+    RADARIQ_ASSERT(NULL != temperatures);
+
+    RadarIQTelemetry_advance(obj, timeMillis);
+
+    const int16_t sensors[10] =
+    {
+        temperatures->sensor0, temperatures->sensor1, temperatures->powerManagement,
+        temperatures->rx0, temperatures->rx1, temperatures->rx2, temperatures->rx3,
+        temperatures->tx0, temperatures->tx1, temperatures->tx2
+    };
+    int16_t hottest = sensors[0];
+
+    for (uint8_t idx = 0u; idx < 10u; idx++)
+    {
+        hottest = (sensors[idx] > hottest) ? sensors[idx] : hottest;
+        RadarIQTelemetry_addSample(obj, (RadarIQTelemetryStat_t)(RADARIQ_TELEMETRY_TEMPERATURE_SENSOR0 + idx),
+                sensors[idx]);
+    }
+
+    RadarIQTelemetry_addSample(obj, RADARIQ_TELEMETRY_ACTIVE_FRAME_CPU_LOAD, (int32_t)processing->activeFrameCPULoad);
+    RadarIQTelemetry_addSample(obj, RADARIQ_TELEMETRY_INTER_FRAME_CPU_LOAD, (int32_t)processing->interFrameCPULoad);
+    RadarIQTelemetry_addSample(obj, RADARIQ_TELEMETRY_INTER_FRAME_PROC_TIME, (int32_t)processing->interFrameProcTime);
+    RadarIQTelemetry_addSample(obj, RADARIQ_TELEMETRY_TRANSMIT_OUTPUT_TIME, (int32_t)processing->transmitOutputTime);
+    RadarIQTelemetry_addSample(obj, RADARIQ_TELEMETRY_INTER_FRAME_PROC_MARGIN, (int32_t)processing->interFrameProcMargin);
+    RadarIQTelemetry_addSample(obj, RADARIQ_TELEMETRY_INTER_CHIRP_PROC_MARGIN, (int32_t)processing->interChirpProcMargin);
+    RadarIQTelemetry_addSample(obj, RADARIQ_TELEMETRY_UART_TRANSMIT_TIME, (int32_t)processing->uartTransmitTime);
+    RadarIQTelemetry_addSample(obj, RADARIQ_TELEMETRY_TEMPERATURE_MAX, hottest);
+}
+
+/**
+ * Adds a point-cloud statistics packet to every window and counts truncated frames.
+ * Call after RadarIQ_readSerial() returns RADARIQ_CMD_POINTCLOUD_STATS, with the statistics from
+ * RadarIQ_getPointCloudStats(). Runs in constant time.
+ *
+ * @param obj The telemetry handle returned from RadarIQTelemetry_init()
+ * @param pointcloud Pointer to the point-cloud statistics
+ * @param timeMillis The time the packet was received in milliseconds
+ */
+void RadarIQTelemetry_addPointCloudStats(const RadarIQTelemetryHandle_t obj,
+        const RadarIQPointcloudStats_t * const pointcloud, const uint32_t timeMillis)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != pointcloud);
+
+    RadarIQTelemetry_advance(obj, timeMillis);
+
+    for (uint8_t window = 0u; window < RADARIQ_TELEMETRY_NUM_WINDOWS; window++)
+    {
+        RadarIQTelemetryTruncation_t * const truncation = &obj->truncation[window][obj->clock[window].current];
+
+        truncation->frames++;
+        truncation->inputTruncated += pointcloud->inputPointsTruncated ? 1u : 0u;
+        truncation->outputTruncated += pointcloud->outputPointsTruncated ? 1u : 0u;
+    }
+
+    RadarIQTelemetry_addSample(obj, RADARIQ_TELEMETRY_FRAME_AGGREGATING_TIME, (int32_t)pointcloud->frameAggregatingTime);
+    RadarIQTelemetry_addSample(obj, RADARIQ_TELEMETRY_INTENSITY_SORT_TIME, (int32_t)pointcloud->intensitySortTime);
+    RadarIQTelemetry_addSample(obj, RADARIQ_TELEMETRY_NEAREST_NEIGHBOURS_TIME, (int32_t)pointcloud->nearestNeighboursTime);
+    RadarIQTelemetry_addSample(obj, RADARIQ_TELEMETRY_PC_UART_TRANSMIT_TIME, (int32_t)pointcloud->uartTransmitTime);
+    RadarIQTelemetry_addSample(obj, RADARIQ_TELEMETRY_NUM_FILTERED_POINTS, (int32_t)pointcloud->numFilteredPoints);
+    RadarIQTelemetry_addSample(obj, RADARIQ_TELEMETRY_NUM_POINTS_TRANSMITTED, (int32_t)pointcloud->numPointsTransmitted);
+}
+
+/**
+ * Gets the min, max, mean and percentiles of a statistic over a window.
+ *
+ * @param obj The telemetry handle returned from RadarIQTelemetry_init()
+ * @param stat The statistic to summarise
+ * @param window The window to summarise over
+ * @param timeMillis The current time in milliseconds, bins older than the window are discarded
+ * @param dest Pointer to a RadarIQTelemetrySummary_t struct to write the summary into
+ *
+ * @return RADARIQ_RETURN_VAL_ERR if the statistic is not enabled in the configuration, otherwise RADARIQ_RETURN_VAL_OK
+ */
+RadarIQReturnVal_t RadarIQTelemetry_getSummary(const RadarIQTelemetryHandle_t obj, const RadarIQTelemetryStat_t stat,
+        const RadarIQTelemetryWindow_t window, const uint32_t timeMillis, RadarIQTelemetrySummary_t * const dest)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(RADARIQ_TELEMETRY_NUM_STATS > stat);
+    RADARIQ_ASSERT(RADARIQ_TELEMETRY_NUM_WINDOWS > window);
+    RADARIQ_ASSERT(NULL != dest);
+
+    memset((void*)dest, 0, sizeof(RadarIQTelemetrySummary_t));
+
+    const uint8_t slot = obj->slot[stat];
+    if (RADARIQ_TELEMETRY_NO_SLOT == slot)
+    {
+        return RADARIQ_RETURN_VAL_ERR;
+    }
+
+    RadarIQTelemetry_advance(obj, timeMillis);
+
+    uint32_t buckets[RADARIQ_TELEMETRY_BUCKETS];
+    int64_t sum = 0;
+    memset((void*)buckets, 0, sizeof(buckets));
+
+    for (uint8_t idx = 0u; idx < RADARIQ_TELEMETRY_BINS; idx++)
+    {
+        const RadarIQTelemetryBin_t * const bin = RadarIQTelemetry_getBin(obj, slot, (uint8_t)window, idx);
+
+        if (0u == bin->count)
+        {
+            continue;
+        }
+
+        if ((0u == dest->count) || (bin->min < dest->min))
+        {
+            dest->min = bin->min;
+        }
+        if ((0u == dest->count) || (bin->max > dest->max))
+        {
+            dest->max = bin->max;
+        }
+        dest->count += bin->count;
+        sum += bin->sum;
+
+        for (uint8_t bucket = 0u; bucket < RADARIQ_TELEMETRY_BUCKETS; bucket++)
+        {
+            buckets[bucket] += bin->buckets[bucket];
+        }
+    }
+
+    if (0u < dest->count)
+    {
+        dest->mean = (float)sum / (float)dest->count;
+        dest->p50 = RadarIQTelemetry_getPercentile(buckets, dest, 50u);
+        dest->p90 = RadarIQTelemetry_getPercentile(buckets, dest, 90u);
+        dest->p99 = RadarIQTelemetry_getPercentile(buckets, dest, 99u);
+    }
+
+    return RADARIQ_RETURN_VAL_OK;
+}
+
+/**
+ * Gets the number of point-cloud frames and truncated frames over a window.
+ *
+ * @param obj The telemetry handle returned from RadarIQTelemetry_init()
+ * @param window The window to count over
+ * @param timeMillis The current time in milliseconds, bins older than the window are discarded
+ * @param dest Pointer to a RadarIQTelemetryTruncation_t struct to write the counts into
+ */
+void RadarIQTelemetry_getTruncation(const RadarIQTelemetryHandle_t obj, const RadarIQTelemetryWindow_t window,
+        const uint32_t timeMillis, RadarIQTelemetryTruncation_t * const dest)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(RADARIQ_TELEMETRY_NUM_WINDOWS > window);
+    RADARIQ_ASSERT(NULL != dest);
+
+    RadarIQTelemetry_advance(obj, timeMillis);
+
+    memset((void*)dest, 0, sizeof(RadarIQTelemetryTruncation_t));
+
+    for (uint8_t idx = 0u; idx < RADARIQ_TELEMETRY_BINS; idx++)
+    {
+        dest->frames += obj->truncation[window][idx].frames;
+        dest->inputTruncated += obj->truncation[window][idx].inputTruncated;
+        dest->outputTruncated += obj->truncation[window][idx].outputTruncated;
+    }
+}
+
+/**
+ * Gets the number of bytes of heap a telemetry instance will allocate for a configuration.
+ *
+ * @param config Pointer to the telemetry configuration
+ *
+ * @return The memory usage in bytes
+ */
+uint32_t RadarIQTelemetry_getMemoryUsage(const RadarIQTelemetryConfig_t * const config)
+{
+    RADARIQ_ASSERT(NULL != config);
+
+    uint32_t numSlots = 0u;
+    for (uint8_t stat = 0u; stat < RADARIQ_TELEMETRY_NUM_STATS; stat++)
+    {
+        numSlots += (0u != (config->statMask & RADARIQ_TELEMETRY_STAT_MASK(stat))) ? 1u : 0u;
+    }
+
+    return (uint32_t)(sizeof(RadarIQTelemetry_t)
+            + (sizeof(RadarIQTelemetryBin_t) * numSlots * RADARIQ_TELEMETRY_NUM_WINDOWS * RADARIQ_TELEMETRY_BINS));
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Moves every window forward to the bin containing a time, clearing the bins that are passed over.
+ * At most ::RADARIQ_TELEMETRY_BINS bins are cleared per window however long the gap since the last call.
+ *
+ * @param obj The telemetry handle returned from RadarIQTelemetry_init()
+ * @param timeMillis The current time in milliseconds
+ */
+static void RadarIQTelemetry_advance(const RadarIQTelemetryHandle_t obj, const uint32_t timeMillis)
+{
+    for (uint8_t window = 0u; window < RADARIQ_TELEMETRY_NUM_WINDOWS; window++)
+    {
+        RadarIQTelemetryClock_t * const clock = &obj->clock[window];
+
+        if (!clock->isStarted)
+        {
+            clock->isStarted = true;
+            clock->binStart = timeMillis;
+            continue;
+        }
+
+        // Unsigned subtraction handles the millisecond counter wrapping
+        const uint32_t steps = (timeMillis - clock->binStart) / RadarIQTelemetry_binMillis[window];
+
+        if (0u == steps)
+        {
+            continue;
+        }
+
+        if (RADARIQ_TELEMETRY_BINS <= steps)
+        {
+            for (uint8_t bin = 0u; bin < RADARIQ_TELEMETRY_BINS; bin++)
+            {
+                RadarIQTelemetry_clearBin(obj, window, bin);
+            }
+            clock->current = 0u;
+            clock->binStart = timeMillis;
+        }
+        else
+        {
+            for (uint32_t step = 0u; step < steps; step++)
+            {
+                clock->current = (uint8_t)((clock->current + 1u) % RADARIQ_TELEMETRY_BINS);
+                RadarIQTelemetry_clearBin(obj, window, clock->current);
+            }
+            clock->binStart += steps * RadarIQTelemetry_binMillis[window];
+        }
+    }
+}
+
+/**
+ * Clears one bin of a window for every statistic.
+ *
+ * @param obj The telemetry handle returned from RadarIQTelemetry_init()
+ * @param window The window
+ * @param bin The bin index within the window
+ */
+static void RadarIQTelemetry_clearBin(const RadarIQTelemetryHandle_t obj, const uint8_t window, const uint8_t bin)
+{
+    memset((void*)&obj->truncation[window][bin], 0, sizeof(RadarIQTelemetryTruncation_t));
+
+    for (uint8_t slot = 0u; slot < obj->numSlots; slot++)
+    {
+        memset((void*)RadarIQTelemetry_getBin(obj, slot, window, bin), 0, sizeof(RadarIQTelemetryBin_t));
+    }
+}
+
+/**
+ * Adds a sample of a statistic to the current bin of every window. Samples of disabled statistics are ignored.
+ *
+ * @param obj The telemetry handle returned from RadarIQTelemetry_init()
+ * @param stat The statistic
+ * @param value The sample
+ */
+static void RadarIQTelemetry_addSample(const RadarIQTelemetryHandle_t obj, const RadarIQTelemetryStat_t stat,
+        const int32_t value)
+{
+    const uint8_t slot = obj->slot[stat];
+
+    if (RADARIQ_TELEMETRY_NO_SLOT == slot)
+    {
+        return;
+    }
+
+    const uint8_t bucket = RadarIQTelemetry_getBucket(value);
+
+    for (uint8_t window = 0u; window < RADARIQ_TELEMETRY_NUM_WINDOWS; window++)
+    {
+        RadarIQTelemetryBin_t * const bin = RadarIQTelemetry_getBin(obj, slot, window, obj->clock[window].current);
+
+        if ((0u == bin->count) || (value < bin->min))
+        {
+            bin->min = value;
+        }
+        if ((0u == bin->count) || (value > bin->max))
+        {
+            bin->max = value;
+        }
+        bin->count++;
+        bin->sum += value;
+
+        if (UINT16_MAX > bin->buckets[bucket])
+        {
+            bin->buckets[bucket]++;
+        }
+    }
+}
+
+/**
+ * Gets a bin of a statistic's window.
+ *
+ * @param obj The telemetry handle returned from RadarIQTelemetry_init()
+ * @param slot The storage slot of the statistic
+ * @param window The window
+ * @param bin The bin index within the window
+ *
+ * @return Pointer to the bin
+ */
+static RadarIQTelemetryBin_t * RadarIQTelemetry_getBin(const RadarIQTelemetryHandle_t obj, const uint8_t slot,
+        const uint8_t window, const uint8_t bin)
+{
+    return &obj->bins[((((uint32_t)slot * RADARIQ_TELEMETRY_NUM_WINDOWS) + window) * RADARIQ_TELEMETRY_BINS) + bin];
+}
+
+/**
+ * Gets the log-linear histogram bucket of a sample. Negative samples share the first bucket.
+ *
+ * @param value The sample
+ *
+ * @return The bucket index
+ */
+static uint8_t RadarIQTelemetry_getBucket(const int32_t value)
+{
+    if (value < (int32_t)(1u << RADARIQ_TELEMETRY_SUB_BUCKET_BITS))
+    {
+        return (0 > value) ? 0u : (uint8_t)value;
+    }
+    if (value >= (int32_t)(1uL << RADARIQ_TELEMETRY_MAX_BITS))
+    {
+        return (uint8_t)(RADARIQ_TELEMETRY_BUCKETS - 1u);
+    }
+
+    const uint32_t v = (uint32_t)value;
+    uint8_t msb = RADARIQ_TELEMETRY_SUB_BUCKET_BITS;
+    while ((v >> (msb + 1u)) != 0u)
+    {
+        msb++;
+    }
+
+    const uint8_t shift = (uint8_t)(msb - RADARIQ_TELEMETRY_SUB_BUCKET_BITS);
+    const uint32_t subBucket = (v >> shift) & ((1u << RADARIQ_TELEMETRY_SUB_BUCKET_BITS) - 1u);
+
+    return (uint8_t)(((uint32_t)(shift + 1u) << RADARIQ_TELEMETRY_SUB_BUCKET_BITS) | subBucket);
+}
+
+/**
+ * Gets a percentile from a merged histogram.
+ *
+ * @param buckets The merged histogram bucket counts
+ * @param summary Pointer to the summary holding the count, min and max of the histogram
+ * @param percentile The percentile (0-100) to get
+ *
+ * @return The upper bound of the bucket holding the percentile, limited to the min and max samples
+ */
+static int32_t RadarIQTelemetry_getPercentile(const uint32_t * const buckets, const RadarIQTelemetrySummary_t * const summary,
+        const uint8_t percentile)
+{
+    const uint32_t target = (uint32_t)((((uint64_t)summary->count * percentile) + 99u) / 100u);
+    uint32_t cumulative = 0u;
+    uint8_t bucket;
+
+    for (bucket = 0u; bucket < (RADARIQ_TELEMETRY_BUCKETS - 1u); bucket++)
+    {
+        cumulative += buckets[bucket];
+        if ((cumulative >= target) && (0u < cumulative))
+        {
+            break;
+        }
+    }
+
+    int32_t upper;
+    if ((RADARIQ_TELEMETRY_BUCKETS - 1u) == bucket)
+    {
+        upper = summary->max;
+    }
+    else if (bucket < (1u << RADARIQ_TELEMETRY_SUB_BUCKET_BITS))
+    {
+        upper = (int32_t)bucket;
+    }
+    else
+    {
+        const uint32_t shift = (uint32_t)(bucket >> RADARIQ_TELEMETRY_SUB_BUCKET_BITS) - 1u;
+        const uint32_t mantissa = (1u << RADARIQ_TELEMETRY_SUB_BUCKET_BITS) |
+                (bucket & ((1u << RADARIQ_TELEMETRY_SUB_BUCKET_BITS) - 1u));
+        upper = (int32_t)(((mantissa + 1u) << shift) - 1u);
+    }
+
+    upper = (upper > summary->max) ? summary->max : upper;
+
+    return (upper < summary->min) ? summary->min : upper;
+}
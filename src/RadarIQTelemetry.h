@@ -0,0 +1,147 @@
+/**
+ * @file
+ * RadarIQ SDK - Device health telemetry.
+ * Rolling 1 second, 1 minute and 1 hour windows of the statistics reported by the device, in fixed memory
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+#ifndef SRC_RADARIQTELEMETRY_H_
+#define SRC_RADARIQTELEMETRY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQ.h"
+
+//===============================================================================================//
+// DEFINITIONS
+//===============================================================================================//
+
+#define RADARIQ_TELEMETRY_BINS             10u       ///< Number of bins each window is divided into
+#define RADARIQ_TELEMETRY_SUB_BUCKET_BITS  1u        ///< log2 of the number of histogram buckets per power of 2
+#define RADARIQ_TELEMETRY_MAX_BITS         20u       ///< Values from 2^MAX_BITS upwards share the last histogram bucket
+#define RADARIQ_TELEMETRY_BUCKETS          (((RADARIQ_TELEMETRY_MAX_BITS - RADARIQ_TELEMETRY_SUB_BUCKET_BITS) + 1u) \
+                                                << RADARIQ_TELEMETRY_SUB_BUCKET_BITS)
+
+#define RADARIQ_TELEMETRY_STAT_MASK(stat)  (1uL << (stat))    ///< Bit of a ::RadarIQTelemetryStat_t in the stat mask
+#define RADARIQ_TELEMETRY_ALL_STATS        ((1uL << RADARIQ_TELEMETRY_NUM_STATS) - 1uL)
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Statistics aggregated by the telemetry windows
+ */
+typedef enum
+{
+    RADARIQ_TELEMETRY_ACTIVE_FRAME_CPU_LOAD = 0,        ///< RadarIQProcessingStats_t::activeFrameCPULoad
+    RADARIQ_TELEMETRY_INTER_FRAME_CPU_LOAD = 1,         ///< RadarIQProcessingStats_t::interFrameCPULoad
+    RADARIQ_TELEMETRY_INTER_FRAME_PROC_TIME = 2,        ///< RadarIQProcessingStats_t::interFrameProcTime
+    RADARIQ_TELEMETRY_TRANSMIT_OUTPUT_TIME = 3,         ///< RadarIQProcessingStats_t::transmitOutputTime
+    RADARIQ_TELEMETRY_INTER_FRAME_PROC_MARGIN = 4,      ///< RadarIQProcessingStats_t::interFrameProcMargin
+    RADARIQ_TELEMETRY_INTER_CHIRP_PROC_MARGIN = 5,      ///< RadarIQProcessingStats_t::interChirpProcMargin
+    RADARIQ_TELEMETRY_UART_TRANSMIT_TIME = 6,           ///< RadarIQProcessingStats_t::uartTransmitTime
+    RADARIQ_TELEMETRY_TEMPERATURE_MAX = 7,              ///< Hottest of all RadarIQChipTemperatures_t readings
+    RADARIQ_TELEMETRY_TEMPERATURE_SENSOR0 = 8,          ///< RadarIQChipTemperatures_t::sensor0
+    RADARIQ_TELEMETRY_TEMPERATURE_SENSOR1 = 9,          ///< RadarIQChipTemperatures_t::sensor1
+    RADARIQ_TELEMETRY_TEMPERATURE_POWER = 10,           ///< RadarIQChipTemperatures_t::powerManagement
+    RADARIQ_TELEMETRY_TEMPERATURE_RX0 = 11,             ///< RadarIQChipTemperatures_t::rx0
+    RADARIQ_TELEMETRY_TEMPERATURE_RX1 = 12,             ///< RadarIQChipTemperatures_t::rx1
+    RADARIQ_TELEMETRY_TEMPERATURE_RX2 = 13,             ///< RadarIQChipTemperatures_t::rx2
+    RADARIQ_TELEMETRY_TEMPERATURE_RX3 = 14,             ///< RadarIQChipTemperatures_t::rx3
+    RADARIQ_TELEMETRY_TEMPERATURE_TX0 = 15,             ///< RadarIQChipTemperatures_t::tx0
+    RADARIQ_TELEMETRY_TEMPERATURE_TX1 = 16,             ///< RadarIQChipTemperatures_t::tx1
+    RADARIQ_TELEMETRY_TEMPERATURE_TX2 = 17,             ///< RadarIQChipTemperatures_t::tx2
+    RADARIQ_TELEMETRY_FRAME_AGGREGATING_TIME = 18,      ///< RadarIQPointcloudStats_t::frameAggregatingTime
+    RADARIQ_TELEMETRY_INTENSITY_SORT_TIME = 19,         ///< RadarIQPointcloudStats_t::intensitySortTime
+    RADARIQ_TELEMETRY_NEAREST_NEIGHBOURS_TIME = 20,     ///< RadarIQPointcloudStats_t::nearestNeighboursTime
+    RADARIQ_TELEMETRY_PC_UART_TRANSMIT_TIME = 21,       ///< RadarIQPointcloudStats_t::uartTransmitTime
+    RADARIQ_TELEMETRY_NUM_FILTERED_POINTS = 22,         ///< RadarIQPointcloudStats_t::numFilteredPoints
+    RADARIQ_TELEMETRY_NUM_POINTS_TRANSMITTED = 23,      ///< RadarIQPointcloudStats_t::numPointsTransmitted
+    RADARIQ_TELEMETRY_NUM_STATS = 24
+} RadarIQTelemetryStat_t;
+
+/**
+ * Rolling window lengths
+ */
+typedef enum
+{
+    RADARIQ_TELEMETRY_WINDOW_SECOND = 0,                ///< The last 1 second, in 100 ms bins
+    RADARIQ_TELEMETRY_WINDOW_MINUTE = 1,                ///< The last 1 minute, in 6 s bins
+    RADARIQ_TELEMETRY_WINDOW_HOUR = 2,                  ///< The last 1 hour, in 6 minute bins
+    RADARIQ_TELEMETRY_NUM_WINDOWS = 3
+} RadarIQTelemetryWindow_t;
+
+/**
+ * Telemetry configuration
+ */
+typedef struct
+{
+    uint32_t statMask;               ///< Bitmask of the ::RadarIQTelemetryStat_t to aggregate, each costs about 3 kB
+} RadarIQTelemetryConfig_t;
+
+/**
+ * Summary of one statistic over a window
+ * Percentiles are the upper bound of a histogram bucket (within 50% of the true value) limited to the min and max
+ */
+typedef struct
+{
+    uint32_t count;                  ///< Number of samples in the window
+    int32_t min;                     ///< Smallest sample
+    int32_t max;                     ///< Largest sample
+    float mean;                      ///< Mean of the samples
+    int32_t p50;                     ///< Median
+    int32_t p90;                     ///< 90th percentile
+    int32_t p99;                     ///< 99th percentile
+} RadarIQTelemetrySummary_t;
+
+/**
+ * Point-cloud truncation counts over a window
+ */
+typedef struct
+{
+    uint32_t frames;                 ///< Number of point-cloud statistics packets received
+    uint32_t inputTruncated;         ///< Number of frames whose aggregated points were truncated
+    uint32_t outputTruncated;        ///< Number of frames whose transmitted points were truncated
+} RadarIQTelemetryTruncation_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+typedef struct RadarIQTelemetry_t RadarIQTelemetry_t;
+typedef RadarIQTelemetry_t* RadarIQTelemetryHandle_t;
+
+//===============================================================================================//
+// FUNCTIONS
+//===============================================================================================//
+
+RadarIQTelemetryHandle_t RadarIQTelemetry_init(const RadarIQTelemetryConfig_t * const config);
+void RadarIQTelemetry_destroy(const RadarIQTelemetryHandle_t obj);
+void RadarIQTelemetry_reset(const RadarIQTelemetryHandle_t obj);
+void RadarIQTelemetry_addProcessingStats(const RadarIQTelemetryHandle_t obj,
+        const RadarIQProcessingStats_t * const processing, const RadarIQChipTemperatures_t * const temperatures,
+        const uint32_t timeMillis);
+void RadarIQTelemetry_addPointCloudStats(const RadarIQTelemetryHandle_t obj,
+        const RadarIQPointcloudStats_t * const pointcloud, const uint32_t timeMillis);
+RadarIQReturnVal_t RadarIQTelemetry_getSummary(const RadarIQTelemetryHandle_t obj, const RadarIQTelemetryStat_t stat,
+        const RadarIQTelemetryWindow_t window, const uint32_t timeMillis, RadarIQTelemetrySummary_t * const dest);
+void RadarIQTelemetry_getTruncation(const RadarIQTelemetryHandle_t obj, const RadarIQTelemetryWindow_t window,
+        const uint32_t timeMillis, RadarIQTelemetryTruncation_t * const dest);
+uint32_t RadarIQTelemetry_getMemoryUsage(const RadarIQTelemetryConfig_t * const config);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_RADARIQTELEMETRY_H_ */
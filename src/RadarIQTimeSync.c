@@ -0,0 +1,476 @@
+/**
+ * @file
+ * RadarIQ SDK - Host/device clock synchronisation.
+ * Delays on the way to the host only ever make a frame late, so arrival times are fitted against device frame index
+ * by the lower envelope of the arrivals rather than by least squares. The period is fitted over the least delayed
+ * frame of each block of frames, which spans far longer than the window, and the line is then lowered to the
+ * earliest arrival in the window before the capture-to-arrival latency is subtracted.
+ * Times are host microseconds and may wrap.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQTimeSync.h"
+#include <math.h>
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * A fitted frame
+ */
+typedef struct
+{
+    uint32_t index;                  ///< Device frame index
+    uint32_t arrivalMicros;          ///< Arrival time of the frame's END subframe
+} RadarIQTimeSyncSample_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+/**
+ * The RadarIQ time sync object definition
+ */
+struct RadarIQTimeSync_t
+{
+    RadarIQTimeSyncConfig_t config;
+    RadarIQTimeSyncSample_t samples[RADARIQ_TIMESYNC_MAX_WINDOW];   ///< Ring of the most recent frames
+    uint8_t numSamples;
+    uint8_t head;                    ///< Ring position the next sample is written to
+    RadarIQTimeSyncSample_t blocks[RADARIQ_TIMESYNC_MAX_WINDOW];    ///< Ring of the least delayed frame of recent blocks
+    uint8_t numBlocks;
+    uint8_t blockHead;               ///< Ring position the next block is written to
+    uint8_t blockFrames;             ///< Number of frames in the block being collected
+    RadarIQTimeSyncSample_t blockBest;  ///< Least delayed frame of the block being collected
+    bool hasFrame;
+    uint32_t lastIndex;
+    uint32_t lastArrival;
+    uint32_t originIndex;            ///< Index of the oldest sample, the fit is relative to it
+    uint32_t originArrival;          ///< Arrival time of the oldest sample
+    double period;                   ///< Fitted frame period in microseconds
+    double offset;                   ///< Fitted arrival of the origin lowered to the earliest arrival, relative to originArrival
+    RadarIQTimeSyncEstimate_t estimate;
+};
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTION PROTOTYPES
+//===============================================================================================//
+
+static void RadarIQTimeSync_clearFit(const RadarIQTimeSyncHandle_t obj);
+static void RadarIQTimeSync_addBlockSample(const RadarIQTimeSyncHandle_t obj, const RadarIQTimeSyncSample_t * const sample);
+static void RadarIQTimeSync_fit(const RadarIQTimeSyncHandle_t obj);
+static bool RadarIQTimeSync_fitLowerHull(const RadarIQTimeSyncSample_t * const ring, const uint8_t size,
+        const uint8_t count, const uint8_t first, double * const period);
+static uint16_t RadarIQTimeSync_getStep(const RadarIQTimeSyncHandle_t obj, const int32_t elapsed, bool * const isConsistent);
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Allocates and initializes a time sync instance using heap allocation. One instance is needed per sensor.
+ *
+ * @param config Pointer to the time sync configuration
+ *
+ * @return A handle for an instance of the RadarIQTimeSync_t object
+ */
+RadarIQTimeSyncHandle_t RadarIQTimeSync_init(const RadarIQTimeSyncConfig_t * const config)
+{
+    RADARIQ_ASSERT(NULL != config);
+    RADARIQ_ASSERT(RADARIQ_TIMESYNC_MIN_WINDOW <= config->windowSize);
+
+    RadarIQTimeSyncHandle_t handle = malloc(sizeof(RadarIQTimeSync_t));
+    RADARIQ_ASSERT(NULL != handle);
+    memset((void*)handle, 0, sizeof(RadarIQTimeSync_t));
+
+    handle->config = *config;
+    handle->estimate.latencyMicros = config->hostLatencyMicros;
+
+    return handle;
+}
+
+/**
+ * Frees a time sync instance created by RadarIQTimeSync_init().
+ *
+ * @param obj The time sync handle returned from RadarIQTimeSync_init()
+ */
+void RadarIQTimeSync_destroy(const RadarIQTimeSyncHandle_t obj)
+{
+    free(obj);
+}
+
+/**
+ * Discards the fit and the counters, e.g. after the frame rate is changed or capture is restarted.
+ * The latency from the last processing statistics is kept.
+ *
+ * @param obj The time sync handle returned from RadarIQTimeSync_init()
+ */
+void RadarIQTimeSync_reset(const RadarIQTimeSyncHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    const uint32_t latencyMicros = obj->estimate.latencyMicros;
+
+    RadarIQTimeSync_clearFit(obj);
+    obj->hasFrame = false;
+    memset((void*)&obj->estimate, 0, sizeof(RadarIQTimeSyncEstimate_t));
+    obj->estimate.latencyMicros = latencyMicros;
+}
+
+/**
+ * Updates the capture-to-arrival latency from the device's processing statistics.
+ * transmitOutputTime covers processing and sending a frame, uartTransmitTime is used if it is longer.
+ *
+ * @param obj The time sync handle returned from RadarIQTimeSync_init()
+ * @param stats Pointer to the statistics from RadarIQ_getProcessingStats()
+ */
+void RadarIQTimeSync_addProcessingStats(const RadarIQTimeSyncHandle_t obj,
+        const RadarIQProcessingStats_t * const stats)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != stats);
+
+    const uint32_t deviceMicros = (stats->uartTransmitTime > stats->transmitOutputTime) ?
+            stats->uartTransmitTime : stats->transmitOutputTime;
+
+    obj->estimate.latencyMicros = deviceMicros + obj->config.hostLatencyMicros;
+}
+
+/**
+ * Adds a frame and estimates its capture instant.
+ * Should be called with the time a ::RADARIQ_CMD_PNT_CLOUD_FRAME or ::RADARIQ_CMD_OBJ_TRACKING_FRAME packet is
+ * returned from RadarIQ_readSerial(), i.e. when the frame's END subframe arrived.
+ *
+ * @param obj The time sync handle returned from RadarIQTimeSync_init()
+ * @param arrivalMicros Host time the frame's END subframe arrived in microseconds
+ * @param dest Pointer to a RadarIQTimeSyncFrame_t struct to write the frame's timing into, or NULL
+ */
+void RadarIQTimeSync_addFrame(const RadarIQTimeSyncHandle_t obj, const uint32_t arrivalMicros,
+        RadarIQTimeSyncFrame_t * const dest)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    uint32_t index = 0u;
+    uint16_t missed = 0u;
+
+    if (obj->hasFrame)
+    {
+        bool isConsistent;
+        const uint16_t step = RadarIQTimeSync_getStep(obj, (int32_t)(arrivalMicros - obj->lastArrival), &isConsistent);
+
+        if (!isConsistent)
+        {
+            RadarIQTimeSync_clearFit(obj);
+            obj->estimate.resets++;
+        }
+
+        index = obj->lastIndex + step;
+        missed = step - 1u;
+    }
+
+    obj->hasFrame = true;
+    obj->lastIndex = index;
+    obj->lastArrival = arrivalMicros;
+    obj->estimate.frames++;
+    obj->estimate.missed += missed;
+
+    RadarIQTimeSyncSample_t * const sample = &obj->samples[obj->head];
+    sample->index = index;
+    sample->arrivalMicros = arrivalMicros;
+    obj->head = (uint8_t)((obj->head + 1u) % obj->config.windowSize);
+    if (obj->numSamples < obj->config.windowSize)
+    {
+        obj->numSamples++;
+    }
+
+    RadarIQTimeSync_addBlockSample(obj, sample);
+    RadarIQTimeSync_fit(obj);
+
+    if (NULL != dest)
+    {
+        uint32_t fittedMicros = arrivalMicros;
+
+        if (obj->estimate.isLocked)
+        {
+            const double fitted = obj->offset + (obj->period * (double)(uint32_t)(index - obj->originIndex));
+            fittedMicros = obj->originArrival + (uint32_t)(int32_t)lround(fitted);
+        }
+
+        dest->arrivalMicros = arrivalMicros;
+        dest->captureMicros = fittedMicros - obj->estimate.latencyMicros;
+        dest->index = index;
+        dest->missed = missed;
+        dest->isLocked = obj->estimate.isLocked;
+    }
+}
+
+/**
+ * Gets the current estimate of the device frame period, drift and latency.
+ *
+ * @param obj The time sync handle returned from RadarIQTimeSync_init()
+ * @param dest Pointer to a RadarIQTimeSyncEstimate_t struct to copy the estimate into
+ */
+void RadarIQTimeSync_getEstimate(const RadarIQTimeSyncHandle_t obj, RadarIQTimeSyncEstimate_t * const dest)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != dest);
+
+    *dest = obj->estimate;
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Empties the window, the next frames start a new fit.
+ *
+ * @param obj The time sync handle returned from RadarIQTimeSync_init()
+ */
+static void RadarIQTimeSync_clearFit(const RadarIQTimeSyncHandle_t obj)
+{
+    obj->numSamples = 0u;
+    obj->head = 0u;
+    obj->numBlocks = 0u;
+    obj->blockHead = 0u;
+    obj->blockFrames = 0u;
+    obj->period = 0.0;
+    obj->offset = 0.0;
+    obj->estimate.isLocked = false;
+    obj->estimate.periodMicros = 0.0f;
+    obj->estimate.driftPpm = 0.0f;
+    obj->estimate.jitterMicros = 0.0f;
+}
+
+/**
+ * Keeps the least delayed frame of every ::RADARIQ_TIMESYNC_BLOCK_FRAMES frames, so the period can be fitted over a
+ * longer baseline than the window.
+ *
+ * @param obj The time sync handle returned from RadarIQTimeSync_init()
+ * @param sample The frame just added
+ */
+static void RadarIQTimeSync_addBlockSample(const RadarIQTimeSyncHandle_t obj, const RadarIQTimeSyncSample_t * const sample)
+{
+    double period = 0.0;
+
+    if (obj->estimate.isLocked)
+    {
+        period = obj->period;
+    }
+    else if (0u < obj->config.frameRate)
+    {
+        period = 1000000.0 / (double)obj->config.frameRate;
+    }
+
+    // Frames are compared along the current period, the one arriving earliest against it is the least delayed
+    if ((0u == obj->blockFrames) ||
+            (0.0 > ((double)(int32_t)(sample->arrivalMicros - obj->blockBest.arrivalMicros) -
+            (period * (double)(uint32_t)(sample->index - obj->blockBest.index)))))
+    {
+        obj->blockBest = *sample;
+    }
+
+    obj->blockFrames++;
+    if (RADARIQ_TIMESYNC_BLOCK_FRAMES > obj->blockFrames)
+    {
+        return;
+    }
+
+    obj->blocks[obj->blockHead] = obj->blockBest;
+    obj->blockHead = (uint8_t)((obj->blockHead + 1u) % obj->config.windowSize);
+    if (obj->numBlocks < obj->config.windowSize)
+    {
+        obj->numBlocks++;
+    }
+    obj->blockFrames = 0u;
+}
+
+/**
+ * Fits arrival time against frame index and updates the estimate.
+ * The period is the slope of the blocks' lower envelope once they span further than the window, otherwise of the
+ * window's. The line is then lowered to the earliest arrival in the window.
+ *
+ * @param obj The time sync handle returned from RadarIQTimeSync_init()
+ */
+static void RadarIQTimeSync_fit(const RadarIQTimeSyncHandle_t obj)
+{
+    // The oldest sample is at the head once the ring is full
+    const uint8_t first = (obj->numSamples < obj->config.windowSize) ? 0u : obj->head;
+    const RadarIQTimeSyncSample_t * const origin = &obj->samples[first];
+    double period;
+
+    if (!RadarIQTimeSync_fitLowerHull(obj->samples, obj->config.windowSize, obj->numSamples, first, &period))
+    {
+        return;
+    }
+
+    if (((uint32_t)obj->numBlocks * RADARIQ_TIMESYNC_BLOCK_FRAMES) > obj->numSamples)
+    {
+        const uint8_t firstBlock = (obj->numBlocks < obj->config.windowSize) ? 0u : obj->blockHead;
+
+        (void)RadarIQTimeSync_fitLowerHull(obj->blocks, obj->config.windowSize, obj->numBlocks, firstBlock, &period);
+    }
+
+    double minResidual = 0.0;
+    double sumSquares = 0.0;
+
+    for (uint8_t i = 0u; i < obj->numSamples; i++)
+    {
+        const RadarIQTimeSyncSample_t * const sample = &obj->samples[(first + i) % obj->config.windowSize];
+        const double residual = (double)(int32_t)(sample->arrivalMicros - origin->arrivalMicros) -
+                (period * (double)(uint32_t)(sample->index - origin->index));
+
+        if ((0u == i) || (residual < minResidual))
+        {
+            minResidual = residual;
+        }
+    }
+
+    for (uint8_t i = 0u; i < obj->numSamples; i++)
+    {
+        const RadarIQTimeSyncSample_t * const sample = &obj->samples[(first + i) % obj->config.windowSize];
+        const double residual = (double)(int32_t)(sample->arrivalMicros - origin->arrivalMicros) -
+                (minResidual + (period * (double)(uint32_t)(sample->index - origin->index)));
+
+        sumSquares += residual * residual;
+    }
+
+    obj->originIndex = origin->index;
+    obj->originArrival = origin->arrivalMicros;
+    obj->period = period;
+    obj->offset = minResidual;
+
+    obj->estimate.isLocked = (RADARIQ_TIMESYNC_MIN_WINDOW <= obj->numSamples);
+    obj->estimate.periodMicros = (float)period;
+    obj->estimate.jitterMicros = (float)sqrt(sumSquares / (double)obj->numSamples);
+
+    if (0u < obj->config.frameRate)
+    {
+        const double nominal = 1000000.0 / (double)obj->config.frameRate;
+        obj->estimate.driftPpm = (float)(((period - nominal) / nominal) * 1000000.0);
+    }
+}
+
+/**
+ * Fits the slope of the lower envelope of a ring of samples. Of the lines below every sample, the one closest to them
+ * on average runs along the edge of their lower convex hull that spans their mean index.
+ *
+ * @param ring The ring of samples, in increasing index order from the oldest
+ * @param size Number of entries in the ring
+ * @param count Number of samples in the ring
+ * @param first Ring position of the oldest sample
+ * @param period Pointer to write the slope in microseconds per frame to
+ *
+ * @return False if there are fewer than two samples
+ */
+static bool RadarIQTimeSync_fitLowerHull(const RadarIQTimeSyncSample_t * const ring, const uint8_t size,
+        const uint8_t count, const uint8_t first, double * const period)
+{
+    const RadarIQTimeSyncSample_t * const origin = &ring[first];
+    double x[RADARIQ_TIMESYNC_MAX_WINDOW];
+    double y[RADARIQ_TIMESYNC_MAX_WINDOW];
+    uint8_t hull[RADARIQ_TIMESYNC_MAX_WINDOW];
+    uint8_t numHull = 0u;
+    double sumX = 0.0;
+
+    // Indices only increase along the ring, so a monotone chain builds the lower hull in one pass
+    for (uint8_t i = 0u; i < count; i++)
+    {
+        const RadarIQTimeSyncSample_t * const sample = &ring[(first + i) % size];
+
+        x[i] = (double)(uint32_t)(sample->index - origin->index);
+        y[i] = (double)(int32_t)(sample->arrivalMicros - origin->arrivalMicros);
+        sumX += x[i];
+
+        while (2u <= numHull)
+        {
+            const uint8_t a = hull[numHull - 2u];
+            const uint8_t b = hull[numHull - 1u];
+
+            if (0.0 < (((x[b] - x[a]) * (y[i] - y[a])) - ((y[b] - y[a]) * (x[i] - x[a]))))
+            {
+                break;
+            }
+            numHull--;
+        }
+        hull[numHull] = i;
+        numHull++;
+    }
+
+    if (2u > numHull)
+    {
+        return false;
+    }
+
+    const double meanX = sumX / (double)count;
+    uint8_t edge = 0u;
+
+    while (((edge + 2u) < numHull) && (x[hull[edge + 1u]] < meanX))
+    {
+        edge++;
+    }
+
+    const uint8_t a = hull[edge];
+    const uint8_t b = hull[edge + 1u];
+
+    *period = (y[b] - y[a]) / (x[b] - x[a]);
+
+    return true;
+}
+
+/**
+ * Works out how many device frames passed between the previous frame and one that arrived after it.
+ * Frames are spaced by the fitted period once locked, otherwise by the configured frame rate if known.
+ *
+ * @param obj The time sync handle returned from RadarIQTimeSync_init()
+ * @param elapsed Microseconds between the previous frame's arrival and this one
+ * @param isConsistent Pointer to write false to if the arrival doesn't fit the current estimate
+ *
+ * @return The number of frame periods elapsed, at least 1
+ */
+static uint16_t RadarIQTimeSync_getStep(const RadarIQTimeSyncHandle_t obj, const int32_t elapsed, bool * const isConsistent)
+{
+    double period = 0.0;
+
+    *isConsistent = true;
+
+    if (obj->estimate.isLocked)
+    {
+        period = obj->period;
+    }
+    else if (0u < obj->config.frameRate)
+    {
+        period = 1000000.0 / (double)obj->config.frameRate;
+    }
+
+    if (0 >= elapsed)
+    {
+        *isConsistent = false;
+        return 1u;
+    }
+
+    if (0.0 >= period)
+    {
+        return 1u;
+    }
+
+    const long steps = lround((double)elapsed / period);
+
+    // A gap longer than the window can't be counted reliably, the fit starts over
+    if (steps > (long)obj->config.windowSize)
+    {
+        *isConsistent = false;
+        return (uint16_t)((UINT16_MAX < steps) ? UINT16_MAX : steps);
+    }
+
+    return (1 > steps) ? 1u : (uint16_t)steps;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file
+ * RadarIQ SDK - Host/device clock synchronisation.
+ * Frames carry no device timestamp, so each frame's capture instant is estimated on the host clock: a line fitted
+ * to the arrival times of recent frames' END subframes gives the device frame period and its drift against the host,
+ * and the device-reported output time is subtracted from the fitted arrival. The fit removes UART and scheduling
+ * jitter, so frames from several sensors, each with its own instance, can be aligned on one clock.
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+#ifndef SRC_RADARIQTIMESYNC_H_
+#define SRC_RADARIQTIMESYNC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQ.h"
+
+//===============================================================================================//
+// DEFINITIONS
+//===============================================================================================//
+
+#define RADARIQ_TIMESYNC_MIN_WINDOW        4u        ///< Fewest frames the period is fitted over
+#define RADARIQ_TIMESYNC_MAX_WINDOW        255u      ///< Most frames in the window the capture instants are fitted over
+#define RADARIQ_TIMESYNC_BLOCK_FRAMES      16u       ///< Frames per block, the period is fitted over as many blocks as the window has frames
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Time sync configuration
+ */
+typedef struct
+{
+    uint8_t windowSize;              ///< Number of recent frames fitted, ::RADARIQ_TIMESYNC_MIN_WINDOW to ::RADARIQ_TIMESYNC_MAX_WINDOW, larger is steadier
+    uint8_t frameRate;               ///< Configured frame rate in frames/second the drift is measured against, 0 if unknown
+    uint32_t hostLatencyMicros;      ///< Fixed delay between the END subframe leaving the device and its arrival time, e.g. USB buffering
+} RadarIQTimeSyncConfig_t;
+
+/**
+ * Timing of one frame on the host clock
+ */
+typedef struct
+{
+    uint32_t arrivalMicros;          ///< Arrival time of the frame's END subframe
+    uint32_t captureMicros;          ///< Estimated capture instant of the frame
+    uint32_t index;                  ///< Number of device frames since the last reset, including missed frames
+    uint16_t missed;                 ///< Number of frames missed between the previous frame and this one
+    bool isLocked;                   ///< The capture instant is from the fitted line rather than the raw arrival time
+} RadarIQTimeSyncFrame_t;
+
+/**
+ * Current estimate of the device clock
+ */
+typedef struct
+{
+    bool isLocked;                   ///< At least ::RADARIQ_TIMESYNC_MIN_WINDOW frames have been fitted
+    float periodMicros;              ///< Device frame period measured on the host clock
+    float driftPpm;                  ///< Deviation of the measured period from the configured frame rate in parts per million
+    float jitterMicros;              ///< RMS arrival time residual from the fitted line
+    uint32_t latencyMicros;          ///< Capture to arrival delay subtracted from the fitted arrival times
+    uint32_t frames;                 ///< Number of frames added since the last reset
+    uint32_t missed;                 ///< Number of frames missed since the last reset
+    uint32_t resets;                 ///< Number of times the fit restarted because arrivals were inconsistent with it
+} RadarIQTimeSyncEstimate_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+typedef struct RadarIQTimeSync_t RadarIQTimeSync_t;
+typedef RadarIQTimeSync_t* RadarIQTimeSyncHandle_t;
+
+//===============================================================================================//
+// FUNCTIONS
+//===============================================================================================//
+
+RadarIQTimeSyncHandle_t RadarIQTimeSync_init(const RadarIQTimeSyncConfig_t * const config);
+void RadarIQTimeSync_destroy(const RadarIQTimeSyncHandle_t obj);
+void RadarIQTimeSync_reset(const RadarIQTimeSyncHandle_t obj);
+void RadarIQTimeSync_addProcessingStats(const RadarIQTimeSyncHandle_t obj,
+        const RadarIQProcessingStats_t * const stats);
+void RadarIQTimeSync_addFrame(const RadarIQTimeSyncHandle_t obj, const uint32_t arrivalMicros,
+        RadarIQTimeSyncFrame_t * const dest);
+void RadarIQTimeSync_getEstimate(const RadarIQTimeSyncHandle_t obj, RadarIQTimeSyncEstimate_t * const dest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_RADARIQTIMESYNC_H_ */
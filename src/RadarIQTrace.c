@@ -0,0 +1,186 @@
+/**
+ * @file
+ * RadarIQ SDK - Trace dumper.
+ * Writes packet pipeline trace events as Chrome trace-event JSON for viewing in chrome://tracing or Perfetto
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQTrace.h"
+#include <stdarg.h>
+
+//===============================================================================================//
+// CONSTANTS
+//===============================================================================================//
+
+#define RADARIQ_TRACE_TID_RX          1u        ///< Timeline of received bytes and packets
+#define RADARIQ_TRACE_TID_COMMANDS    2u        ///< Timeline of command round-trips
+
+/**
+ * Names of the trace points, indexed by RadarIQTraceEvent_t
+ */
+static const char * const RadarIQTrace_eventNames[] =
+{
+    "byte received", "header", "footer", "decode done", "crc done", "parse done", "command sent", "response matched"
+};
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTION PROTOTYPES
+//===============================================================================================//
+
+static void RadarIQTrace_writeEvent(FILE * const file, bool * const isFirst, const char * const format, ...);
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Writes trace events as a Chrome trace-event JSON document.
+ * Every event is written as an instant event. Each packet from header to parse done, and each command from
+ * being sent to its response, is also written as a complete event so the pipeline stages show as spans.
+ *
+ * @param events The trace events, oldest first, as read by RadarIQ_getTraceEvents()
+ * @param numEvents Number of trace events
+ * @param file The file to write to
+ *
+ * @return RADARIQ_RETURN_VAL_ERR if writing to the file failed, otherwise RADARIQ_RETURN_VAL_OK
+ */
+RadarIQReturnVal_t RadarIQTrace_writeChromeJson(const RadarIQTraceRecord_t * const events, const uint32_t numEvents,
+        FILE * const file)
+{
+    RADARIQ_ASSERT((NULL != events) || (0u == numEvents));
+    RADARIQ_ASSERT(NULL != file);
+
+    const uint8_t numNames = (uint8_t)(sizeof(RadarIQTrace_eventNames) / sizeof(RadarIQTrace_eventNames[0]));
+    bool isFirst = true;
+    bool isInPacket = false;
+    uint32_t packetStart = 0u;
+    bool isCommandPending = false;
+    uint32_t commandStart = 0u;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    RadarIQTrace_writeEvent(file, &isFirst, "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\","
+            "\"args\":{\"name\":\"rx\"}}", RADARIQ_TRACE_TID_RX);
+    RadarIQTrace_writeEvent(file, &isFirst, "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\","
+            "\"args\":{\"name\":\"commands\"}}", RADARIQ_TRACE_TID_COMMANDS);
+
+    for (uint32_t idx = 0u; idx < numEvents; idx++)
+    {
+        const RadarIQTraceRecord_t * const record = &events[idx];
+        const char * const name = (record->event < numNames) ? RadarIQTrace_eventNames[record->event] : "unknown";
+        const uint8_t tid = ((RADARIQ_TRACE_COMMAND_SENT == record->event) ||
+                (RADARIQ_TRACE_RESPONSE_MATCHED == record->event)) ? RADARIQ_TRACE_TID_COMMANDS : RADARIQ_TRACE_TID_RX;
+
+        RadarIQTrace_writeEvent(file, &isFirst, "{\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%lu,"
+                "\"name\":\"%s\",\"args\":{\"arg\":%u}}", tid, (unsigned long)record->timeMicros, name, record->arg);
+
+        switch (record->event)
+        {
+        case RADARIQ_TRACE_HEADER:
+        {
+            isInPacket = true;
+            packetStart = record->timeMicros;
+            break;
+        }
+        case RADARIQ_TRACE_PARSE_DONE:
+        {
+            if (isInPacket)
+            {
+                RadarIQTrace_writeEvent(file, &isFirst, "{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%lu,\"dur\":%lu,"
+                        "\"name\":\"packet 0x%02X\"}", RADARIQ_TRACE_TID_RX, (unsigned long)packetStart,
+                        (unsigned long)(record->timeMicros - packetStart), record->arg);
+            }
+            isInPacket = false;
+            break;
+        }
+        case RADARIQ_TRACE_CRC_DONE:
+        {
+            // A failed CRC ends the packet without it being parsed
+            isInPacket = isInPacket && (0u != record->arg);
+            break;
+        }
+        case RADARIQ_TRACE_COMMAND_SENT:
+        {
+            isCommandPending = true;
+            commandStart = record->timeMicros;
+            break;
+        }
+        case RADARIQ_TRACE_RESPONSE_MATCHED:
+        {
+            if (isCommandPending)
+            {
+                RadarIQTrace_writeEvent(file, &isFirst, "{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%lu,\"dur\":%lu,"
+                        "\"name\":\"command 0x%02X\"}", RADARIQ_TRACE_TID_COMMANDS, (unsigned long)commandStart,
+                        (unsigned long)(record->timeMicros - commandStart), record->arg);
+            }
+            isCommandPending = false;
+            break;
+        }
+        default:
+        {
+            break;
+        }
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+
+    return (0 == ferror(file)) ? RADARIQ_RETURN_VAL_OK : RADARIQ_RETURN_VAL_ERR;
+}
+
+/**
+ * Reads every trace event recorded by a RadarIQ handle and writes them as a Chrome trace-event JSON document.
+ *
+ * @param obj The RadarIQ object handle returned from RadarIQ_init()
+ * @param file The file to write to
+ *
+ * @return RADARIQ_RETURN_VAL_ERR if writing to the file failed, otherwise RADARIQ_RETURN_VAL_OK
+ */
+RadarIQReturnVal_t RadarIQTrace_dump(const RadarIQHandle_t obj, FILE * const file)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT(NULL != file);
+
+    RadarIQTraceRecord_t * const events = malloc(sizeof(RadarIQTraceRecord_t) * RADARIQ_TRACE_BUFFER_SIZE);
+    RADARIQ_ASSERT(NULL != events);
+
+    const uint16_t numEvents = RadarIQ_getTraceEvents(obj, events, RADARIQ_TRACE_BUFFER_SIZE);
+    const RadarIQReturnVal_t ret = RadarIQTrace_writeChromeJson(events, numEvents, file);
+
+    free(events);
+
+    return ret;
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Writes one event object to the traceEvents array, preceded by a separator unless it is the first.
+ *
+ * @param file The file to write to
+ * @param isFirst Pointer to a flag which is set while no event has been written
+ * @param format The printf format string of the event object
+ */
+static void RadarIQTrace_writeEvent(FILE * const file, bool * const isFirst, const char * const format, ...)
+{
+    va_list args;
+
+    if (!*isFirst)
+    {
+        fprintf(file, ",\n");
+    }
+    *isFirst = false;
+
+    va_start(args, format);
+    vfprintf(file, format, args);
+    va_end(args);
+}
@@ -0,0 +1,37 @@
+/**
+ * @file
+ * RadarIQ SDK - Trace dumper.
+ * Writes packet pipeline trace events as Chrome trace-event JSON for viewing in chrome://tracing or Perfetto
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+#ifndef SRC_RADARIQTRACE_H_
+#define SRC_RADARIQTRACE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQ.h"
+
+//===============================================================================================//
+// FUNCTIONS
+//===============================================================================================//
+
+RadarIQReturnVal_t RadarIQTrace_writeChromeJson(const RadarIQTraceRecord_t * const events, const uint32_t numEvents,
+        FILE * const file);
+RadarIQReturnVal_t RadarIQTrace_dump(const RadarIQHandle_t obj, FILE * const file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_RADARIQTRACE_H_ */
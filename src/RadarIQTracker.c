@@ -0,0 +1,599 @@
+/**
+ * @file
+ * RadarIQ SDK - Multi-target tracker.
+ * Host-side Kalman filter tracking of clustered point-cloud detections using fixed-capacity storage
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQTracker.h"
+#include <math.h>
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Kalman filter states of one axis - position, velocity and acceleration
+ */
+typedef struct
+{
+    float x[3];                      ///< State vector
+    float p[3][3];                   ///< State covariance
+} RadarIQTrackAxis_t;
+
+/**
+ * Track lifecycle states
+ */
+typedef enum
+{
+    RADARIQ_TRACK_FREE = 0,          ///< Track slot is unused
+    RADARIQ_TRACK_TENTATIVE = 1,     ///< Track has not yet been confirmed
+    RADARIQ_TRACK_CONFIRMED = 2      ///< Track is confirmed and reported
+} RadarIQTrackState_t;
+
+/**
+ * A single track
+ */
+typedef struct
+{
+    RadarIQTrackAxis_t axis[3];      ///< Per-axis filters for x, y and z
+    RadarIQTrackState_t state;       ///< Lifecycle state
+    uint8_t targetId;                ///< Reported target ID
+    uint8_t hits;                    ///< Number of associated detections, saturating
+    uint8_t misses;                  ///< Number of consecutive updates without a detection
+} RadarIQTrack_t;
+
+/**
+ * A detection to track pairing that passed the association gate
+ */
+typedef struct
+{
+    float distance;                  ///< Normalised innovation squared
+    uint16_t track;                  ///< Track index
+    uint16_t detection;              ///< Detection index
+} RadarIQTrackPair_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+/**
+ * The RadarIQ tracker object definition
+ * All arrays are carved from a single allocation made in RadarIQTracker_init()
+ */
+struct RadarIQTracker_t
+{
+    RadarIQTrackerConfig_t config;
+    float measurementVar;
+    uint32_t lastTime;
+    bool hasTime;
+    uint8_t nextTargetId;
+
+    RadarIQTrack_t * tracks;
+    RadarIQTrackPair_t * pairs;      ///< Gated pairs, maxTracks * maxDetections entries
+    uint8_t * trackUsed;             ///< Flags tracks associated in the current update
+    uint8_t * detectionUsed;         ///< Flags detections associated in the current update
+};
+
+//===============================================================================================//
+// CONSTANTS
+//===============================================================================================//
+
+#define RADARIQ_TRACKER_INIT_VEL_VAR      (1000.0f * 1000.0f)    ///< Initial velocity variance in (mm/s)^2
+#define RADARIQ_TRACKER_INIT_ACC_VAR      (2000.0f * 2000.0f)    ///< Initial acceleration variance in (mm/s^2)^2
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTION PROTOTYPES
+//===============================================================================================//
+
+static void RadarIQTracker_predict(const RadarIQTrackerHandle_t obj, RadarIQTrackAxis_t * const axis, const float dt);
+static void RadarIQTracker_correct(const RadarIQTrackerHandle_t obj, RadarIQTrackAxis_t * const axis, const float z);
+static float RadarIQTracker_getDistance(const RadarIQTrackerHandle_t obj, const RadarIQTrack_t * const track,
+        const RadarIQCluster_t * const detection);
+static void RadarIQTracker_spawn(const RadarIQTrackerHandle_t obj, RadarIQTrack_t * const track,
+        const RadarIQCluster_t * const detection);
+static void RadarIQTracker_sortPairs(RadarIQTrackPair_t * const pairs, const uint32_t numPairs);
+static int16_t RadarIQTracker_toInt16(const float value);
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Allocates and initializes a tracker instance using heap allocation.
+ * All track storage is allocated here so that RadarIQTracker_update() never allocates.
+ *
+ * @param config Pointer to the tracker configuration
+ *
+ * @return A handle for an instance of the RadarIQTracker_t object
+ */
+RadarIQTrackerHandle_t RadarIQTracker_init(const RadarIQTrackerConfig_t * const config)
+{
+    RADARIQ_ASSERT(NULL != config);
+    RADARIQ_ASSERT(0u < config->maxTracks);
+    RADARIQ_ASSERT(0u < config->maxDetections);
+    RADARIQ_ASSERT(0.0f < config->measurementNoise);
+    RADARIQ_ASSERT(0.0f < config->gate);
+
+    RadarIQTrackerHandle_t handle = malloc(RadarIQTracker_getMemoryUsage(config));
+    RADARIQ_ASSERT(NULL != handle);
+    memset((void*)handle, 0, RadarIQTracker_getMemoryUsage(config));
+
+    handle->config = *config;
+    handle->measurementVar = config->measurementNoise * config->measurementNoise;
+
+    uint8_t * mem = (uint8_t*)(handle + 1);
+    handle->tracks = (RadarIQTrack_t*)mem;
+    mem += sizeof(RadarIQTrack_t) * config->maxTracks;
+    handle->pairs = (RadarIQTrackPair_t*)mem;
+    mem += sizeof(RadarIQTrackPair_t) * (uint32_t)config->maxTracks * (uint32_t)config->maxDetections;
+    handle->trackUsed = mem;
+    mem += config->maxTracks;
+    handle->detectionUsed = mem;
+
+    return handle;
+}
+
+/**
+ * Frees a tracker instance created by RadarIQTracker_init().
+ *
+ * @param obj The tracker handle returned from RadarIQTracker_init()
+ */
+void RadarIQTracker_destroy(const RadarIQTrackerHandle_t obj)
+{
+    free(obj);
+}
+
+/**
+ * Deletes all tracks.
+ *
+ * @param obj The tracker handle returned from RadarIQTracker_init()
+ */
+void RadarIQTracker_reset(const RadarIQTrackerHandle_t obj)
+{
+    RADARIQ_ASSERT(NULL != obj);
+
+    for (uint16_t idx = 0u; idx < obj->config.maxTracks; idx++)
+    {
+        obj->tracks[idx].state = RADARIQ_TRACK_FREE;
+    }
+    obj->hasTime = false;
+}
+
+/**
+ * Advances all tracks to a new frame and associates them with that frame's detections.
+ * Association is greedy nearest-neighbour on the normalised innovation squared within the configured gate.
+ * Unassociated detections start new tentative tracks if a free track slot exists.
+ *
+ * @param obj The tracker handle returned from RadarIQTracker_init()
+ * @param detections Pointer to the clustered detections of the frame, e.g. from RadarIQClusterer_process()
+ * @param numDetections The number of detections, limited to the configured maximum
+ * @param timeMillis The capture time of the frame in milliseconds
+ *
+ * @return The number of confirmed tracks
+ */
+uint16_t RadarIQTracker_update(const RadarIQTrackerHandle_t obj, const RadarIQCluster_t * const detections,
+        const uint16_t numDetections, const uint32_t timeMillis)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT((NULL != detections) || (0u == numDetections));
+
+    const uint16_t maxTracks = obj->config.maxTracks;
+    const uint16_t count = (numDetections > obj->config.maxDetections) ? obj->config.maxDetections : numDetections;
+    const float dt = obj->hasTime ? ((float)(uint32_t)(timeMillis - obj->lastTime) / 1000.0f) : 0.0f;
+    uint32_t numPairs = 0u;
+    uint16_t numConfirmed = 0u;
+
+    obj->lastTime = timeMillis;
+    obj->hasTime = true;
+
+    // Predict and gate every live track against every detection
+    for (uint16_t trackIdx = 0u; trackIdx < maxTracks; trackIdx++)
+    {
+        RadarIQTrack_t * const track = &obj->tracks[trackIdx];
+        obj->trackUsed[trackIdx] = 0u;
+
+        if (RADARIQ_TRACK_FREE == track->state)
+        {
+            continue;
+        }
+
+        for (uint8_t axis = 0u; axis < 3u; axis++)
+        {
+            RadarIQTracker_predict(obj, &track->axis[axis], dt);
+        }
+
+        for (uint16_t detIdx = 0u; detIdx < count; detIdx++)
+        {
+            const float distance = RadarIQTracker_getDistance(obj, track, &detections[detIdx]);
+
+            if (distance <= obj->config.gate)
+            {
+                obj->pairs[numPairs].distance = distance;
+                obj->pairs[numPairs].track = trackIdx;
+                obj->pairs[numPairs].detection = detIdx;
+                numPairs++;
+            }
+        }
+    }
+
+    memset((void*)obj->detectionUsed, 0, count);
+
+    // Associate closest pairs first
+    RadarIQTracker_sortPairs(obj->pairs, numPairs);
+
+    for (uint32_t pairIdx = 0u; pairIdx < numPairs; pairIdx++)
+    {
+        const RadarIQTrackPair_t * const pair = &obj->pairs[pairIdx];
+
+        if ((0u != obj->trackUsed[pair->track]) || (0u != obj->detectionUsed[pair->detection]))
+        {
+            continue;
+        }
+
+        RadarIQTrack_t * const track = &obj->tracks[pair->track];
+        const RadarIQCluster_t * const detection = &detections[pair->detection];
+
+        RadarIQTracker_correct(obj, &track->axis[0], (float)detection->x);
+        RadarIQTracker_correct(obj, &track->axis[1], (float)detection->y);
+        RadarIQTracker_correct(obj, &track->axis[2], (float)detection->z);
+
+        track->misses = 0u;
+        if (UINT8_MAX > track->hits)
+        {
+            track->hits++;
+        }
+        if (track->hits >= obj->config.confirmHits)
+        {
+            track->state = RADARIQ_TRACK_CONFIRMED;
+        }
+
+        obj->trackUsed[pair->track] = 1u;
+        obj->detectionUsed[pair->detection] = 1u;
+    }
+
+    // Age out tracks without a detection, tentative tracks are dropped on their first miss
+    for (uint16_t trackIdx = 0u; trackIdx < maxTracks; trackIdx++)
+    {
+        RadarIQTrack_t * const track = &obj->tracks[trackIdx];
+
+        if ((RADARIQ_TRACK_FREE == track->state) || (0u != obj->trackUsed[trackIdx]))
+        {
+            continue;
+        }
+
+        track->misses++;
+        if ((RADARIQ_TRACK_TENTATIVE == track->state) || (track->misses > obj->config.maxMisses))
+        {
+            track->state = RADARIQ_TRACK_FREE;
+        }
+    }
+
+    // Start new tracks from unassociated detections
+    uint16_t freeIdx = 0u;
+    for (uint16_t detIdx = 0u; detIdx < count; detIdx++)
+    {
+        if (0u != obj->detectionUsed[detIdx])
+        {
+            continue;
+        }
+
+        while ((freeIdx < maxTracks) && (RADARIQ_TRACK_FREE != obj->tracks[freeIdx].state))
+        {
+            freeIdx++;
+        }
+        if (freeIdx >= maxTracks)
+        {
+            break;
+        }
+
+        RadarIQTracker_spawn(obj, &obj->tracks[freeIdx], &detections[detIdx]);
+    }
+
+    for (uint16_t trackIdx = 0u; trackIdx < maxTracks; trackIdx++)
+    {
+        if (RADARIQ_TRACK_CONFIRMED == obj->tracks[trackIdx].state)
+        {
+            numConfirmed++;
+        }
+    }
+
+    return numConfirmed;
+}
+
+/**
+ * Gets the confirmed tracks in the same layout as the object-tracking frames sent from the device.
+ *
+ * @param obj The tracker handle returned from RadarIQTracker_init()
+ * @param dest Pointer to an array of RadarIQDataObject_t to copy the tracks into
+ * @param maxObjects The length of the destination array
+ *
+ * @return The number of objects copied
+ */
+uint16_t RadarIQTracker_getObjects(const RadarIQTrackerHandle_t obj, RadarIQDataObject_t * const dest,
+        const uint16_t maxObjects)
+{
+    RADARIQ_ASSERT(NULL != obj);
+    RADARIQ_ASSERT((NULL != dest) || (0u == maxObjects));
+
+    uint16_t numObjects = 0u;
+
+    for (uint16_t trackIdx = 0u; (trackIdx < obj->config.maxTracks) && (numObjects < maxObjects); trackIdx++)
+    {
+        const RadarIQTrack_t * const track = &obj->tracks[trackIdx];
+
+        if (RADARIQ_TRACK_CONFIRMED != track->state)
+        {
+            continue;
+        }
+
+        RadarIQDataObject_t * const object = &dest[numObjects];
+        object->targetId = track->targetId;
+        object->xPos = RadarIQTracker_toInt16(track->axis[0].x[0]);
+        object->yPos = RadarIQTracker_toInt16(track->axis[1].x[0]);
+        object->zPos = RadarIQTracker_toInt16(track->axis[2].x[0]);
+        object->xVel = RadarIQTracker_toInt16(track->axis[0].x[1]);
+        object->yVel = RadarIQTracker_toInt16(track->axis[1].x[1]);
+        object->zVel = RadarIQTracker_toInt16(track->axis[2].x[1]);
+        object->xAcc = RadarIQTracker_toInt16(track->axis[0].x[2]);
+        object->yAcc = RadarIQTracker_toInt16(track->axis[1].x[2]);
+        object->zAcc = RadarIQTracker_toInt16(track->axis[2].x[2]);
+        numObjects++;
+    }
+
+    return numObjects;
+}
+
+/**
+ * Gets the total memory size requirements for one tracker instance in bytes.
+ *
+ * @param config Pointer to the tracker configuration
+ *
+ * @return The size of a single tracker instance including its track storage in bytes
+ */
+uint32_t RadarIQTracker_getMemoryUsage(const RadarIQTrackerConfig_t * const config)
+{
+    RADARIQ_ASSERT(NULL != config);
+
+    const uint32_t maxTracks = config->maxTracks;
+    const uint32_t maxDetections = config->maxDetections;
+
+    return (uint32_t)(sizeof(RadarIQTracker_t) + (sizeof(RadarIQTrack_t) * maxTracks)
+            + (sizeof(RadarIQTrackPair_t) * maxTracks * maxDetections) + maxTracks + maxDetections);
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Propagates one axis filter forward in time.
+ *
+ * @param obj The tracker handle returned from RadarIQTracker_init()
+ * @param axis Pointer to the axis filter
+ * @param dt The time step in seconds
+ */
+static void RadarIQTracker_predict(const RadarIQTrackerHandle_t obj, RadarIQTrackAxis_t * const axis, const float dt)
+{
+    if (0.0f >= dt)
+    {
+        return;
+    }
+
+    const bool isAccel = (RADARIQ_TRACKER_MODEL_CONSTANT_ACCELERATION == obj->config.model);
+    const float dt2 = 0.5f * dt * dt;
+    float f[3][3] = { { 1.0f, dt, isAccel ? dt2 : 0.0f },
+                      { 0.0f, 1.0f, isAccel ? dt : 0.0f },
+                      { 0.0f, 0.0f, isAccel ? 1.0f : 0.0f } };
+    float g[3];
+    float fp[3][3];
+
+    // Noise enters as white acceleration (CV) or white jerk (CA)
+    if (isAccel)
+    {
+        g[0] = dt2 * dt / 3.0f;
+        g[1] = dt2;
+        g[2] = dt;
+    }
+    else
+    {
+        g[0] = dt2;
+        g[1] = dt;
+        g[2] = 0.0f;
+    }
+
+    // x = F * x
+    float x[3];
+    for (uint8_t row = 0u; row < 3u; row++)
+    {
+        x[row] = (f[row][0] * axis->x[0]) + (f[row][1] * axis->x[1]) + (f[row][2] * axis->x[2]);
+    }
+    memcpy((void*)axis->x, (void*)x, sizeof(x));
+
+    // P = F * P * F' + G * G' * q
+    for (uint8_t row = 0u; row < 3u; row++)
+    {
+        for (uint8_t col = 0u; col < 3u; col++)
+        {
+            fp[row][col] = (f[row][0] * axis->p[0][col]) + (f[row][1] * axis->p[1][col]) +
+                    (f[row][2] * axis->p[2][col]);
+        }
+    }
+
+    const float q = obj->config.processNoise * obj->config.processNoise;
+    for (uint8_t row = 0u; row < 3u; row++)
+    {
+        for (uint8_t col = 0u; col < 3u; col++)
+        {
+            axis->p[row][col] = (fp[row][0] * f[col][0]) + (fp[row][1] * f[col][1]) + (fp[row][2] * f[col][2]) +
+                    (g[row] * g[col] * q);
+        }
+    }
+}
+
+/**
+ * Corrects one axis filter with a position measurement.
+ *
+ * @param obj The tracker handle returned from RadarIQTracker_init()
+ * @param axis Pointer to the axis filter
+ * @param z The measured position in millimeters
+ */
+static void RadarIQTracker_correct(const RadarIQTrackerHandle_t obj, RadarIQTrackAxis_t * const axis, const float z)
+{
+    const float s = axis->p[0][0] + obj->measurementVar;
+    const float y = z - axis->x[0];
+    const float row0[3] = { axis->p[0][0], axis->p[0][1], axis->p[0][2] };
+    float k[3];
+
+    for (uint8_t row = 0u; row < 3u; row++)
+    {
+        k[row] = axis->p[row][0] / s;
+        axis->x[row] += k[row] * y;
+    }
+
+    for (uint8_t row = 0u; row < 3u; row++)
+    {
+        for (uint8_t col = 0u; col < 3u; col++)
+        {
+            axis->p[row][col] -= k[row] * row0[col];
+        }
+    }
+}
+
+/**
+ * Gets the normalised innovation squared between a track's predicted position and a detection.
+ *
+ * @param obj The tracker handle returned from RadarIQTracker_init()
+ * @param track Pointer to the track
+ * @param detection Pointer to the detection
+ *
+ * @return The normalised innovation squared summed over all axes
+ */
+static float RadarIQTracker_getDistance(const RadarIQTrackerHandle_t obj, const RadarIQTrack_t * const track,
+        const RadarIQCluster_t * const detection)
+{
+    const float z[3] = { (float)detection->x, (float)detection->y, (float)detection->z };
+    float distance = 0.0f;
+
+    for (uint8_t axis = 0u; axis < 3u; axis++)
+    {
+        const float y = z[axis] - track->axis[axis].x[0];
+        distance += (y * y) / (track->axis[axis].p[0][0] + obj->measurementVar);
+    }
+
+    return distance;
+}
+
+/**
+ * Starts a new tentative track at a detection.
+ * The measured radial velocity is projected along the line of sight to initialise the velocity states.
+ *
+ * @param obj The tracker handle returned from RadarIQTracker_init()
+ * @param track Pointer to the free track slot
+ * @param detection Pointer to the detection
+ */
+static void RadarIQTracker_spawn(const RadarIQTrackerHandle_t obj, RadarIQTrack_t * const track,
+        const RadarIQCluster_t * const detection)
+{
+    const float z[3] = { (float)detection->x, (float)detection->y, (float)detection->z };
+    const float range = sqrtf((z[0] * z[0]) + (z[1] * z[1]) + (z[2] * z[2]));
+    const bool isAccel = (RADARIQ_TRACKER_MODEL_CONSTANT_ACCELERATION == obj->config.model);
+
+    memset((void*)track, 0, sizeof(RadarIQTrack_t));
+
+    for (uint8_t axis = 0u; axis < 3u; axis++)
+    {
+        track->axis[axis].x[0] = z[axis];
+        track->axis[axis].x[1] = (0.0f < range) ? (((float)detection->velocity * z[axis]) / range) : 0.0f;
+        track->axis[axis].p[0][0] = obj->measurementVar;
+        track->axis[axis].p[1][1] = RADARIQ_TRACKER_INIT_VEL_VAR;
+        track->axis[axis].p[2][2] = isAccel ? RADARIQ_TRACKER_INIT_ACC_VAR : 0.0f;
+    }
+
+    track->state = (1u >= obj->config.confirmHits) ? RADARIQ_TRACK_CONFIRMED : RADARIQ_TRACK_TENTATIVE;
+    track->hits = 1u;
+    track->targetId = obj->nextTargetId;
+    obj->nextTargetId = (RADARIQ_TRACKER_MAX_TARGET_ID <= obj->nextTargetId) ? 0u : (uint8_t)(obj->nextTargetId + 1u);
+}
+
+/**
+ * Sorts gated pairs by ascending distance using an in-place heap sort so the run time is bounded.
+ *
+ * @param pairs Pointer to the pairs to sort
+ * @param numPairs The number of pairs
+ */
+static void RadarIQTracker_sortPairs(RadarIQTrackPair_t * const pairs, const uint32_t numPairs)
+{
+    RadarIQTrackPair_t temp;
+
+    for (uint32_t end = numPairs; end > 1u; )
+    {
+        // Build the max-heap on the first pass, then sift the new root down after each swap
+        uint32_t start = (end == numPairs) ? (end / 2u) : 1u;
+
+        while (start > 0u)
+        {
+            start--;
+            uint32_t root = start;
+
+            while (((2u * root) + 1u) < end)
+            {
+                uint32_t child = (2u * root) + 1u;
+
+                if (((child + 1u) < end) && (pairs[child].distance < pairs[child + 1u].distance))
+                {
+                    child++;
+                }
+                if (pairs[root].distance >= pairs[child].distance)
+                {
+                    break;
+                }
+
+                temp = pairs[root];
+                pairs[root] = pairs[child];
+                pairs[child] = temp;
+                root = child;
+            }
+        }
+
+        end--;
+        temp = pairs[0];
+        pairs[0] = pairs[end];
+        pairs[end] = temp;
+    }
+}
+
+/**
+ * Converts a floating point value to a 16-bit integer, saturating at the integer limits.
+ *
+ * @param value The value to convert
+ *
+ * @return The rounded and saturated integer value
+ */
+static int16_t RadarIQTracker_toInt16(const float value)
+{
+    int16_t ret;
+
+    if (32767.0f <= value)
+    {
+        ret = INT16_MAX;
+    }
+    else if (-32768.0f >= value)
+    {
+        ret = INT16_MIN;
+    }
+    else
+    {
+        ret = (int16_t)lroundf(value);
+    }
+
+    return ret;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file
+ * RadarIQ SDK - Multi-target tracker.
+ * Host-side Kalman filter tracking of clustered point-cloud detections using fixed-capacity storage
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+#ifndef SRC_RADARIQTRACKER_H_
+#define SRC_RADARIQTRACKER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQ.h"
+#include "RadarIQCluster.h"
+
+//===============================================================================================//
+// DEFINITIONS
+//===============================================================================================//
+
+#define RADARIQ_TRACKER_MAX_TARGET_ID      249u      ///< Largest target ID assigned before IDs wrap back to 0
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Track motion models
+ */
+typedef enum
+{
+    RADARIQ_TRACKER_MODEL_CONSTANT_VELOCITY = 0,        ///< Position and velocity states, acceleration reported as 0
+    RADARIQ_TRACKER_MODEL_CONSTANT_ACCELERATION = 1     ///< Position, velocity and acceleration states
+} RadarIQTrackerModel_t;
+
+/**
+ * Tracker configuration
+ */
+typedef struct
+{
+    uint16_t maxTracks;              ///< Maximum number of simultaneous tracks, may exceed ::RADARIQ_MAX_OBJECTS
+    uint16_t maxDetections;          ///< Maximum number of detections accepted per update
+    RadarIQTrackerModel_t model;     ///< Motion model used by every track
+    float processNoise;              ///< Standard deviation of unmodelled acceleration (CV) or jerk (CA) in mm/s^2 or mm/s^3
+    float measurementNoise;          ///< Standard deviation of a detection's position on each axis in millimeters
+    float gate;                      ///< Association gate on the normalised innovation squared, e.g. 11.3 for 99% with 3 axes
+    uint8_t confirmHits;             ///< Number of associated detections before a track is reported
+    uint8_t maxMisses;               ///< Number of consecutive updates without a detection before a track is deleted
+} RadarIQTrackerConfig_t;
+
+//===============================================================================================//
+// OBJECTS
+//===============================================================================================//
+
+typedef struct RadarIQTracker_t RadarIQTracker_t;
+typedef RadarIQTracker_t* RadarIQTrackerHandle_t;
+
+//===============================================================================================//
+// FUNCTIONS
+//===============================================================================================//
+
+RadarIQTrackerHandle_t RadarIQTracker_init(const RadarIQTrackerConfig_t * const config);
+void RadarIQTracker_destroy(const RadarIQTrackerHandle_t obj);
+void RadarIQTracker_reset(const RadarIQTrackerHandle_t obj);
+uint16_t RadarIQTracker_update(const RadarIQTrackerHandle_t obj, const RadarIQCluster_t * const detections,
+        const uint16_t numDetections, const uint32_t timeMillis);
+uint16_t RadarIQTracker_getObjects(const RadarIQTrackerHandle_t obj, RadarIQDataObject_t * const dest,
+        const uint16_t maxObjects);
+uint32_t RadarIQTracker_getMemoryUsage(const RadarIQTrackerConfig_t * const config);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_RADARIQTRACKER_H_ */
@@ -0,0 +1,277 @@
+/**
+ * @file
+ * RadarIQ SDK - Rigid-body transforms.
+ * Batch kernels mapping sensor-frame point-cloud and object-tracking data into a shared world frame
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQTransform.h"
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define RADARIQ_TRANSFORM_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define RADARIQ_TRANSFORM_NEON
+#endif
+
+//===============================================================================================//
+// CONSTANTS
+//===============================================================================================//
+
+#define RADARIQ_TRANSFORM_DEG_TO_RAD    0.017453292519943295f    ///< Degrees to radians conversion factor
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTION PROTOTYPES
+//===============================================================================================//
+
+static void RadarIQTransform_rotate(const RadarIQPose_t * const pose, const int16_t x, const int16_t y,
+        const int16_t z, float * const dest);
+
+//===============================================================================================//
+// GLOBAL-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Builds a mounting pose from Euler angles and a position.
+ * The rotation is applied as roll about x, then pitch about y, then yaw about z.
+ *
+ * @param pose Pointer to a RadarIQPose_t struct to store the pose into
+ * @param roll Rotation about the x-axis in degrees
+ * @param pitch Rotation about the y-axis in degrees
+ * @param yaw Rotation about the z-axis in degrees
+ * @param x Sensor x-coordinate in the world frame in millimeters
+ * @param y Sensor y-coordinate in the world frame in millimeters
+ * @param z Sensor z-coordinate in the world frame in millimeters
+ */
+void RadarIQTransform_setPoseFromEuler(RadarIQPose_t * const pose, const float roll, const float pitch,
+        const float yaw, const float x, const float y, const float z)
+{
+    RADARIQ_ASSERT(NULL != pose);
+
+    const float cr = cosf(roll * RADARIQ_TRANSFORM_DEG_TO_RAD);
+    const float sr = sinf(roll * RADARIQ_TRANSFORM_DEG_TO_RAD);
+    const float cp = cosf(pitch * RADARIQ_TRANSFORM_DEG_TO_RAD);
+    const float sp = sinf(pitch * RADARIQ_TRANSFORM_DEG_TO_RAD);
+    const float cy = cosf(yaw * RADARIQ_TRANSFORM_DEG_TO_RAD);
+    const float sy = sinf(yaw * RADARIQ_TRANSFORM_DEG_TO_RAD);
+
+    // R = Rz(yaw) * Ry(pitch) * Rx(roll)
+    pose->rotation[0][0] = cy * cp;
+    pose->rotation[0][1] = (cy * sp * sr) - (sy * cr);
+    pose->rotation[0][2] = (cy * sp * cr) + (sy * sr);
+    pose->rotation[1][0] = sy * cp;
+    pose->rotation[1][1] = (sy * sp * sr) + (cy * cr);
+    pose->rotation[1][2] = (sy * sp * cr) - (cy * sr);
+    pose->rotation[2][0] = -sp;
+    pose->rotation[2][1] = cp * sr;
+    pose->rotation[2][2] = cp * cr;
+
+    pose->translation[0] = x;
+    pose->translation[1] = y;
+    pose->translation[2] = z;
+}
+
+/**
+ * Converts a mounting pose into its fixed-point representation.
+ *
+ * @param pose Pointer to the floating point pose
+ * @param dest Pointer to a RadarIQFixedPose_t struct to store the fixed-point pose into
+ */
+void RadarIQTransform_toFixedPose(const RadarIQPose_t * const pose, RadarIQFixedPose_t * const dest)
+{
+    RADARIQ_ASSERT(NULL != pose);
+    RADARIQ_ASSERT(NULL != dest);
+
+    const float scale = (float)(1u << RADARIQ_TRANSFORM_FIXED_SHIFT);
+
+    for (uint8_t row = 0u; row < 3u; row++)
+    {
+        for (uint8_t col = 0u; col < 3u; col++)
+        {
+            dest->rotation[row][col] = (int16_t)lroundf(pose->rotation[row][col] * scale);
+        }
+        dest->translation[row] = (int32_t)lroundf(pose->translation[row]);
+    }
+}
+
+/**
+ * Transforms point-cloud points from the sensor frame into the world frame.
+ * Uses SSE2 or NEON to process four points per iteration where available.
+ * Output is written as separate coordinate arrays, each of at least numPoints entries.
+ *
+ * @param pose Pointer to the sensor mounting pose, e.g. from RadarIQ_getPose()
+ * @param points Pointer to the sensor-frame points, e.g. RadarIQDataPointCloud_t::points
+ * @param numPoints The number of points to transform
+ * @param x Pointer to the array to store the world x-coordinates into in millimeters
+ * @param y Pointer to the array to store the world y-coordinates into in millimeters
+ * @param z Pointer to the array to store the world z-coordinates into in millimeters
+ */
+void RadarIQTransform_points(const RadarIQPose_t * const pose, const RadarIQDataPoint_t * const points,
+        const uint16_t numPoints, float * const x, float * const y, float * const z)
+{
+    RADARIQ_ASSERT(NULL != pose);
+    RADARIQ_ASSERT((NULL != points) || (0u == numPoints));
+    RADARIQ_ASSERT(NULL != x);
+    RADARIQ_ASSERT(NULL != y);
+    RADARIQ_ASSERT(NULL != z);
+
+    const float (* const r)[3] = pose->rotation;
+    const float * const t = pose->translation;
+    uint16_t idx = 0u;
+
+#if defined(RADARIQ_TRANSFORM_SSE2)
+    const __m128 r00 = _mm_set1_ps(r[0][0]), r01 = _mm_set1_ps(r[0][1]), r02 = _mm_set1_ps(r[0][2]);
+    const __m128 r10 = _mm_set1_ps(r[1][0]), r11 = _mm_set1_ps(r[1][1]), r12 = _mm_set1_ps(r[1][2]);
+    const __m128 r20 = _mm_set1_ps(r[2][0]), r21 = _mm_set1_ps(r[2][1]), r22 = _mm_set1_ps(r[2][2]);
+    const __m128 t0 = _mm_set1_ps(t[0]), t1 = _mm_set1_ps(t[1]), t2 = _mm_set1_ps(t[2]);
+
+    for (; (idx + 4u) <= numPoints; idx += 4u)
+    {
+        const RadarIQDataPoint_t * const p = &points[idx];
+        const __m128 px = _mm_cvtepi32_ps(_mm_setr_epi32(p[0].x, p[1].x, p[2].x, p[3].x));
+        const __m128 py = _mm_cvtepi32_ps(_mm_setr_epi32(p[0].y, p[1].y, p[2].y, p[3].y));
+        const __m128 pz = _mm_cvtepi32_ps(_mm_setr_epi32(p[0].z, p[1].z, p[2].z, p[3].z));
+
+        _mm_storeu_ps(&x[idx], _mm_add_ps(_mm_add_ps(_mm_mul_ps(r00, px), _mm_mul_ps(r01, py)),
+                _mm_add_ps(_mm_mul_ps(r02, pz), t0)));
+        _mm_storeu_ps(&y[idx], _mm_add_ps(_mm_add_ps(_mm_mul_ps(r10, px), _mm_mul_ps(r11, py)),
+                _mm_add_ps(_mm_mul_ps(r12, pz), t1)));
+        _mm_storeu_ps(&z[idx], _mm_add_ps(_mm_add_ps(_mm_mul_ps(r20, px), _mm_mul_ps(r21, py)),
+                _mm_add_ps(_mm_mul_ps(r22, pz), t2)));
+    }
+#elif defined(RADARIQ_TRANSFORM_NEON)
+    for (; (idx + 4u) <= numPoints; idx += 4u)
+    {
+        const RadarIQDataPoint_t * const p = &points[idx];
+        const int32_t ix[4] = { p[0].x, p[1].x, p[2].x, p[3].x };
+        const int32_t iy[4] = { p[0].y, p[1].y, p[2].y, p[3].y };
+        const int32_t iz[4] = { p[0].z, p[1].z, p[2].z, p[3].z };
+        const float32x4_t px = vcvtq_f32_s32(vld1q_s32(ix));
+        const float32x4_t py = vcvtq_f32_s32(vld1q_s32(iy));
+        const float32x4_t pz = vcvtq_f32_s32(vld1q_s32(iz));
+
+        vst1q_f32(&x[idx], vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(t[0]), px, r[0][0]), py, r[0][1]),
+                pz, r[0][2]));
+        vst1q_f32(&y[idx], vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(t[1]), px, r[1][0]), py, r[1][1]),
+                pz, r[1][2]));
+        vst1q_f32(&z[idx], vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(t[2]), px, r[2][0]), py, r[2][1]),
+                pz, r[2][2]));
+    }
+#endif
+
+    // Scalar path for the remaining points, or all points without SIMD support
+    for (; idx < numPoints; idx++)
+    {
+        float world[3];
+        RadarIQTransform_rotate(pose, points[idx].x, points[idx].y, points[idx].z, world);
+
+        x[idx] = world[0] + t[0];
+        y[idx] = world[1] + t[1];
+        z[idx] = world[2] + t[2];
+    }
+}
+
+/**
+ * Transforms point-cloud points from the sensor frame into the world frame using integer arithmetic only.
+ * Intended for microcontrollers without a floating point unit.
+ *
+ * @param pose Pointer to the fixed-point mounting pose from RadarIQTransform_toFixedPose()
+ * @param points Pointer to the sensor-frame points, e.g. RadarIQDataPointCloud_t::points
+ * @param numPoints The number of points to transform
+ * @param x Pointer to the array to store the world x-coordinates into in millimeters
+ * @param y Pointer to the array to store the world y-coordinates into in millimeters
+ * @param z Pointer to the array to store the world z-coordinates into in millimeters
+ */
+void RadarIQTransform_pointsFixed(const RadarIQFixedPose_t * const pose, const RadarIQDataPoint_t * const points,
+        const uint16_t numPoints, int32_t * const x, int32_t * const y, int32_t * const z)
+{
+    RADARIQ_ASSERT(NULL != pose);
+    RADARIQ_ASSERT((NULL != points) || (0u == numPoints));
+    RADARIQ_ASSERT(NULL != x);
+    RADARIQ_ASSERT(NULL != y);
+    RADARIQ_ASSERT(NULL != z);
+
+    const int32_t half = (int32_t)1 << (RADARIQ_TRANSFORM_FIXED_SHIFT - 1u);
+    int32_t * const dest[3] = { x, y, z };
+
+    for (uint16_t idx = 0u; idx < numPoints; idx++)
+    {
+        const int32_t px = points[idx].x;
+        const int32_t py = points[idx].y;
+        const int32_t pz = points[idx].z;
+
+        // Each product fits in 30 bits so the sum of three cannot overflow
+        for (uint8_t row = 0u; row < 3u; row++)
+        {
+            const int32_t sum = ((int32_t)pose->rotation[row][0] * px) + ((int32_t)pose->rotation[row][1] * py) +
+                    ((int32_t)pose->rotation[row][2] * pz) + half;
+
+            dest[row][idx] = (sum >> RADARIQ_TRANSFORM_FIXED_SHIFT) + pose->translation[row];
+        }
+    }
+}
+
+/**
+ * Transforms object-tracking objects from the sensor frame into the world frame.
+ * Positions are rotated and translated, velocities and accelerations are rotated only.
+ *
+ * @param pose Pointer to the sensor mounting pose, e.g. from RadarIQ_getPose()
+ * @param objects Pointer to the sensor-frame objects, e.g. RadarIQDataObjectTracking_t::objects
+ * @param numObjects The number of objects to transform
+ * @param dest Pointer to an array of at least numObjects RadarIQWorldObject_t to store the world-frame objects into
+ */
+void RadarIQTransform_objects(const RadarIQPose_t * const pose, const RadarIQDataObject_t * const objects,
+        const uint16_t numObjects, RadarIQWorldObject_t * const dest)
+{
+    RADARIQ_ASSERT(NULL != pose);
+    RADARIQ_ASSERT((NULL != objects) || (0u == numObjects));
+    RADARIQ_ASSERT(NULL != dest);
+
+    for (uint16_t idx = 0u; idx < numObjects; idx++)
+    {
+        const RadarIQDataObject_t * const src = &objects[idx];
+
+        dest[idx].targetId = src->targetId;
+        RadarIQTransform_rotate(pose, src->xPos, src->yPos, src->zPos, dest[idx].position);
+        RadarIQTransform_rotate(pose, src->xVel, src->yVel, src->zVel, dest[idx].velocity);
+        RadarIQTransform_rotate(pose, src->xAcc, src->yAcc, src->zAcc, dest[idx].acceleration);
+
+        for (uint8_t axis = 0u; axis < 3u; axis++)
+        {
+            dest[idx].position[axis] += pose->translation[axis];
+        }
+    }
+}
+
+//===============================================================================================//
+// FILE-SCOPE FUNCTIONS
+//===============================================================================================//
+
+/**
+ * Rotates a sensor-frame vector into the world frame.
+ *
+ * @param pose Pointer to the sensor mounting pose
+ * @param x The vector x-component
+ * @param y The vector y-component
+ * @param z The vector z-component
+ * @param dest Pointer to an array of 3 floats to store the rotated vector into
+ */
+static void RadarIQTransform_rotate(const RadarIQPose_t * const pose, const int16_t x, const int16_t y,
+        const int16_t z, float * const dest)
+{
+    for (uint8_t row = 0u; row < 3u; row++)
+    {
+        dest[row] = (pose->rotation[row][0] * (float)x) + (pose->rotation[row][1] * (float)y) +
+                (pose->rotation[row][2] * (float)z);
+    }
+}
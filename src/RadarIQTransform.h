@@ -0,0 +1,73 @@
+/**
+ * @file
+ * RadarIQ SDK - Rigid-body transforms.
+ * Batch kernels mapping sensor-frame point-cloud and object-tracking data into a shared world frame
+ *
+ * @copyright Copyright (C) 2021 RadarIQ
+ *            Licensed under the MIT license
+ *
+ * @author RadarIQ Ltd
+ */
+
+#ifndef SRC_RADARIQTRANSFORM_H_
+#define SRC_RADARIQTRANSFORM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//===============================================================================================//
+// INCLUDES
+//===============================================================================================//
+
+#include "RadarIQ.h"
+
+//===============================================================================================//
+// DEFINITIONS
+//===============================================================================================//
+
+#define RADARIQ_TRANSFORM_FIXED_SHIFT      14u       ///< Fractional bits of the fixed-point rotation matrix (Q14)
+
+//===============================================================================================//
+// DATA TYPES
+//===============================================================================================//
+
+/**
+ * Fixed-point mounting pose for targets without a floating point unit
+ */
+typedef struct
+{
+    int16_t rotation[3][3];          ///< Rotation matrix from the sensor frame to the world frame in Q14
+    int32_t translation[3];          ///< Position of the sensor in the world frame in millimeters
+} RadarIQFixedPose_t;
+
+/**
+ * Object-tracking object in the world frame
+ */
+typedef struct
+{
+    uint8_t targetId;                ///< The target object's ID
+    float position[3];               ///< The target object's x, y and z coordinates in millimeters
+    float velocity[3];               ///< The target object's x, y and z velocities in millimeters/second
+    float acceleration[3];           ///< The target object's x, y and z accelerations in millimeters/second/second
+} RadarIQWorldObject_t;
+
+//===============================================================================================//
+// FUNCTIONS
+//===============================================================================================//
+
+void RadarIQTransform_setPoseFromEuler(RadarIQPose_t * const pose, const float roll, const float pitch,
+        const float yaw, const float x, const float y, const float z);
+void RadarIQTransform_toFixedPose(const RadarIQPose_t * const pose, RadarIQFixedPose_t * const dest);
+void RadarIQTransform_points(const RadarIQPose_t * const pose, const RadarIQDataPoint_t * const points,
+        const uint16_t numPoints, float * const x, float * const y, float * const z);
+void RadarIQTransform_pointsFixed(const RadarIQFixedPose_t * const pose, const RadarIQDataPoint_t * const points,
+        const uint16_t numPoints, int32_t * const x, int32_t * const y, int32_t * const z);
+void RadarIQTransform_objects(const RadarIQPose_t * const pose, const RadarIQDataObject_t * const objects,
+        const uint16_t numObjects, RadarIQWorldObject_t * const dest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_RADARIQTRANSFORM_H_ */